@@ -0,0 +1,162 @@
+/**
+ * @file bench_button_dispatch.c
+ * @brief Benchmark of the dispatch of the EXTI interrupts of 16 simulated buttons: table of EXTI lines walked with count-trailing-zeros (`native_button_exti_isr()`) against a chain of checks, one per button.
+ *
+ * The chain is the previous ISR generalized to N buttons: for every button it asks the port whether its line is pending and, if so, updates its pressed flag and clears the line. The cost of the chain grows with the number of buttons; the cost of the table grows with the number of pending lines. Both are measured with one pending line (the line of the last button) and with the 16 lines pending.
+ *
+ * The benchmark also fires the 16 button FSMs of the simulated buttons, one `fsm_button_t` per button, while they are idle.
+ *
+ * With `USE_HW_DEBOUNCE` the table dispatch starts the debounce of the pending lines: the benchmark sets a debounce time of 1 ms and expires the debounce timer after every dispatch, so that the lines are unmasked for the next call.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "fsm_button.h"
+#include "native_button.h"
+#include "benchmark.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define BENCH_BUTTON_ALL_LINES 0xFFFFU /*!< Mask of the 16 EXTI lines */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t bench_button_storage[NATIVE_BUTTON_NUM_BUTTONS]; /*!< Storage of the button FSMs */
+static fsm_button_t *bench_buttons[NATIVE_BUTTON_NUM_BUTTONS];                /*!< Button FSMs, one per simulated button */
+static uint32_t bench_last_line_mask;                                         /*!< Mask of the EXTI line of the last button */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Dispatch the pending lines with a chain of checks, one per button.
+ */
+static void _bench_button_chain_isr(void)
+{
+    for (uint32_t button_id = 0; button_id < NATIVE_BUTTON_NUM_BUTTONS; button_id++)
+    {
+        if (port_button_get_pending_interrupt(button_id))
+        {
+            port_button_set_pressed(button_id, !port_button_get_value(button_id));
+            port_button_clear_pending_interrupt(button_id);
+        }
+    }
+}
+
+/**
+ * @brief Dispatch the pending lines with the table of the port.
+ */
+static void _bench_button_table_isr(void)
+{
+    native_button_exti_isr();
+#ifdef USE_HW_DEBOUNCE
+    native_button_tick_ms(); /* Expire the debounce timer (1 ms) so that the lines are unmasked */
+#endif
+}
+
+/**
+ * @brief Make the line of the last button pending and dispatch it with the chain.
+ */
+static void _bench_button_chain_one(void *p_ctx)
+{
+    native_button_set_pending_lines(bench_last_line_mask);
+    _bench_button_chain_isr();
+}
+
+/**
+ * @brief Make the line of the last button pending and dispatch it with the table.
+ */
+static void _bench_button_table_one(void *p_ctx)
+{
+    native_button_set_pending_lines(bench_last_line_mask);
+    _bench_button_table_isr();
+}
+
+/**
+ * @brief Make the 16 lines pending and dispatch them with the chain.
+ */
+static void _bench_button_chain_all(void *p_ctx)
+{
+    native_button_set_pending_lines(BENCH_BUTTON_ALL_LINES);
+    _bench_button_chain_isr();
+}
+
+/**
+ * @brief Make the 16 lines pending and dispatch them with the table.
+ */
+static void _bench_button_table_all(void *p_ctx)
+{
+    native_button_set_pending_lines(BENCH_BUTTON_ALL_LINES);
+    _bench_button_table_isr();
+}
+
+/**
+ * @brief Fire the 16 button FSMs while the buttons are released.
+ */
+static void _bench_button_fire_all(void *p_ctx)
+{
+    for (uint32_t button_id = 0; button_id < NATIVE_BUTTON_NUM_BUTTONS; button_id++)
+    {
+        fsm_button_fire(bench_buttons[button_id]);
+    }
+}
+
+/**
+ * @brief Check that both dispatchers service every pending line: press every button, dispatch, and check the pressed flags.
+ *
+ * @param p_isr Dispatcher.
+ * @return true If every button is seen pressed.
+ */
+static bool _bench_button_check(void (*p_isr)(void))
+{
+    bool ok = true;
+    for (uint32_t button_id = 0; button_id < NATIVE_BUTTON_NUM_BUTTONS; button_id++)
+    {
+        port_button_init(button_id);
+        port_button_set_pressed(button_id, true);
+    }
+    native_button_set_pending_lines(BENCH_BUTTON_ALL_LINES);
+    p_isr();
+    for (uint32_t button_id = 0; button_id < NATIVE_BUTTON_NUM_BUTTONS; button_id++)
+    {
+        ok = ok && !port_button_get_pressed(button_id) && !port_button_get_pending_interrupt(button_id);
+    }
+    return ok;
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    port_system_init();
+    for (uint32_t button_id = 0; button_id < NATIVE_BUTTON_NUM_BUTTONS; button_id++)
+    {
+        bench_buttons[button_id] = fsm_button_init(&bench_button_storage[button_id], 1, button_id);
+    }
+    bench_last_line_mask = 1U << native_button_get_line(NATIVE_BUTTON_NUM_BUTTONS - 1);
+    if (!_bench_button_check(_bench_button_chain_isr) || !_bench_button_check(_bench_button_table_isr))
+    {
+        fprintf(stderr, "A dispatcher does not service every pending line\n");
+        return 1;
+    }
+
+    benchmark_run_reference();
+    benchmark_run("button_dispatch.chain_1_pending", _bench_button_chain_one, NULL);
+    benchmark_run("button_dispatch.table_1_pending", _bench_button_table_one, NULL);
+    benchmark_run("button_dispatch.chain_16_pending", _bench_button_chain_all, NULL);
+    benchmark_run("button_dispatch.table_16_pending", _bench_button_table_all, NULL);
+    benchmark_run("button_dispatch.fsm_fire_16_idle", _bench_button_fire_all, NULL);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file bench_coroutine.c
+ * @brief Benchmark of the measurement sequence of the ultrasound sensor: FSM (`fsm_ultrasound.c`) against coroutine (`ultrasound_coroutine.c`).
+ *
+ * Both get the same stimuli through the port setters, as `_bench_ultrasound_measurement()` of `bench_fsm.c`: trigger end, echo start, echo end and new trigger, with one fire or resume after each. Both compute the median of the distances every `FSM_ULTRASOUND_NUM_MEASUREMENTS` measurements. The idle benchmarks fire or resume the sequence while it waits for the end of the trigger.
+
+The period benchmarks run a whole measurement period as the main loop does at 1 kHz: `PORT_PARKING_SENSOR_TIMEOUT_MS` fires or resumes, most of them while the sequence waits for the next trigger. They are the cost per measurement on the target.
+ *
+ * Before timing, the coroutine is checked to measure the distance of the echo.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <stdint.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm_ultrasound.h"
+#include "ultrasound_coroutine.h"
+#include "benchmark.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define BENCH_ECHO_TICKS 1166                                            /*!< Duration in ticks of the echo signal of a measurement (same as `bench_fsm.c`) */
+#define BENCH_PERIOD_IDLE_FIRES (PORT_PARKING_SENSOR_TIMEOUT_MS - 4)                  /*!< Fires of a measurement period at 1 kHz, besides the 4 of the measurement */
+#define BENCH_ECHO_DISTANCE_CM (BENCH_ECHO_TICKS * SPEED_OF_SOUND_MS / 2 / 10000) /*!< Distance in cm of the echo signal */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_ultrasound_storage_t bench_fsm_storage; /*!< Storage of the ultrasound FSM */
+static ultrasound_coroutine_t bench_uc;            /*!< Ultrasound coroutine */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Fire the ultrasound FSM while it waits for the end of the trigger signal.
+ */
+static void _bench_coroutine_fsm_fire_idle(void *p_ctx)
+{
+    fsm_ultrasound_fire((fsm_ultrasound_t *)p_ctx);
+}
+
+/**
+ * @brief Run a full measurement with the ultrasound FSM.
+ */
+static void _bench_coroutine_fsm_measurement(void *p_ctx)
+{
+    fsm_ultrasound_t *p_fsm_ultrasound = (fsm_ultrasound_t *)p_ctx;
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+}
+
+/**
+ * @brief Run a measurement period with the ultrasound FSM: the measurement, and the fires while it waits for the next trigger.
+ */
+static void _bench_coroutine_fsm_period(void *p_ctx)
+{
+    fsm_ultrasound_t *p_fsm_ultrasound = (fsm_ultrasound_t *)p_ctx;
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    for (uint32_t i = 0; i < BENCH_PERIOD_IDLE_FIRES; i++)
+    {
+        fsm_ultrasound_fire(p_fsm_ultrasound);
+    }
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+}
+
+/**
+ * @brief Resume the ultrasound coroutine while it waits for the end of the trigger signal.
+ */
+static void _bench_coroutine_uc_run_idle(void *p_ctx)
+{
+    ultrasound_coroutine_run((ultrasound_coroutine_t *)p_ctx);
+}
+
+/**
+ * @brief Run a full measurement with the ultrasound coroutine.
+ */
+static void _bench_coroutine_uc_measurement(void *p_ctx)
+{
+    ultrasound_coroutine_t *p_uc = (ultrasound_coroutine_t *)p_ctx;
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    ultrasound_coroutine_run(p_uc);
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+}
+
+/**
+ * @brief Run a measurement period with the ultrasound coroutine: the measurement, and the resumes while it waits for the next trigger.
+ */
+static void _bench_coroutine_uc_period(void *p_ctx)
+{
+    ultrasound_coroutine_t *p_uc = (ultrasound_coroutine_t *)p_ctx;
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    ultrasound_coroutine_run(p_uc);
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+    for (uint32_t i = 0; i < BENCH_PERIOD_IDLE_FIRES; i++)
+    {
+        ultrasound_coroutine_run(p_uc);
+    }
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(p_uc);
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    port_system_init();
+
+    fsm_ultrasound_t *p_fsm_ultrasound = fsm_ultrasound_init(&bench_fsm_storage, PORT_REAR_PARKING_SENSOR_ID);
+    fsm_ultrasound_start(p_fsm_ultrasound);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    benchmark_run_reference();
+    benchmark_run("ultrasound.fsm_fire_idle", _bench_coroutine_fsm_fire_idle, p_fsm_ultrasound);
+    benchmark_run("ultrasound.fsm_measurement", _bench_coroutine_fsm_measurement, p_fsm_ultrasound);
+    benchmark_run("ultrasound.fsm_period", _bench_coroutine_fsm_period, p_fsm_ultrasound);
+    fsm_ultrasound_stop(p_fsm_ultrasound);
+
+    ultrasound_coroutine_init(&bench_uc, PORT_REAR_PARKING_SENSOR_ID);
+    ultrasound_coroutine_start(&bench_uc);
+    ultrasound_coroutine_run(&bench_uc);
+    for (uint32_t i = 0; i < FSM_ULTRASOUND_NUM_MEASUREMENTS; i++)
+    {
+        _bench_coroutine_uc_measurement(&bench_uc);
+    }
+    if (!ultrasound_coroutine_get_new_measurement_ready(&bench_uc) || ultrasound_coroutine_get_distance(&bench_uc) != BENCH_ECHO_DISTANCE_CM)
+    {
+        fprintf(stderr, "The coroutine did not measure the distance of the echo\n");
+        return 1;
+    }
+    benchmark_run("ultrasound.coroutine_run_idle", _bench_coroutine_uc_run_idle, &bench_uc);
+    benchmark_run("ultrasound.coroutine_measurement", _bench_coroutine_uc_measurement, &bench_uc);
+    benchmark_run("ultrasound.coroutine_period", _bench_coroutine_uc_period, &bench_uc);
+    ultrasound_coroutine_stop(&bench_uc);
+    return 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file bench_fsm.c
+ * @brief Benchmark of the hot paths of the FSMs on the native platform.
+ *
+ * The benchmark is built once per dispatcher of the FSMs. `bench_fsm` fires them as configured. `bench_fsm_indexed` (`USE_FSM_INDEXED`), `bench_fsm_switch` (`USE_FSM_SWITCH`) and `bench_fsm_hierarchical` (`USE_FSM_HIERARCHICAL`) prefix their metrics with `indexed.`, `switch.` and `hierarchical.`.
+ *
+ * The stimuli are injected through the simulated hardware and the port setters, and the time is moved with `port_system_set_millis()`, so every benchmark function leaves the FSMs in the state where it found them.
+ *
+ * The `fsm_urbanite.guard_calls_<state>` metrics are not times: they count the input functions that one fire of the Urbanite FSM calls in each state, with no activity. Every variant counts them through the input functions of the Urbanite FSM (`fsm_urbanite_get_guard_calls()`), so the common library of the benchmark is built with `USE_FSM_GUARD_COUNT`.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_button.h"
+#include "port_ultrasound.h"
+#include "port_display.h"
+#include "native_button.h"
+
+/* Project includes */
+#include "fsm_button.h"
+#include "fsm_ultrasound.h"
+#include "fsm_display.h"
+#include "fsm_urbanite.h"
+#include "benchmark.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define URBANITE_ON_OFF_PRESS_TIME_MS 1000 /*!< Time in ms to press the button to turn on/off the system (same as `main.c`) */
+#define URBANITE_PAUSE_DISPLAY_TIME_MS 500 /*!< Time in ms to pause the display system (same as `main.c`) */
+#define BENCH_ECHO_TICKS 1166               /*!< Duration in ticks of the echo signal of a measurement (20 cm) */
+#ifndef BENCH_METRIC_PREFIX
+#define BENCH_METRIC_PREFIX ""              /*!< Prefix of the metrics (name of the dispatcher variant) */
+#endif
+#ifndef USE_FSM_GUARD_COUNT
+#error "bench_fsm counts the input functions called by the Urbanite FSM: build it and the common library with USE_FSM_GUARD_COUNT"
+#endif
+
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief FSMs of the Urbanite */
+typedef struct
+{
+    /** @brief Button FSM */
+    fsm_button_t *p_fsm_button;
+    /** @brief Rear ultrasound FSM */
+    fsm_ultrasound_t *p_fsm_ultrasound_rear;
+    /** @brief Rear display FSM */
+    fsm_display_t *p_fsm_display_rear;
+    /** @brief Urbanite FSM */
+    fsm_urbanite_t *p_fsm_urbanite;
+    /** @brief Distance set on the display */
+    uint32_t distance_cm;
+} bench_fsm_ctx_t;
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t fsm_button_storage;              /*!< Storage of the button FSM of the startup benchmark */
+static fsm_ultrasound_storage_t fsm_ultrasound_rear_storage; /*!< Storage of the rear ultrasound FSM of the startup benchmark */
+static fsm_display_storage_t fsm_display_rear_storage;       /*!< Storage of the rear display FSM of the startup benchmark */
+static fsm_urbanite_storage_t fsm_urbanite_storage;          /*!< Storage of the Urbanite FSM of the startup benchmark */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Fire the button FSM while the button is released.
+ */
+static void _bench_button_fire_idle(void *p_ctx)
+{
+    fsm_button_fire(((bench_fsm_ctx_t *)p_ctx)->p_fsm_button);
+}
+
+/**
+ * @brief Press and release the button, waiting for the debounce time after every edge.
+ */
+static void _bench_button_press_release(void *p_ctx)
+{
+    fsm_button_t *p_fsm_button = ((bench_fsm_ctx_t *)p_ctx)->p_fsm_button;
+
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false);
+    fsm_button_fire(p_fsm_button);
+    port_system_set_millis(port_system_get_millis() + PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS);
+    fsm_button_fire(p_fsm_button);
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    fsm_button_fire(p_fsm_button);
+    port_system_set_millis(port_system_get_millis() + PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS);
+    fsm_button_fire(p_fsm_button);
+}
+
+/**
+ * @brief Fire the ultrasound FSM while it waits for the end of the trigger signal.
+ */
+static void _bench_ultrasound_fire_idle(void *p_ctx)
+{
+    fsm_ultrasound_fire(((bench_fsm_ctx_t *)p_ctx)->p_fsm_ultrasound_rear);
+}
+
+/**
+ * @brief Run a full measurement: trigger end, echo start, echo end and new trigger.
+ */
+static void _bench_ultrasound_measurement(void *p_ctx)
+{
+    fsm_ultrasound_t *p_fsm_ultrasound = ((bench_fsm_ctx_t *)p_ctx)->p_fsm_ultrasound_rear;
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+}
+
+/**
+ * @brief Set a new distance on the display and fire its FSM.
+ */
+static void _bench_display_set_distance(void *p_ctx)
+{
+    bench_fsm_ctx_t *p_bench = (bench_fsm_ctx_t *)p_ctx;
+    p_bench->distance_cm = (p_bench->distance_cm + 7) % 250;
+    fsm_display_set_distance(p_bench->p_fsm_display_rear, p_bench->distance_cm);
+    fsm_display_fire(p_bench->p_fsm_display_rear);
+}
+
+/**
+ * @brief One iteration of the main loop of `main.c` while the Urbanite is OFF and sleeping.
+ */
+static void _bench_main_loop_off(void *p_ctx)
+{
+    bench_fsm_ctx_t *p_bench = (bench_fsm_ctx_t *)p_ctx;
+    fsm_button_fire(p_bench->p_fsm_button);
+    fsm_ultrasound_fire(p_bench->p_fsm_ultrasound_rear);
+    fsm_display_fire(p_bench->p_fsm_display_rear);
+    fsm_urbanite_fire(p_bench->p_fsm_urbanite);
+}
+
+/**
+ * @brief Fire the Urbanite FSM once in a state and count the input functions it calls.
+ *
+ * @param p_fsm_urbanite Pointer to the Urbanite FSM.
+ * @param state State in which the FSM is fired.
+ * @return uint32_t Number of input functions called.
+ */
+static uint32_t _bench_urbanite_guard_calls(fsm_urbanite_t *p_fsm_urbanite, int state)
+{
+    fsm_set_state((fsm_t *)p_fsm_urbanite, state);
+    uint32_t calls = fsm_urbanite_get_guard_calls();
+    fsm_urbanite_fire(p_fsm_urbanite);
+    return fsm_urbanite_get_guard_calls() - calls;
+}
+
+/**
+ * @brief Create the four FSMs on the heap and destroy them.
+ */
+static void _bench_startup_new(void *p_ctx)
+{
+    fsm_button_t *p_fsm_button = fsm_button_new(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    fsm_ultrasound_t *p_fsm_ultrasound_rear = fsm_ultrasound_new(PORT_REAR_PARKING_SENSOR_ID);
+    fsm_display_t *p_fsm_display_rear = fsm_display_new(PORT_REAR_PARKING_DISPLAY_ID);
+    fsm_urbanite_t *p_fsm_urbanite = fsm_urbanite_new(p_fsm_button, URBANITE_ON_OFF_PRESS_TIME_MS, URBANITE_PAUSE_DISPLAY_TIME_MS, p_fsm_ultrasound_rear, p_fsm_display_rear);
+    fsm_button_destroy(p_fsm_button);
+    fsm_ultrasound_destroy(p_fsm_ultrasound_rear);
+    fsm_display_destroy(p_fsm_display_rear);
+    fsm_urbanite_destroy(p_fsm_urbanite);
+}
+
+/**
+ * @brief Initialize the four FSMs on static storage, as `main.c` does.
+ */
+static void _bench_startup_init(void *p_ctx)
+{
+    fsm_button_t *p_fsm_button = fsm_button_init(&fsm_button_storage, PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    fsm_ultrasound_t *p_fsm_ultrasound_rear = fsm_ultrasound_init(&fsm_ultrasound_rear_storage, PORT_REAR_PARKING_SENSOR_ID);
+    fsm_display_t *p_fsm_display_rear = fsm_display_init(&fsm_display_rear_storage, PORT_REAR_PARKING_DISPLAY_ID);
+    fsm_urbanite_init(&fsm_urbanite_storage, p_fsm_button, URBANITE_ON_OFF_PRESS_TIME_MS, URBANITE_PAUSE_DISPLAY_TIME_MS, p_fsm_ultrasound_rear, p_fsm_display_rear);
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    bench_fsm_ctx_t bench;
+
+    port_system_init();
+    bench.p_fsm_button = fsm_button_new(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    bench.p_fsm_ultrasound_rear = fsm_ultrasound_new(PORT_REAR_PARKING_SENSOR_ID);
+    bench.p_fsm_display_rear = fsm_display_new(PORT_REAR_PARKING_DISPLAY_ID);
+    bench.p_fsm_urbanite = fsm_urbanite_new(bench.p_fsm_button, URBANITE_ON_OFF_PRESS_TIME_MS, URBANITE_PAUSE_DISPLAY_TIME_MS, bench.p_fsm_ultrasound_rear, bench.p_fsm_display_rear);
+    bench.distance_cm = 0;
+
+    benchmark_run_reference();
+    benchmark_run(BENCH_METRIC_PREFIX "fsm_button.fire_idle", _bench_button_fire_idle, &bench);
+    benchmark_run(BENCH_METRIC_PREFIX "fsm_button.press_release", _bench_button_press_release, &bench);
+
+    /* The ultrasound FSM is started by hand: the Urbanite FSM stays OFF */
+    fsm_ultrasound_start(bench.p_fsm_ultrasound_rear);
+    fsm_ultrasound_fire(bench.p_fsm_ultrasound_rear);
+    benchmark_run(BENCH_METRIC_PREFIX "fsm_ultrasound.fire_idle", _bench_ultrasound_fire_idle, &bench);
+    benchmark_run(BENCH_METRIC_PREFIX "fsm_ultrasound.measurement", _bench_ultrasound_measurement, &bench);
+    fsm_ultrasound_stop(bench.p_fsm_ultrasound_rear);
+
+    fsm_display_set_status(bench.p_fsm_display_rear, true);
+    benchmark_run(BENCH_METRIC_PREFIX "fsm_display.set_distance", _bench_display_set_distance, &bench);
+    fsm_display_set_status(bench.p_fsm_display_rear, false);
+    fsm_display_fire(bench.p_fsm_display_rear);
+
+    benchmark_run(BENCH_METRIC_PREFIX "main_loop.off", _bench_main_loop_off, &bench);
+
+    /* Guard calls of the Urbanite FSM in every state with no activity: each fire goes to sleep */
+    fsm_ultrasound_get_distance(bench.p_fsm_ultrasound_rear); /* Consume the last measurement of the ultrasound benchmarks */
+    benchmark_report(BENCH_METRIC_PREFIX "fsm_urbanite.guard_calls_off", _bench_urbanite_guard_calls(bench.p_fsm_urbanite, OFF), "calls");
+    benchmark_report(BENCH_METRIC_PREFIX "fsm_urbanite.guard_calls_sleep_while_off", _bench_urbanite_guard_calls(bench.p_fsm_urbanite, SLEEP_WHILE_OFF), "calls");
+    benchmark_report(BENCH_METRIC_PREFIX "fsm_urbanite.guard_calls_measure", _bench_urbanite_guard_calls(bench.p_fsm_urbanite, MEASURE), "calls");
+    benchmark_report(BENCH_METRIC_PREFIX "fsm_urbanite.guard_calls_sleep_while_on", _bench_urbanite_guard_calls(bench.p_fsm_urbanite, SLEEP_WHILE_ON), "calls");
+    fsm_set_state((fsm_t *)bench.p_fsm_urbanite, SLEEP_WHILE_OFF);
+
+    /* Startup: the port is initialized again by every iteration, so these go last */
+    benchmark_run(BENCH_METRIC_PREFIX "startup.fsm_new", _bench_startup_new, NULL);
+    benchmark_run(BENCH_METRIC_PREFIX "startup.fsm_init", _bench_startup_init, NULL);
+
+    fsm_button_destroy(bench.p_fsm_button);
+    fsm_ultrasound_destroy(bench.p_fsm_ultrasound_rear);
+    fsm_display_destroy(bench.p_fsm_display_rear);
+    fsm_urbanite_destroy(bench.p_fsm_urbanite);
+    return 0;
+}
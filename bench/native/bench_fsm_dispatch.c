@@ -0,0 +1,149 @@
+/**
+ * @file bench_fsm_dispatch.c
+ * @brief Benchmark of the dispatchers of the FSM library on synthetic FSMs: linear scan of the transitions table (`fsm_fire()`) against the table indexed by state (`fsm_indexed_fire()`).
+ *
+ * The synthetic FSMs are rings of states. Every state has two rows: one whose input is never true and one that moves to the next state, so that every fire visits all the rows of its state. Every call of a benchmark fires once, and the ring is walked over and over, so the result is the mean over all the states.
+ *
+ * Before timing, both dispatchers are checked to follow the same sequence of states.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "fsm.h"
+#include "fsm_indexed.h"
+#include "benchmark.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define BENCH_DISPATCH_MAX_STATES 50      /*!< Number of states of the largest synthetic FSM */
+#define BENCH_DISPATCH_ROWS_PER_STATE 2   /*!< Rows of the transitions table of every state */
+#define BENCH_DISPATCH_CHECK_FIRES 1000   /*!< Fires compared between both dispatchers before timing */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Synthetic FSM, with its transitions table and its index.
+ */
+typedef struct
+{
+    /** @brief FSM fired by the benchmark */
+    fsm_t f;
+    /** @brief Transitions table (with the final row) */
+    fsm_trans_t tt[BENCH_DISPATCH_MAX_STATES * BENCH_DISPATCH_ROWS_PER_STATE + 1];
+    /** @brief Rows of every state */
+    fsm_indexed_slot_t slots[BENCH_DISPATCH_MAX_STATES];
+    /** @brief Index of the transitions table */
+    fsm_indexed_t index;
+} bench_dispatch_fsm_t;
+
+/* Global variables ------------------------------------------------------------*/
+static bench_dispatch_fsm_t bench_fsm_small; /*!< Synthetic FSM with as many states as the Urbanite FSM */
+static bench_dispatch_fsm_t bench_fsm_large; /*!< Synthetic FSM with `BENCH_DISPATCH_MAX_STATES` states */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Input function that is never true.
+ */
+static bool _bench_check_never(fsm_t *p_this)
+{
+    return false;
+}
+
+/**
+ * @brief Input function that is always true.
+ */
+static bool _bench_check_always(fsm_t *p_this)
+{
+    return true;
+}
+
+/**
+ * @brief Build a ring of states with its transitions table sorted by origin state, and the index of the table.
+ *
+ * The table is built at run time to keep the benchmark short; the tables of the Urbanite are `const`.
+ *
+ * @param p_bench Synthetic FSM.
+ * @param num_states Number of states of the ring (up to `BENCH_DISPATCH_MAX_STATES`).
+ */
+static void _bench_dispatch_build(bench_dispatch_fsm_t *p_bench, uint32_t num_states)
+{
+    uint32_t row = 0;
+    for (uint32_t state = 0; state < num_states; state++)
+    {
+        p_bench->tt[row++] = (fsm_trans_t){(int)state, _bench_check_never, 0, NULL};
+        p_bench->tt[row++] = (fsm_trans_t){(int)state, _bench_check_always, (int)((state + 1) % num_states), NULL};
+    }
+    p_bench->tt[row] = (fsm_trans_t){-1, NULL, -1, NULL};
+    fsm_indexed_init(p_bench->slots, num_states, p_bench->tt);
+    p_bench->index.p_slots = p_bench->slots;
+    p_bench->index.num_states = num_states;
+    fsm_init(&p_bench->f, p_bench->tt);
+}
+
+/**
+ * @brief Check that both dispatchers follow the same sequence of states.
+ *
+ * @param p_bench Synthetic FSM.
+ * @return true If the sequences are the same.
+ */
+static bool _bench_dispatch_check(bench_dispatch_fsm_t *p_bench)
+{
+    fsm_t scan;
+    fsm_init(&scan, p_bench->tt);
+    fsm_set_state(&p_bench->f, fsm_get_state(&scan));
+    for (uint32_t i = 0; i < BENCH_DISPATCH_CHECK_FIRES; i++)
+    {
+        if ((fsm_fire(&scan) != fsm_indexed_fire(&p_bench->f, &p_bench->index)) || (fsm_get_state(&scan) != fsm_get_state(&p_bench->f)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Fire a synthetic FSM with the linear scan of the FSM library.
+ */
+static void _bench_dispatch_scan(void *p_ctx)
+{
+    fsm_fire(&((bench_dispatch_fsm_t *)p_ctx)->f);
+}
+
+/**
+ * @brief Fire a synthetic FSM with the table indexed by state.
+ */
+static void _bench_dispatch_indexed(void *p_ctx)
+{
+    bench_dispatch_fsm_t *p_bench = (bench_dispatch_fsm_t *)p_ctx;
+    fsm_indexed_fire(&p_bench->f, &p_bench->index);
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    _bench_dispatch_build(&bench_fsm_small, 4);
+    _bench_dispatch_build(&bench_fsm_large, BENCH_DISPATCH_MAX_STATES);
+    if (!_bench_dispatch_check(&bench_fsm_small) || !_bench_dispatch_check(&bench_fsm_large))
+    {
+        fprintf(stderr, "The indexed dispatcher does not follow the linear scan\n");
+        return 1;
+    }
+
+    benchmark_run_reference();
+    benchmark_run("fsm_dispatch.scan_4_states", _bench_dispatch_scan, &bench_fsm_small);
+    benchmark_run("fsm_dispatch.indexed_4_states", _bench_dispatch_indexed, &bench_fsm_small);
+    benchmark_run("fsm_dispatch.scan_50_states", _bench_dispatch_scan, &bench_fsm_large);
+    benchmark_run("fsm_dispatch.indexed_50_states", _bench_dispatch_indexed, &bench_fsm_large);
+    return 0;
+}
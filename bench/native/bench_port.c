@@ -0,0 +1,87 @@
+/**
+ * @file bench_port.c
+ * @brief Benchmark of the port functions called by the FSMs in every iteration of the main loop, on the native platform.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_button.h"
+#include "port_ultrasound.h"
+#include "port_display.h"
+
+/* Project includes */
+#include "benchmark.h"
+
+/* Global variables ------------------------------------------------------------*/
+static volatile uint32_t sink; /*!< Results of the calls, so that they are not optimized out */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Read the system tick.
+ */
+static void _bench_system_get_millis(void *p_ctx)
+{
+    sink = port_system_get_millis();
+}
+
+/**
+ * @brief Read the pressed flag of the parking button.
+ */
+static void _bench_button_get_pressed(void *p_ctx)
+{
+    sink = port_button_get_pressed(PORT_PARKING_BUTTON_ID);
+}
+
+/**
+ * @brief Read all the flags polled by the ultrasound FSM.
+ */
+static void _bench_ultrasound_get_flags(void *p_ctx)
+{
+    sink = port_ultrasound_get_trigger_ready(PORT_REAR_PARKING_SENSOR_ID) + port_ultrasound_get_trigger_end(PORT_REAR_PARKING_SENSOR_ID) + port_ultrasound_get_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID) + port_ultrasound_get_echo_received(PORT_REAR_PARKING_SENSOR_ID);
+}
+
+/**
+ * @brief Reset the echo of the rear ultrasound sensor.
+ */
+static void _bench_ultrasound_reset_echo_ticks(void *p_ctx)
+{
+    port_ultrasound_reset_echo_ticks(PORT_REAR_PARKING_SENSOR_ID);
+}
+
+/**
+ * @brief Set the color of the rear display.
+ */
+static void _bench_display_set_rgb(void *p_ctx)
+{
+    port_display_set_rgb(PORT_REAR_PARKING_DISPLAY_ID, COLOR_TURQUOISE);
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    port_system_init();
+    port_button_init(PORT_PARKING_BUTTON_ID);
+    port_ultrasound_init(PORT_REAR_PARKING_SENSOR_ID);
+    port_display_init(PORT_REAR_PARKING_DISPLAY_ID);
+
+    benchmark_run_reference();
+    benchmark_run("port_system.get_millis", _bench_system_get_millis, NULL);
+    benchmark_run("port_button.get_pressed", _bench_button_get_pressed, NULL);
+    benchmark_run("port_ultrasound.get_flags", _bench_ultrasound_get_flags, NULL);
+    benchmark_run("port_ultrasound.reset_echo_ticks", _bench_ultrasound_reset_echo_ticks, NULL);
+    benchmark_run("port_display.set_rgb", _bench_display_set_rgb, NULL);
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file bench_soft_timer.c
+ * @brief Benchmark of the software timers with thousands of running timers: min-heap of the service (`soft_timer.h`) against a linear scan of the deadlines.
+ *
+ * The service runs `BENCH_SOFT_TIMER_NUM_TIMERS` periodic timers with scrambled phases and periods, so the heap stays full while the benchmarks run. The expiry benchmarks dispatch exactly one due timer per call: every call moves the time to the next deadline. The linear scan is the simplest alternative on a single hardware timer: it looks for the earliest deadline in an array at every expiry, so its cost grows with the number of timers instead of its logarithm.
+ *
+ * Before timing, both are checked to expire the timers in the same order.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "soft_timer.h"
+#include "benchmark.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define BENCH_SOFT_TIMER_NUM_TIMERS 4096      /*!< Running timers */
+#define BENCH_SOFT_TIMER_MAX_PERIODS 64       /*!< Longest period of the timers, in multiples of `BENCH_SOFT_TIMER_NUM_TIMERS` µs */
+#define BENCH_SOFT_TIMER_CHECK_EXPIRIES 10000 /*!< Expiries compared between the heap and the scan before timing */
+
+/* Global variables ------------------------------------------------------------*/
+static soft_timer_service_t bench_service;                              /*!< Service with the running timers */
+static soft_timer_t *bench_heap[BENCH_SOFT_TIMER_NUM_TIMERS];           /*!< Array of the heap of the service */
+static soft_timer_t bench_timers[BENCH_SOFT_TIMER_NUM_TIMERS];          /*!< Timers of the service */
+static uint64_t bench_scan_deadlines[BENCH_SOFT_TIMER_NUM_TIMERS];      /*!< Deadlines of the linear scan */
+static uint32_t bench_periods[BENCH_SOFT_TIMER_NUM_TIMERS];             /*!< Periods of the timers, shared by the heap and the scan */
+static uint32_t bench_last_fired;                                       /*!< Index of the last timer fired */
+static uint32_t bench_random = 12345;                                   /*!< State of the pseudo-random generator */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Pseudo-random generator (linear congruential), the same on every run.
+ *
+ * @return uint32_t Next value.
+ */
+static uint32_t _bench_soft_timer_random(void)
+{
+    bench_random = bench_random * 1664525U + 1013904223U;
+    return bench_random >> 8;
+}
+
+/**
+ * @brief Callback of the timers: record which one fired.
+ *
+ * @param p_arg Pointer to the timer.
+ */
+static void _bench_soft_timer_callback(void *p_arg)
+{
+    bench_last_fired = (uint32_t)((soft_timer_t *)p_arg - bench_timers);
+}
+
+/**
+ * @brief Expire the earliest timer of the linear scan: find it, fire it and move its deadline one period on.
+ *
+ * @return uint32_t Index of the timer fired.
+ */
+static uint32_t _bench_soft_timer_scan_expire(void)
+{
+    uint32_t earliest = 0;
+    for (uint32_t i = 1; i < BENCH_SOFT_TIMER_NUM_TIMERS; i++)
+    {
+        if (bench_scan_deadlines[i] < bench_scan_deadlines[earliest])
+        {
+            earliest = i;
+        }
+    }
+    _bench_soft_timer_callback(&bench_timers[earliest]);
+    bench_scan_deadlines[earliest] += bench_periods[earliest];
+    return earliest;
+}
+
+/**
+ * @brief Expire the earliest timer of the service: dispatch it at its deadline.
+ */
+static void _bench_soft_timer_heap_expire(void *p_ctx)
+{
+    soft_timer_dispatch(&bench_service, soft_timer_get_next_deadline(&bench_service));
+}
+
+/**
+ * @brief Expire the earliest timer of the linear scan.
+ */
+static void _bench_soft_timer_scan_expire_fn(void *p_ctx)
+{
+    _bench_soft_timer_scan_expire();
+}
+
+/**
+ * @brief Dispatch the service when no timer is due.
+ */
+static void _bench_soft_timer_dispatch_idle(void *p_ctx)
+{
+    soft_timer_dispatch(&bench_service, soft_timer_get_next_deadline(&bench_service) - 1U);
+}
+
+/**
+ * @brief Restart a random timer one period after its deadline.
+ */
+static void _bench_soft_timer_restart(void *p_ctx)
+{
+    soft_timer_t *p_timer = &bench_timers[_bench_soft_timer_random() % BENCH_SOFT_TIMER_NUM_TIMERS];
+    soft_timer_start(&bench_service, p_timer, p_timer->deadline_us + p_timer->period_us, p_timer->period_us);
+}
+
+/**
+ * @brief Stop a random timer and start it again at the same deadline.
+ */
+static void _bench_soft_timer_stop_start(void *p_ctx)
+{
+    soft_timer_t *p_timer = &bench_timers[_bench_soft_timer_random() % BENCH_SOFT_TIMER_NUM_TIMERS];
+    uint64_t deadline_us = p_timer->deadline_us;
+    soft_timer_stop(&bench_service, p_timer);
+    soft_timer_start(&bench_service, p_timer, deadline_us, bench_periods[p_timer - bench_timers]);
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    port_system_init();
+    soft_timer_service_init(&bench_service, bench_heap, BENCH_SOFT_TIMER_NUM_TIMERS);
+    for (uint32_t i = 0; i < BENCH_SOFT_TIMER_NUM_TIMERS; i++)
+    {
+        /* The deadlines of a timer are congruent with its index modulo the number of timers: they never tie, so the order of the expiries is unique */
+        bench_periods[i] = (1U + _bench_soft_timer_random() % BENCH_SOFT_TIMER_MAX_PERIODS) * BENCH_SOFT_TIMER_NUM_TIMERS;
+        uint64_t deadline_us = (uint64_t)(1U + _bench_soft_timer_random() % BENCH_SOFT_TIMER_MAX_PERIODS) * BENCH_SOFT_TIMER_NUM_TIMERS + i;
+        bench_scan_deadlines[i] = deadline_us;
+        soft_timer_init(&bench_timers[i], _bench_soft_timer_callback, &bench_timers[i]);
+        soft_timer_start(&bench_service, &bench_timers[i], deadline_us, bench_periods[i]);
+    }
+    for (uint32_t n = 0; n < BENCH_SOFT_TIMER_CHECK_EXPIRIES; n++)
+    {
+        uint32_t scan_fired = _bench_soft_timer_scan_expire();
+        _bench_soft_timer_heap_expire(NULL);
+        if (bench_last_fired != scan_fired)
+        {
+            fprintf(stderr, "The heap and the scan do not expire the timers in the same order\n");
+            return 1;
+        }
+    }
+
+    benchmark_run_reference();
+    benchmark_run("soft_timer.heap_expire_4096", _bench_soft_timer_heap_expire, NULL);
+    benchmark_run("soft_timer.scan_expire_4096", _bench_soft_timer_scan_expire_fn, NULL);
+    benchmark_run("soft_timer.dispatch_idle_4096", _bench_soft_timer_dispatch_idle, NULL);
+    benchmark_run("soft_timer.restart_4096", _bench_soft_timer_restart, NULL);
+    benchmark_run("soft_timer.stop_start_4096", _bench_soft_timer_stop_start, NULL);
+    return 0;
+}
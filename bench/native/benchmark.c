@@ -0,0 +1,111 @@
+/**
+ * @file benchmark.c
+ * @brief Minimal harness to time the hot paths of the firmware on the native platform.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#define _POSIX_C_SOURCE 199309L /*!< Needed by clock_gettime() */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Project includes */
+#include "benchmark.h"
+
+/* Global variables ------------------------------------------------------------*/
+static volatile uint32_t benchmark_reference_state = 2463534242U; /*!< State of the fixed workload (volatile: the workload cannot be folded) */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get a monotonic timestamp.
+ *
+ * @return uint64_t Time in ns.
+ */
+static uint64_t _benchmark_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Time a number of calls of a function.
+ *
+ * @param p_fn Function under benchmark.
+ * @param p_ctx Context passed to the function.
+ * @param calls Number of calls.
+ * @return uint64_t Elapsed time in ns.
+ */
+static uint64_t _benchmark_time_calls(benchmark_fn_t p_fn, void *p_ctx, uint64_t calls)
+{
+    uint64_t start = _benchmark_now_ns();
+    for (uint64_t i = 0; i < calls; i++)
+    {
+        p_fn(p_ctx);
+    }
+    return _benchmark_now_ns() - start;
+}
+
+/**
+ * @brief Comparison function for qsort.
+ */
+static int _benchmark_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Fixed workload of the reference metric: dependent xorshift rounds.
+ */
+static void _benchmark_reference(void *p_ctx)
+{
+    uint32_t x = benchmark_reference_state;
+    for (uint32_t i = 0; i < BENCHMARK_REFERENCE_ROUNDS; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    benchmark_reference_state = x;
+}
+
+/* Public functions -----------------------------------------------------------*/
+double benchmark_measure_ns(benchmark_fn_t p_fn, void *p_ctx)
+{
+    /* Calibration (it also warms up the caches and the branch predictors) */
+    uint64_t calls = 1;
+    while (_benchmark_time_calls(p_fn, p_ctx, calls) < BENCHMARK_MIN_TIME_NS)
+    {
+        calls *= 2;
+    }
+
+    double samples[BENCHMARK_REPETITIONS];
+    for (uint32_t i = 0; i < BENCHMARK_REPETITIONS; i++)
+    {
+        samples[i] = (double)_benchmark_time_calls(p_fn, p_ctx, calls) / (double)calls;
+    }
+    qsort(samples, BENCHMARK_REPETITIONS, sizeof(samples[0]), _benchmark_compare);
+    return samples[BENCHMARK_REPETITIONS / 2];
+}
+
+void benchmark_report(const char *p_metric, double value, const char *p_unit)
+{
+    printf("%s %.2f %s\n", p_metric, value, p_unit);
+    fflush(stdout);
+}
+
+void benchmark_run(const char *p_metric, benchmark_fn_t p_fn, void *p_ctx)
+{
+    benchmark_report(p_metric, benchmark_measure_ns(p_fn, p_ctx), "ns");
+}
+
+void benchmark_run_reference(void)
+{
+    benchmark_run(BENCHMARK_REFERENCE_METRIC, _benchmark_reference, NULL);
+}
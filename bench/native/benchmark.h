@@ -0,0 +1,70 @@
+/**
+ * @file benchmark.h
+ * @brief Header for benchmark.c file: minimal harness to time the hot paths of the firmware on the native platform.
+ *
+ * Every benchmark prints one result line per metric with the format `<metric> <value> <unit>`, which is the format read by `tools/bench_compare.py`. The baseline checks the times as ratios, to another metric or to the fixed workload of `benchmark_run_reference()`.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define BENCHMARK_REPETITIONS 9           /*!< Number of timed repetitions of a benchmark (the median is reported) */
+#define BENCHMARK_MIN_TIME_NS 2000000ULL  /*!< Minimum duration in ns of a timed repetition */
+#define BENCHMARK_REFERENCE_METRIC "benchmark.reference" /*!< Metric of the fixed workload against which the times are compared */
+#define BENCHMARK_REFERENCE_ROUNDS 64U    /*!< Rounds of xorshift of the fixed workload */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Function under benchmark. It must leave the system in the same state as it found it, so that it can be called in a loop.
+ *
+ * @param p_ctx Context of the benchmark.
+ */
+typedef void (*benchmark_fn_t)(void *p_ctx);
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Measure the time of a function.
+ *
+ * The number of calls per repetition is calibrated so that every repetition lasts at least `BENCHMARK_MIN_TIME_NS`.
+ *
+ * @param p_fn Function under benchmark.
+ * @param p_ctx Context passed to the function.
+ * @return double Median over `BENCHMARK_REPETITIONS` repetitions of the time per call in ns.
+ */
+double benchmark_measure_ns(benchmark_fn_t p_fn, void *p_ctx);
+
+/**
+ * @brief Print a result line.
+ *
+ * @param p_metric Name of the metric (`<module>.<operation>`).
+ * @param value Value of the metric.
+ * @param p_unit Unit of the metric.
+ */
+void benchmark_report(const char *p_metric, double value, const char *p_unit);
+
+/**
+ * @brief Measure the time of a function and print it in ns per call.
+ *
+ * @param p_metric Name of the metric (`<module>.<operation>`).
+ * @param p_fn Function under benchmark.
+ * @param p_ctx Context passed to the function.
+ */
+void benchmark_run(const char *p_metric, benchmark_fn_t p_fn, void *p_ctx);
+
+/**
+ * @brief Measure and print the time of a fixed workload (`BENCHMARK_REFERENCE_METRIC`): a chain of `BENCHMARK_REFERENCE_ROUNDS` dependent xorshift rounds.
+ *
+ * The times of the firmware are compared against it instead of in absolute ns, so that the baseline holds on any machine. Every benchmark calls it first.
+ */
+void benchmark_run_reference(void);
+
+#endif /* BENCHMARK_H_ */
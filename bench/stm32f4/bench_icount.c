@@ -0,0 +1,306 @@
+/**
+ * @file bench_icount.c
+ * @brief Instruction-count benchmark of the Urbanite main loop, meant to be run under QEMU with `-icount`.
+ *
+ * This image builds the same FSMs as `main.c` and runs one benchmark phase, selected through the semihosting command line (`<phase> <iterations>`):
+ *
+ * - `cycle`: one full measurement cycle per iteration (trigger ready, trigger end, echo start, echo end), including the display update of the Urbanite.
+ * - `button`: one button event per iteration (press, debounce, 600 ms hold, release, debounce), which alternately pauses and resumes the display. No measurement arrives in this phase, so after each event the Urbanite goes to sleep in `SLEEP_WHILE_ON`, where only a measurement wakes it up. Every iteration puts it back in `MEASURE` first, as that measurement would, so that every event is taken by `fsm_urbanite_fire()`; the image exits with an error if an event is left queued at the end.
+ * - `idle`: one iteration of the main loop with no stimuli.
+ * - `isr`: one call of every ISR of the button and the ultrasound (EXTI15_10, TIM3, TIM2 twice and TIM5), without the main loop.
+ * - `null`: only the harness overhead of one main loop iteration (see `_bench_wake()`).
+ *
+ * Before any phase, a 1001 ms press turns the Urbanite on; the image exits with an error if it is not in `MEASURE` or `SLEEP_WHILE_ON` then. The stimuli are injected in software through the same port functions that the ISRs use (the pressed flag and the edge tick of the button, the flags and ticks of the ultrasound sensor), and the time is advanced with `port_system_set_millis()`, so that no GPIO or timer input has to be emulated. The image exits through semihosting when the phase is done, and `tools/qemu_icount_bench.py` computes the instructions per iteration by running every phase with two different numbers of iterations.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_button.h"
+#include "port_ultrasound.h"
+#include "port_display.h"
+#include "port_led.h"
+
+/* Microcontroller dependent includes */
+#include "stm32f4xx.h"
+
+/* Project includes */
+#include "fsm_button.h"
+#include "fsm_ultrasound.h"
+#include "fsm_display.h"
+#include "fsm_urbanite.h"
+#include "fsm.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define URBANITE_ON_OFF_PRESS_TIME_MS 1000 /*!< Time in ms to press the button to turn on/off the system (same as `main.c`) */
+#define URBANITE_PAUSE_DISPLAY_TIME_MS 500 /*!< Time in ms to pause the display system (same as `main.c`) */
+
+#define BENCH_PAUSE_PRESS_TIME_MS 600 /*!< Duration in ms of the button press of the `button` phase */
+#define BENCH_ECHO_TICKS 1160         /*!< Duration in ticks of the echo signal of the `cycle` phase (20 cm) */
+#define BENCH_CMDLINE_SIZE 64         /*!< Size of the buffer for the semihosting command line */
+
+#define BENCH_WAKE_IRQn TIM8_UP_TIM13_IRQn /*!< Unused interrupt that is kept pending so that `port_system_sleep()` returns immediately */
+
+#define SEMIHOSTING_SYS_GET_CMDLINE 0x15      /*!< Semihosting operation to read the command line */
+#define SEMIHOSTING_SYS_EXIT 0x18             /*!< Semihosting operation to stop the emulator */
+#define SEMIHOSTING_APPLICATION_EXIT 0x20026  /*!< Reason `ADP_Stopped_ApplicationExit` of `SYS_EXIT` */
+#define SEMIHOSTING_RUNTIME_ERROR 0x20023     /*!< Reason `ADP_Stopped_RunTimeErrorUnknown` of `SYS_EXIT`: QEMU exits with status 1 */
+
+/* Function prototypes -------------------------------------------------------*/
+void EXTI15_10_IRQHandler(void); /*!< Button ISR (interr.c) */
+void TIM2_IRQHandler(void);      /*!< Echo timer ISR (interr.c) */
+void TIM3_IRQHandler(void);      /*!< Trigger timer ISR (interr.c) */
+void TIM5_IRQHandler(void);      /*!< New measurement timer ISR (interr.c) */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_t *p_fsm_button;             /*!< Button FSM */
+static fsm_ultrasound_t *p_fsm_ultrasound_rear; /*!< Rear ultrasound FSM */
+static fsm_display_t *p_fsm_display_rear;       /*!< Rear display FSM */
+static fsm_urbanite_t *p_fsm_urbanite;          /*!< Urbanite FSM */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Perform a semihosting call.
+ *
+ * @param operation Semihosting operation number.
+ * @param p_arg Argument of the operation.
+ * @return int32_t Value returned by the debugger/emulator.
+ */
+static int32_t _bench_semihosting_call(uint32_t operation, void *p_arg)
+{
+    register uint32_t r0 __asm__("r0") = operation;
+    register void *r1 __asm__("r1") = p_arg;
+    __asm__ volatile("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return (int32_t)r0;
+}
+
+/**
+ * @brief Stop the emulator.
+ *
+ * @param reason Reason of the exit (`SEMIHOSTING_APPLICATION_EXIT` or `SEMIHOSTING_RUNTIME_ERROR`).
+ */
+static void _bench_exit(uint32_t reason)
+{
+    _bench_semihosting_call(SEMIHOSTING_SYS_EXIT, (void *)reason);
+    while (1)
+    {
+    }
+}
+
+/**
+ * @brief Keep an interrupt pending so that a `WFI` in the main loop does not wait for the next timer event.
+ *
+ * The cost of this function is measured by the `null` phase and subtracted by the benchmark script.
+ */
+static void _bench_wake(void)
+{
+    NVIC_SetPendingIRQ(BENCH_WAKE_IRQn);
+}
+
+/**
+ * @brief One iteration of the main loop, as in `main.c`.
+ */
+static void _bench_loop(void)
+{
+    _bench_wake();
+    fsm_button_fire(p_fsm_button);
+    fsm_ultrasound_fire(p_fsm_ultrasound_rear);
+    fsm_display_fire(p_fsm_display_rear);
+    fsm_urbanite_fire(p_fsm_urbanite);
+}
+
+/**
+ * @brief Advance the system time.
+ *
+ * @param ms Milliseconds to add to the system tick.
+ */
+static void _bench_advance_ms(uint32_t ms)
+{
+    port_system_set_millis(port_system_get_millis() + ms);
+}
+
+/**
+ * @brief Set the pressed flag and the tick of the button, as the EXTI ISR does at an edge.
+ *
+ * @param pressed Pressed flag.
+ */
+static void _bench_button_edge(bool pressed)
+{
+    port_button_set_tick(PORT_PARKING_BUTTON_ID, port_system_get_millis());
+    port_button_set_pressed(PORT_PARKING_BUTTON_ID, pressed);
+}
+
+/**
+ * @brief Press the button for a given time and release it (5 loop iterations).
+ *
+ * The main loop is fired at the press, after its debounce, at the end of the press while the button is still held, at the release and after its debounce. A press that reaches a held threshold emits its held event in the third iteration, as in `main.c`, where the button FSM is fired while the button is held.
+ *
+ * @param press_time_ms Time in ms between the press and the release (at least `PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS`).
+ */
+static void _bench_button_event(uint32_t press_time_ms)
+{
+    _bench_button_edge(true);
+    _bench_loop();
+    _bench_advance_ms(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS);
+    _bench_loop();
+    _bench_advance_ms(press_time_ms - PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS);
+    _bench_loop();
+    _bench_button_edge(false);
+    _bench_loop();
+    _bench_advance_ms(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS);
+    _bench_loop();
+}
+
+/**
+ * @brief Put the Urbanite in `MEASURE` and press the button long enough to pause or resume the display (5 loop iterations).
+ *
+ * The Urbanite is left in `SLEEP_WHILE_ON` by the previous event, and only a new measurement takes it back to `MEASURE`, with no output function.
+ */
+static void _bench_pause_event(void)
+{
+    fsm_set_state((fsm_t *)p_fsm_urbanite, MEASURE);
+    _bench_button_event(BENCH_PAUSE_PRESS_TIME_MS);
+}
+
+/**
+ * @brief Run a full measurement cycle of the rear ultrasound sensor (4 loop iterations).
+ */
+static void _bench_measurement_cycle(void)
+{
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    _bench_loop();
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    _bench_loop();
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    _bench_loop();
+    port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, 1 + BENCH_ECHO_TICKS);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    _bench_loop();
+}
+
+/**
+ * @brief Run every ISR of the button and the ultrasound once, as at the edges of a measurement (the echo timer ISR runs at both edges of the echo).
+ *
+ * The ISRs are called directly: the count includes their prologue and epilogue, but not the exception entry and exit of the core.
+ */
+static void _bench_isrs(void)
+{
+    EXTI15_10_IRQHandler();
+    TIM5_IRQHandler();
+    TIM3_IRQHandler();
+    TIM2_IRQHandler();
+    TIM2_IRQHandler();
+}
+
+/**
+ * @brief Read the benchmark phase and number of iterations from the semihosting command line.
+ *
+ * @param p_phase Buffer where the phase name is stored.
+ * @param size Size of the buffer.
+ * @return uint32_t Number of iterations (0 if it is not given).
+ */
+static uint32_t _bench_get_args(char *p_phase, uint32_t size)
+{
+    static char cmdline[BENCH_CMDLINE_SIZE];
+    uint32_t block[2] = {(uint32_t)cmdline, sizeof(cmdline)};
+    p_phase[0] = '\0';
+    if (_bench_semihosting_call(SEMIHOSTING_SYS_GET_CMDLINE, block) != 0)
+    {
+        return 0;
+    }
+
+    /* The command line is "[<program>] <phase> <iterations>": keep the last two words */
+    char *p_phase_word = NULL;
+    char *p_iterations_word = NULL;
+    for (char *p_word = strtok(cmdline, " "); p_word != NULL; p_word = strtok(NULL, " "))
+    {
+        p_phase_word = p_iterations_word;
+        p_iterations_word = p_word;
+    }
+    if (p_phase_word == NULL)
+    {
+        return 0;
+    }
+    strncpy(p_phase, p_phase_word, size - 1);
+    p_phase[size - 1] = '\0';
+    return strtoul(p_iterations_word, NULL, 10);
+}
+
+/* Interrupt service routines -------------------------------------------------*/
+/**
+ * @brief Empty handler of the interrupt used to wake the main loop up.
+ */
+void TIM8_UP_TIM13_IRQHandler(void)
+{
+}
+
+/* Main -----------------------------------------------------------------------*/
+/**
+ * @brief Benchmark entry point.
+ * @retval int
+ */
+int main(void)
+{
+    char phase[16];
+    uint32_t iterations = _bench_get_args(phase, sizeof(phase));
+
+    /* Same initialization as main.c */
+    port_system_init();
+    port_led_gpio_setup();
+    port_led_on();
+    NVIC_EnableIRQ(BENCH_WAKE_IRQn);
+
+    p_fsm_button = fsm_button_new(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    p_fsm_ultrasound_rear = fsm_ultrasound_new(PORT_REAR_PARKING_SENSOR_ID);
+    p_fsm_display_rear = fsm_display_new(PORT_REAR_PARKING_DISPLAY_ID);
+    p_fsm_urbanite = fsm_urbanite_new(p_fsm_button, URBANITE_ON_OFF_PRESS_TIME_MS, URBANITE_PAUSE_DISPLAY_TIME_MS, p_fsm_ultrasound_rear, p_fsm_display_rear);
+
+    /* Turn the Urbanite ON with a long press: every phase runs with the system measuring */
+    _bench_button_event(URBANITE_ON_OFF_PRESS_TIME_MS + 1);
+    _bench_loop();
+    int state = fsm_get_state((fsm_t *)p_fsm_urbanite);
+    if (state != MEASURE && state != SLEEP_WHILE_ON)
+    {
+        _bench_exit(SEMIHOSTING_RUNTIME_ERROR); /* The phases would measure a system that is OFF */
+    }
+
+    void (*p_iteration)(void) = _bench_wake;
+    if (strcmp(phase, "cycle") == 0)
+    {
+        p_iteration = _bench_measurement_cycle;
+    }
+    else if (strcmp(phase, "button") == 0)
+    {
+        p_iteration = _bench_pause_event;
+    }
+    else if (strcmp(phase, "idle") == 0)
+    {
+        p_iteration = _bench_loop;
+    }
+    else if (strcmp(phase, "isr") == 0)
+    {
+        p_iteration = _bench_isrs;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        p_iteration();
+    }
+    if (p_iteration == _bench_pause_event && fsm_urbanite_check_activity(p_fsm_urbanite))
+    {
+        _bench_exit(SEMIHOSTING_RUNTIME_ERROR); /* A button event has not been taken by the Urbanite */
+    }
+
+    _bench_exit(SEMIHOSTING_APPLICATION_EXIT);
+    return 0;
+}
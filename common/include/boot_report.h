@@ -0,0 +1,88 @@
+/**
+ * @file boot_report.h
+ * @brief Header for boot_report.c file.
+ *
+ * When the project is built with `USE_BOOT_REPORT`, the boot sequence and the first measurement are timestamped with the time base of the port (`port_boot.h`). The report is printed when the first color is shown. It gives the time from the entry of `main()` to the first color and from the wake (start of the ultrasound) to the first color.
+ *
+ * The marks up to `BOOT_REPORT_FSM_URBANITE_INIT` are recorded once per reset and printed in the first report only. Every start of the ultrasound records `BOOT_REPORT_ULTRASOUND_START` again and clears the later marks, so that every wake gets its own report, timed from the start of the ultrasound.
+ *
+ * The marks keep the raw counts of the time base, and only their differences are converted to µs, so an interval is right across the wrap-around of the time base as long as it is shorter than its range (268 s on the STM32F4).
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef BOOT_REPORT_H_
+#define BOOT_REPORT_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Enums */
+/**
+ * @brief Marks of the boot sequence, in the order of `main()`. With `USE_FAST_START`, `BOOT_REPORT_LED_SETUP` comes after `BOOT_REPORT_ULTRASOUND_START`.
+ */
+typedef enum
+{
+    BOOT_REPORT_MAIN = 0,            /*!< Entry of `main()`, origin of the time base */
+    BOOT_REPORT_SYSTEM_INIT,         /*!< End of `port_system_init()` */
+    BOOT_REPORT_LED_SETUP,           /*!< End of the setup of the LED */
+    BOOT_REPORT_FSM_ULTRASOUND_INIT, /*!< End of the initialization of the ultrasound FSM and its port */
+    BOOT_REPORT_FSM_DISPLAY_INIT,    /*!< End of the initialization of the display FSM and its port */
+    BOOT_REPORT_FSM_BUTTON_INIT,     /*!< End of the initialization of the button FSM and its port */
+    BOOT_REPORT_FSM_URBANITE_INIT,   /*!< End of the initialization of the Urbanite FSM */
+    BOOT_REPORT_ULTRASOUND_START,    /*!< Start of the ultrasound (wake) */
+    BOOT_REPORT_FIRST_ECHO,          /*!< First echo received */
+    BOOT_REPORT_FIRST_DISTANCE,      /*!< First distance published by the ultrasound FSM */
+    BOOT_REPORT_FIRST_COLOR,         /*!< First color sent to the display */
+    BOOT_REPORT_NUM_MARKS            /*!< Number of marks */
+} boot_report_mark_t;
+
+/* Defines */
+#ifdef USE_BOOT_REPORT
+#define BOOT_REPORT_START() boot_report_start()         /*!< Start the boot report (only with `USE_BOOT_REPORT`) */
+#define BOOT_REPORT_MARK(mark) boot_report_mark(mark)   /*!< Record a mark of the boot report (only with `USE_BOOT_REPORT`) */
+#else
+#define BOOT_REPORT_START()
+#define BOOT_REPORT_MARK(mark)
+#endif
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Start the time base of the port and record `BOOT_REPORT_MAIN`.
+ *
+ * It must be the first call of `main()`.
+ */
+void boot_report_start(void);
+
+/**
+ * @brief Record a mark, if it has not been recorded yet.
+ *
+ * `BOOT_REPORT_ULTRASOUND_START` is always recorded and clears the later marks. `BOOT_REPORT_FIRST_COLOR` prints the report.
+ *
+ * @param mark Mark to record.
+ */
+void boot_report_mark(boot_report_mark_t mark);
+
+/**
+ * @brief Get the time of a mark.
+ *
+ * @param mark Mark.
+ * @param p_us Pointer where the time in µs since `BOOT_REPORT_MAIN` is stored. It is right if the mark comes less than the range of the time base after `BOOT_REPORT_MAIN`.
+ * @return true If the mark has been recorded.
+ * @return false If it has not been recorded yet.
+ */
+bool boot_report_get_us(boot_report_mark_t mark, uint32_t *p_us);
+
+/**
+ * @brief Print the time of every recorded mark, the time since the previous one, and the totals to the first color.
+ *
+ * The first report of a reset is timed from `BOOT_REPORT_MAIN` and includes the marks of the boot. The next ones only have the marks of their wake, timed from `BOOT_REPORT_ULTRASOUND_START`.
+ */
+void boot_report_print(void);
+
+#endif /* BOOT_REPORT_H_ */
@@ -0,0 +1,196 @@
+/**
+ * @file button_gesture.h
+ * @brief Header for button_gesture.c file.
+ *
+ * The gesture recognizer turns the press and release timestamps of up to `BUTTON_GESTURE_MAX_BUTTONS` buttons into a queue of gesture events: click, double click, long press, hold-repeat and chord. It is fed by the button FSMs bound to it with `fsm_button_set_gesture()`, one call per debounced edge, and every edge costs O(1): the recognizer keeps the timestamps of the last press and the last click of every button and never polls the buttons.
+ *
+ * The events are emitted as soon as they can be decided, without waiting for the double-click window: the first click of a double click is a `BUTTON_GESTURE_CLICK` and the second one a `BUTTON_GESTURE_DOUBLE_CLICK`. The held and hold-repeat events depend on the time that passes while the button is held, so they are emitted by `button_gesture_tick()`. A bound button FSM calls it at every fire while its button is held; the recognizer keeps the offset of the next due event of every button, so a call that has nothing to emit costs one comparison per held button.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef BUTTON_GESTURE_H_
+#define BUTTON_GESTURE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define BUTTON_GESTURE_MAX_BUTTONS 2  /*!< Buttons of a recognizer (slots 0 to `BUTTON_GESTURE_MAX_BUTTONS - 1`); at least 2 for the chords */
+#define BUTTON_GESTURE_QUEUE_SIZE 4   /*!< Events of the queue (a power of 2) */
+#define BUTTON_GESTURE_NUM_HELD 2     /*!< Thresholds of the held events */
+
+_Static_assert((BUTTON_GESTURE_QUEUE_SIZE & (BUTTON_GESTURE_QUEUE_SIZE - 1)) == 0, "BUTTON_GESTURE_QUEUE_SIZE must be a power of 2");
+
+/* Enums */
+/**
+ * @brief Types of gesture events.
+ */
+typedef enum
+{
+    BUTTON_GESTURE_NONE = 0,     /*!< No event */
+    BUTTON_GESTURE_CLICK,        /*!< Release of a press of at least `min_click_ms` and shorter than `long_press_ms` */
+    BUTTON_GESTURE_DOUBLE_CLICK, /*!< Click whose press started at most `double_click_ms` after the release of the previous click */
+    BUTTON_GESTURE_LONG_PRESS,   /*!< Release of a press of at least `long_press_ms` */
+    BUTTON_GESTURE_HELD,         /*!< The press in progress reaches the threshold `held_ms[count - 1]`, before the release (emitted by `button_gesture_tick()`) */
+    BUTTON_GESTURE_HOLD_REPEAT,  /*!< Every `repeat_ms` while the button is held, once the press reaches `long_press_ms` (emitted by `button_gesture_tick()`) */
+    BUTTON_GESTURE_CHORD         /*!< All the buttons of the chord are held (emitted at the press that completes it) */
+} button_gesture_type_t;
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Timing of the gestures. A time of 0 disables the gesture (double click, held thresholds and hold-repeat).
+ */
+typedef struct
+{
+    /** @brief Shortest press that is a click: the shorter ones are ignored */
+    uint32_t min_click_ms;
+    /** @brief Shortest press that is a long press */
+    uint32_t long_press_ms;
+    /** @brief Longest time from the release of a click to the press of the next one to make a double click (0: no double clicks) */
+    uint32_t double_click_ms;
+    /** @brief Period of the hold-repeat events (0: no hold-repeat) */
+    uint32_t repeat_ms;
+    /** @brief Thresholds of the held events, in ascending order (0: no more thresholds) */
+    uint32_t held_ms[BUTTON_GESTURE_NUM_HELD];
+} button_gesture_config_t;
+
+/**
+ * @brief Gesture event.
+ */
+typedef struct
+{
+    /** @brief Type of the event (`button_gesture_type_t`) */
+    uint8_t type;
+    /** @brief Slot of the button (for a chord, the slot of the button that completed it) */
+    uint8_t slot;
+    /** @brief Number of the held threshold or of the hold-repeat event since the press (1 for the first one), 0 for the other events */
+    uint16_t count;
+    /** @brief Timestamp in ms of the edge (or of the threshold) that produced the event */
+    uint32_t tick;
+    /** @brief Duration in ms of the press (0 for a chord) */
+    uint32_t duration_ms;
+} button_gesture_event_t;
+
+/**
+ * @brief State of a button of a recognizer (private).
+ */
+typedef struct
+{
+    /** @brief Timestamp of the press in progress */
+    uint32_t press_tick;
+    /** @brief Timestamp of the release of the last click (for the double click) */
+    uint32_t click_tick;
+    /** @brief Time in ms from the press to the next held or hold-repeat event (`UINT32_MAX`: none) */
+    uint32_t next_ms;
+    /** @brief Hold-repeat events emitted during the press in progress */
+    uint16_t repeats;
+    /** @brief Flags of the button (held, last click can be doubled, part of a chord) */
+    uint8_t flags;
+    /** @brief Held thresholds passed during the press in progress */
+    uint8_t held;
+} button_gesture_button_t;
+
+/**
+ * @brief Gesture recognizer with its queue of events.
+ *
+ * The fields are private; the struct is public so that the recognizer can be embedded in the storage of its consumer.
+ */
+typedef struct
+{
+    /** @brief Timing of the gestures */
+    button_gesture_config_t config;
+    /** @brief State of every button */
+    button_gesture_button_t buttons[BUTTON_GESTURE_MAX_BUTTONS];
+    /** @brief Queue of events */
+    button_gesture_event_t queue[BUTTON_GESTURE_QUEUE_SIZE];
+    /** @brief Index of the next event to pop (free running) */
+    uint8_t head;
+    /** @brief Index of the next event to push (free running) */
+    uint8_t tail;
+    /** @brief Events dropped because the queue was full */
+    uint8_t dropped;
+    /** @brief Mask of the slots of the chord (0: no chord) */
+    uint8_t chord_mask;
+    /** @brief Mask of the slots of the held buttons */
+    uint8_t held_mask;
+} button_gesture_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initialize a gesture recognizer with an empty queue and no chord.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param p_config Timing of the gestures (copied).
+ */
+void button_gesture_init(button_gesture_t *p_gesture, const button_gesture_config_t *p_config);
+
+/**
+ * @brief Set the buttons of the chord.
+ *
+ * While a chord is in progress, the releases of its buttons do not produce clicks or long presses.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param chord_mask Mask of the slots of the chord (at least 2 bits set), or 0 to disable it.
+ */
+void button_gesture_set_chord(button_gesture_t *p_gesture, uint8_t chord_mask);
+
+/**
+ * @brief Feed the debounced press of a button.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param slot Slot of the button.
+ * @param tick Timestamp of the press in ms.
+ */
+void button_gesture_press(button_gesture_t *p_gesture, uint32_t slot, uint32_t tick);
+
+/**
+ * @brief Feed the debounced release of a button and emit its click, double click or long press.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param slot Slot of the button.
+ * @param tick Timestamp of the release in ms.
+ */
+void button_gesture_release(button_gesture_t *p_gesture, uint32_t slot, uint32_t tick);
+
+/**
+ * @brief Emit the held and hold-repeat events that are due at a given time.
+ *
+ * It only visits the held buttons, and returns at once when there is none. Every threshold passed since the last call is emitted, in order; of the hold-repeat events, only the last one that is due.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param now Current time in ms.
+ */
+void button_gesture_tick(button_gesture_t *p_gesture, uint32_t now);
+
+/**
+ * @brief Pop the oldest event of the queue.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param p_event Where the event is copied.
+ * @return true If an event has been popped, false if the queue is empty.
+ */
+bool button_gesture_pop(button_gesture_t *p_gesture, button_gesture_event_t *p_event);
+
+/**
+ * @brief Check whether the queue has events.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @return true If there is at least one event.
+ */
+bool button_gesture_pending(const button_gesture_t *p_gesture);
+
+/**
+ * @brief Get the number of events dropped because the queue was full.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @return uint32_t Number of dropped events (saturates at 255).
+ */
+uint32_t button_gesture_get_dropped(const button_gesture_t *p_gesture);
+
+#endif /* BUTTON_GESTURE_H_ */
@@ -0,0 +1,166 @@
+/**
+ * @file coroutine.h
+ * @brief Stackless coroutines (protothreads) for sequences of waits on events and deadlines.
+ *
+ * A coroutine is a function that runs a sequence, e.g. "start the trigger, wait for its end, wait for the echo, compute the distance", as straight-line code. When it has to wait, it returns to the main loop, which resumes it later: the next call continues after the wait. The state of a coroutine is its resume point, a `coroutine_t` of 2 bytes embedded in the context of the caller. There is no stack per coroutine and nothing is allocated.
+ *
+ * The macros are a `switch` on the resume point, whose cases are the lines of the waits:
+ *
+ * ```c
+ * static coroutine_status_t _run(my_ctx_t *p_ctx)
+ * {
+ *     COROUTINE_BEGIN(&p_ctx->co);
+ *     start_something();
+ *     p_ctx->deadline_us = port_system_get_micros64() + 10;
+ *     COROUTINE_WAIT_UNTIL_US(&p_ctx->co, p_ctx->deadline_us);
+ *     stop_something();
+ *     COROUTINE_WAIT_UNTIL(&p_ctx->co, something_done());
+ *     COROUTINE_END(&p_ctx->co);
+ * }
+ * ```
+ *
+ * Because the function returns at every wait, its local variables do not survive a wait: what the sequence needs after a wait must live in the context. Other rules of the `switch`:
+ *
+ * - Only one wait per source line.
+ * - No wait inside a `switch` of the coroutine function.
+ * - The function returns `coroutine_status_t` and has no code before `COROUTINE_BEGIN()` that must run only once.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define COROUTINE_START_POINT 0U        /*!< Resume point of a coroutine that has not started yet */
+#define COROUTINE_END_POINT UINT16_MAX /*!< Resume point of a coroutine that has ended */
+
+/* Enums */
+/**
+ * @brief Status returned by a coroutine to the caller that resumed it.
+ */
+typedef enum
+{
+    COROUTINE_WAITING = 0, /*!< The coroutine waits for an event or a deadline: resume it again */
+    COROUTINE_ENDED        /*!< The coroutine has run to its end */
+} coroutine_status_t;
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief State of a coroutine: the line where it resumes.
+ */
+typedef struct
+{
+    /** @brief Resume point: `COROUTINE_START_POINT`, `COROUTINE_END_POINT` or the line of a wait */
+    uint16_t resume_point;
+} coroutine_t;
+
+/* Macros of the coroutine functions ---------------------------------------------*/
+/**
+ * @brief Start of the body of a coroutine function.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ */
+#define COROUTINE_BEGIN(p_co)          \
+    switch ((p_co)->resume_point)      \
+    {                                  \
+    case COROUTINE_START_POINT:
+
+/**
+ * @brief End of the body of a coroutine function: the coroutine ends, and returns `COROUTINE_ENDED` every time it is resumed until it is restarted.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ */
+#define COROUTINE_END(p_co)                          \
+    }                                                \
+    (p_co)->resume_point = COROUTINE_END_POINT;      \
+    return COROUTINE_ENDED
+
+/**
+ * @brief Wait until a condition is true. The condition is evaluated now and every time the coroutine is resumed; if it is already true, the coroutine does not return.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ * @param condition Condition to wait for.
+ */
+#define COROUTINE_WAIT_UNTIL(p_co, condition)           \
+    do                                                  \
+    {                                                   \
+        if (!(condition))                               \
+        {                                               \
+            (p_co)->resume_point = (uint16_t)__LINE__;  \
+            return COROUTINE_WAITING;                   \
+        case __LINE__:                                  \
+            if (!(condition))                           \
+            {                                           \
+                return COROUTINE_WAITING;               \
+            }                                           \
+        }                                               \
+    } while (0)
+
+/**
+ * @brief Wait until a deadline of `port_system_get_micros64()`. The deadline must be stored in the context of the coroutine.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ * @param deadline_us Deadline in µs.
+ */
+#define COROUTINE_WAIT_UNTIL_US(p_co, deadline_us) COROUTINE_WAIT_UNTIL(p_co, port_system_get_micros64() >= (deadline_us))
+
+/**
+ * @brief Return to the caller once, and continue at the next resume.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ */
+#define COROUTINE_YIELD(p_co)                           \
+    do                                                  \
+    {                                                   \
+        (p_co)->resume_point = (uint16_t)__LINE__;      \
+        return COROUTINE_WAITING;                       \
+    case __LINE__:;                                     \
+    } while (0)
+
+/**
+ * @brief Return to the caller, and start again from the beginning at the next resume.
+ *
+ * @param p_co Pointer to the `coroutine_t` of the coroutine.
+ */
+#define COROUTINE_RESTART(p_co)                            \
+    do                                                     \
+    {                                                      \
+        (p_co)->resume_point = COROUTINE_START_POINT;      \
+        return COROUTINE_WAITING;                          \
+    } while (0)
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initialize a coroutine, or restart it from outside: it starts from the beginning at the next resume.
+ *
+ * @param p_co Pointer to the coroutine.
+ */
+static inline void coroutine_init(coroutine_t *p_co)
+{
+    p_co->resume_point = COROUTINE_START_POINT;
+}
+
+/**
+ * @brief Check whether a coroutine has run to its end.
+ *
+ * @param p_co Pointer to the coroutine.
+ * @return true If the coroutine has ended.
+ */
+static inline bool coroutine_is_ended(const coroutine_t *p_co)
+{
+    return p_co->resume_point == COROUTINE_END_POINT;
+}
+
+#endif /* COROUTINE_H_ */
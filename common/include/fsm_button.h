@@ -16,6 +16,7 @@
 
 /* Other includes */
 #include "fsm.h"
+#include "button_gesture.h"
 
 /* Defines and enums ----------------------------------------------------------*/
 /* Enums */
@@ -42,8 +43,36 @@ enum FSM_BUTTON
  */
 typedef struct fsm_button_t fsm_button_t;
 
+/**
+ * @brief Storage for a button FSM owned by the caller (e.g. a static variable), to be initialized with `fsm_button_init()`.
+ *
+ * The fields are private: they only reserve the size and the alignment of the `fsm_button_t` struct.
+ */
+typedef struct
+{
+    fsm_t f;              /*!< Base struct for FSMs */
+    void *reserved_ptr;   /*!< Private pointer of the button FSM */
+    uint32_t reserved[6]; /*!< Private fields of the button FSM */
+} fsm_button_storage_t;
+
+#define FSM_BUTTON_SIZE (sizeof(fsm_button_storage_t))    /*!< Size in bytes of the storage of a button FSM */
+#define FSM_BUTTON_ALIGN (_Alignof(fsm_button_storage_t)) /*!< Alignment in bytes of the storage of a button FSM */
+
 /* Function prototypes and explanation -------------------------------------------------*/
 
+/**
+ * @brief Initialize a button FSM on storage owned by the caller.
+ *
+ * The storage must have at least `FSM_BUTTON_SIZE` bytes aligned to `FSM_BUTTON_ALIGN` (e.g. a `fsm_button_storage_t` variable) and must outlive the FSM. No heap memory is used.
+ *
+ * @param p_storage Pointer to the storage of the FSM.
+ * @param debounce_time_ms Debounce time in ms.
+ * @param button_id Button ID.
+ * @return fsm_button_t* Pointer to the button FSM (same address as `p_storage`).
+ */
+fsm_button_t *fsm_button_init(void *p_storage, uint32_t debounce_time_ms, uint32_t button_id);
+
+#ifndef USE_NO_HEAP
 /**
  * @brief Create a new button FSM.
  * 
@@ -56,9 +85,12 @@ fsm_button_t *fsm_button_new(uint32_t debounce_time_ms, uint32_t button_id);
 /**
  * @brief Delete a button FSM.
  * 
+ * Only for FSMs created with `fsm_button_new()`.
+ *
  * @param p_fsm 
  */
 void fsm_button_destroy(fsm_button_t *p_fsm);
+#endif
 
 /**
  * @brief Fire the button FSM.
@@ -106,6 +138,17 @@ void fsm_button_reset_duration(fsm_button_t *p_fsm);
  */
 uint32_t fsm_button_get_debounce_time_ms(fsm_button_t *p_fsm);
 
+/**
+ * @brief Feed the presses and releases of the button to a gesture recognizer.
+ *
+ * Every debounced press and release calls `button_gesture_press()` or `button_gesture_release()` with its timestamp. The button FSM keeps its duration as before.
+ *
+ * @param p_fsm
+ * @param p_gesture Gesture recognizer, or NULL to stop feeding it.
+ * @param slot Slot of the button in the recognizer.
+ */
+void fsm_button_set_gesture(fsm_button_t *p_fsm, button_gesture_t *p_gesture, uint32_t slot);
+
 /**
  * @brief Check wether the button FSM is active or not.
  * 
@@ -39,8 +39,34 @@ enum FSM_DISPLAY_SYSTEM {
  */
 typedef struct fsm_display_t fsm_display_t;
 
+/**
+ * @brief Storage for a display FSM owned by the caller (e.g. a static variable), to be initialized with `fsm_display_init()`.
+ *
+ * The fields are private: they only reserve the size and the alignment of the `fsm_display_t` struct.
+ */
+typedef struct
+{
+    fsm_t f;              /*!< Base struct for FSMs */
+    uint32_t reserved[3]; /*!< Private fields of the display FSM */
+} fsm_display_storage_t;
+
+#define FSM_DISPLAY_SIZE (sizeof(fsm_display_storage_t))    /*!< Size in bytes of the storage of a display FSM */
+#define FSM_DISPLAY_ALIGN (_Alignof(fsm_display_storage_t)) /*!< Alignment in bytes of the storage of a display FSM */
+
 /* Function prototypes and explanation -------------------------------------------------*/
 
+/**
+ * @brief Initialize a display FSM on storage owned by the caller.
+ *
+ * The storage must have at least `FSM_DISPLAY_SIZE` bytes aligned to `FSM_DISPLAY_ALIGN` (e.g. a `fsm_display_storage_t` variable) and must outlive the FSM. No heap memory is used.
+ *
+ * @param p_storage Pointer to the storage of the FSM.
+ * @param display_id Display ID. Must be unique.
+ * @return fsm_display_t* Pointer to the display FSM (same address as `p_storage`).
+ */
+fsm_display_t *fsm_display_init(void *p_storage, uint32_t display_id);
+
+#ifndef USE_NO_HEAP
 /**
  * @brief Create a new display FSM.
  * 
@@ -54,10 +80,11 @@ fsm_display_t * fsm_display_new (uint32_t display_id);
 /**
  * @brief Delete a display FSM.
  * 
- * This function deletes the display FSM and frees the allocated memory.
+ * This function deletes the display FSM and frees the allocated memory. Only for FSMs created with `fsm_display_new()`.
  * @param p_fsm Pointer to the display FSM .
  */
 void fsm_display_destroy (fsm_display_t * p_fsm);
+#endif
 
 /**
  * @brief Set the display system to show the distance in cm.
@@ -95,11 +122,11 @@ bool fsm_display_get_status (fsm_display_t *p_fsm);
 void fsm_display_set_status (fsm_display_t *p_fsm, bool pause);
 
 /**
- * @brief Check if the display system is active.
+ * @brief Check if the display FSM has work to do at its next fire.
  *
- * This function checks if the display system is active.
+ * The display FSM is active when a transition of its current state can fire: it has to turn on (`WAIT_DISPLAY` with the display set active), to show a new color or to turn off (`SET_DISPLAY`). While it shows the last color it is inactive, even though the display is on; use `fsm_display_get_status()` to know whether it is on. The Urbanite FSM sleeps when none of its FSMs is active, so it sleeps with the display on until the next interrupt.
  * @param p_fsm Pointer to the display FSM.
- * @return true if the display system is active, false if paused.
+ * @return true if a transition of the current state can fire, false otherwise.
  */
 bool fsm_display_check_activity (fsm_display_t *p_fsm);
 
@@ -0,0 +1,89 @@
+/**
+ * @file fsm_hierarchical.h
+ * @brief Header for fsm_hierarchical.c file.
+ *
+ * When the project is built with `USE_FSM_HIERARCHICAL`, the Urbanite FSM is fired with `fsm_hierarchical_fire()`: its states are nested, so that the transitions shared by several states are written, and their guards evaluated, once in the state that contains them.
+ *
+ * - The FSM is always in a leaf state. A composite state only groups leaf or composite states; a transition to a composite state enters its initial state, down to a leaf.
+ * - The rows of a composite state are inherited by the states it contains. A fire checks the rows of the current leaf first, then the rows of its parent, and so on up to the top: a state overrides what it inherits.
+ * - A row without input function (`in == NULL`) always fires: it is the "else" of the rows before it, so that a guard and its negation are not evaluated twice.
+ * - Every state can have an entry and an exit action. A transition exits the states from the current leaf up to the lowest state that contains the origin and the destination, runs its output function, and enters the states down to the new leaf.
+ * - A transition whose destination is the current leaf runs only its output function, like a self-transition of a flat table.
+ *
+ * The hierarchical transitions table is not the one of the `fsm_t`, which keeps the flat table of the other dispatchers; its states are the same, plus the composite ones. As with `fsm_indexed.h`, the rows of every state are contiguous in the table, and the table and the states are `const` and live in flash; the rows of every state are found through slots built from the table by `fsm_hierarchical_init()`.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef FSM_HIERARCHICAL_H_
+#define FSM_HIERARCHICAL_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsm.h"
+
+/* Project includes */
+#include "fsm_indexed.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define FSM_HIERARCHICAL_NONE (-1)      /*!< No state: parent of a top state, initial state of a leaf */
+#define FSM_HIERARCHICAL_MAX_DEPTH 8U   /*!< Maximum number of nested states, from a top state to a leaf */
+#define FSM_HIERARCHICAL_NUM_STATES(states) ((uint32_t)(sizeof(states) / sizeof((states)[0]))) /*!< Number of states of an array of states */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief State of a hierarchical FSM.
+ */
+typedef struct
+{
+    /** @brief State that contains this one (`FSM_HIERARCHICAL_NONE`: top state) */
+    int8_t parent;
+    /** @brief State entered when this one is the destination of a transition (`FSM_HIERARCHICAL_NONE`: leaf state) */
+    int8_t initial;
+    /** @brief Entry action (NULL: none) */
+    fsm_output_func_t entry;
+    /** @brief Exit action (NULL: none) */
+    fsm_output_func_t exit;
+} fsm_hierarchical_state_t;
+
+/**
+ * @brief Transitions table and states of a hierarchical FSM.
+ */
+typedef struct
+{
+    /** @brief Transitions table, with the rows of every state together */
+    const fsm_trans_t *p_tt;
+    /** @brief States, indexed by state */
+    const fsm_hierarchical_state_t *p_states;
+    /** @brief Rows of every state, indexed by state and built from `p_tt` by `fsm_hierarchical_init()` */
+    fsm_indexed_slot_t *p_slots;
+    /** @brief Number of states, leaf and composite (entries of `p_states` and `p_slots`) */
+    uint32_t num_states;
+} fsm_hierarchical_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Build the rows of every state of a hierarchical FSM from its transitions table, with `fsm_indexed_init()`.
+ *
+ * If the rows of a state are not together in the table, or a state is out of `p_states`, no state has rows and the FSM does not fire.
+ *
+ * @param p_hierarchical Transitions table and states of the FSM. Its slots are written.
+ * @return true If every row of the table belongs to the rows of its state.
+ */
+bool fsm_hierarchical_init(const fsm_hierarchical_t *p_hierarchical);
+
+/**
+ * @brief Fire a hierarchical FSM: fire the first row whose input function returns `true` (or that has none), looking in the current leaf and then in the states that contain it.
+ *
+ * @param p_fsm Pointer to the FSM. Its current state must be a leaf state; its own transitions table is not used.
+ * @param p_hierarchical Transitions table and states of the FSM.
+ * @return int 1 if a transition has been fired, 0 otherwise.
+ */
+int fsm_hierarchical_fire(fsm_t *p_fsm, const fsm_hierarchical_t *p_hierarchical);
+
+#endif /* FSM_HIERARCHICAL_H_ */
@@ -0,0 +1,72 @@
+/**
+ * @file fsm_indexed.h
+ * @brief Header for fsm_indexed.c file.
+ *
+ * When the project is built with `USE_FSM_INDEXED`, the FSMs are fired with `fsm_indexed_fire()` instead of `fsm_fire()`. The rows of the transitions table of every origin state are contiguous, and an index gives the first row and the number of rows of each state, so that only the rows that can fire are visited. The tables are `const` and live in flash; the index of each table is built from it by `fsm_indexed_init()`, so it cannot get out of step with the table (2 bytes of RAM per state).
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef FSM_INDEXED_H_
+#define FSM_INDEXED_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsm.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define FSM_INDEXED_NUM_STATES(slots) ((uint32_t)(sizeof(slots) / sizeof((slots)[0]))) /*!< Number of states of an array of slots */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Rows of the transitions table of one origin state.
+ */
+typedef struct
+{
+    /** @brief Index of the first row of the state in the transitions table */
+    uint8_t first;
+    /** @brief Number of rows of the state */
+    uint8_t count;
+} fsm_indexed_slot_t;
+
+/**
+ * @brief Index of a transitions table by origin state.
+ */
+typedef struct
+{
+    /** @brief Rows of every state, indexed by state */
+    const fsm_indexed_slot_t *p_slots;
+    /** @brief Number of states of the FSM (entries of `p_slots`) */
+    uint32_t num_states;
+} fsm_indexed_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Build the rows of every state from a transitions table.
+ *
+ * The rows of every origin state must be contiguous in the table. If they are not, or if an origin state is out of the slots, every slot is left empty, so that no transition fires.
+ *
+ * @param p_slots Rows of every state, indexed by state. They are written.
+ * @param num_states Number of states (entries of `p_slots`).
+ * @param p_tt Transitions table, ended by a row with origin state -1.
+ * @return true If the index covers the whole table.
+ */
+bool fsm_indexed_init(fsm_indexed_slot_t *p_slots, uint32_t num_states, const fsm_trans_t *p_tt);
+
+/**
+ * @brief Fire an FSM visiting only the rows of its current state.
+ *
+ * The behaviour is the same as `fsm_fire()`: the first row of the current state whose input function returns `true` is fired. A state without rows (or out of the index) does not fire.
+ *
+ * @param p_fsm Pointer to the FSM.
+ * @param p_index Index of the transitions table of the FSM.
+ * @return int 1 if a transition has been fired, 0 otherwise.
+ */
+int fsm_indexed_fire(fsm_t *p_fsm, const fsm_indexed_t *p_index);
+
+#endif /* FSM_INDEXED_H_ */
@@ -0,0 +1,53 @@
+/**
+ * @file fsm_trace.h
+ * @brief Header for fsm_trace.c file.
+ *
+ * When the project is built with `USE_TRACE`, every FSM registers itself with a name and the names of its states, and it is fired with `fsm_trace_fire()` instead of `fsm_fire()`. The state spans and the transitions (with the row of the transitions table) are sent to the trace of the port (`port_trace.h`).
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef FSM_TRACE_H_
+#define FSM_TRACE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include "fsm.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define FSM_TRACE_MAX_FSMS 8 /*!< Maximum number of FSMs traced at the same time */
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Register an FSM in the trace and open the span of its current state.
+ *
+ * If there is no room for the FSM it is not traced, but it can still be fired with `fsm_trace_fire()`.
+ *
+ * @param p_fsm Pointer to the FSM.
+ * @param p_name Name of the track of the FSM.
+ * @param p_state_names Array with the name of every state, indexed by state.
+ */
+void fsm_trace_register(fsm_t *p_fsm, const char *p_name, const char *const *p_state_names);
+
+/**
+ * @brief Remove an FSM from the trace and close the span of its current state.
+ *
+ * @param p_fsm Pointer to the FSM.
+ */
+void fsm_trace_unregister(fsm_t *p_fsm);
+
+/**
+ * @brief Fire an FSM and trace the transition, if any.
+ *
+ * The behaviour is the same as `fsm_fire()`: the first row of the transitions table whose origin is the current state and whose input function returns `true` is fired. The transition is traced before its output function is called, so that the port calls of the output function follow the transition in the trace.
+ *
+ * @param p_fsm Pointer to the FSM.
+ * @return int 1 if a transition has been fired, 0 otherwise.
+ */
+int fsm_trace_fire(fsm_t *p_fsm);
+
+#endif /* FSM_TRACE_H_ */
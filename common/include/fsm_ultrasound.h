@@ -54,6 +54,20 @@ enum FSM_ULTRASOUND
  */
 typedef struct fsm_ultrasound_t fsm_ultrasound_t;
 
+/**
+ * @brief Storage for an ultrasound FSM owned by the caller (e.g. a static variable), to be initialized with `fsm_ultrasound_init()`.
+ *
+ * The fields are private: they only reserve the size and the alignment of the `fsm_ultrasound_t` struct.
+ */
+typedef struct
+{
+    fsm_t f;                                                 /*!< Base struct for FSMs */
+    uint32_t reserved[3 + FSM_ULTRASOUND_NUM_MEASUREMENTS]; /*!< Private fields of the ultrasound FSM */
+} fsm_ultrasound_storage_t;
+
+#define FSM_ULTRASOUND_SIZE (sizeof(fsm_ultrasound_storage_t))    /*!< Size in bytes of the storage of an ultrasound FSM */
+#define FSM_ULTRASOUND_ALIGN (_Alignof(fsm_ultrasound_storage_t)) /*!< Alignment in bytes of the storage of an ultrasound FSM */
+
 /* Function prototypes and explanation -------------------------------------------------*/
 
 /**
@@ -68,6 +82,18 @@ This function sets the current state of the ultrasound FSM.
  */
 void fsm_ultrasound_set_state(fsm_ultrasound_t *p_fsm, int8_t state);
 
+/**
+ * @brief Initialize an ultrasound FSM on storage owned by the caller.
+ *
+ * The storage must have at least `FSM_ULTRASOUND_SIZE` bytes aligned to `FSM_ULTRASOUND_ALIGN` (e.g. a `fsm_ultrasound_storage_t` variable) and must outlive the FSM. No heap memory is used.
+ *
+ * @param p_storage Pointer to the storage of the FSM.
+ * @param ultrasound_id Ultrasound ID. Must be unique.
+ * @return fsm_ultrasound_t* Pointer to the ultrasound FSM (same address as `p_storage`).
+ */
+fsm_ultrasound_t *fsm_ultrasound_init(void *p_storage, uint32_t ultrasound_id);
+
+#ifndef USE_NO_HEAP
 /**
  * @brief Create a new ultrasound FSM.
  *
@@ -81,11 +107,12 @@ fsm_ultrasound_t *fsm_ultrasound_new(uint32_t ultrasound_id);
 /**
  * @brief Destroy an ultrasound FSM.
  *
-This function destroys an ultrasound transceiver FSM and frees the memory.
+This function destroys an ultrasound transceiver FSM and frees the memory. Only for FSMs created with `fsm_ultrasound_new()`.
  *
  * @param p_fsm Pointer to an `fsm_ultrasound_t` struct.
  */
 void fsm_ultrasound_destroy(fsm_ultrasound_t *p_fsm);
+#endif
 
 /**
  * @brief Return the distance of the last object detected by the ultrasound sensor.a64l.
@@ -161,6 +188,8 @@ void fsm_ultrasound_stop(fsm_ultrasound_t *p_fsm);
  * @brief Start the ultrasound sensor.
  *
 This function starts the ultrasound sensor by indicating to the port to start the ultrasound sensor (to reset all timer ticks) and to set the status of the ultrasound sensor to active.
+ *
+ * With `USE_FAST_START`, the first echo after the start is published at once as a provisional distance, instead of waiting for the median of `FSM_ULTRASOUND_NUM_MEASUREMENTS` echoes.
  *
  * @param p_fsm Pointer to an ´fsm_ultrasound_t´ struct.
  */
@@ -187,12 +216,12 @@ This function returns the current state of the ultrasound FSM.
 uint32_t fsm_ultrasound_get_state(fsm_ultrasound_t *p_fsm);
 
 /**
- * @brief Check if the ultrasound sensor is doing a distance measurement.
+ * @brief Check if the ultrasound FSM has work to do at its next fire.
  *
-The ultrasound sensor is always inactive because all the transitions are due to HW interrupts.
+ * The ultrasound FSM is active when a transition of its current state can fire. Its transitions are due to HW interrupts: it is active only from the interrupt that sets a flag (end of the trigger, start or end of the echo, new measurement timer) until the fire that handles it, and when it has been started or stopped. While it waits for an interrupt it is inactive, even in the middle of a measurement. The Urbanite FSM sleeps when none of its FSMs is active, so it sleeps between the interrupts of a measurement but never with a flag left to handle.
  *
  * @param p_fsm Pointer to an ´fsm_ultrasound_t´ struct.
- * @return true
+ * @return true If a transition of the current state can fire.
  * @return false
  */
 bool fsm_ultrasound_check_activity(fsm_ultrasound_t *p_fsm);
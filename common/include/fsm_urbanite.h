@@ -22,7 +22,9 @@ enum FSM_URBANITE {
     OFF = 0,
     MEASURE,
     SLEEP_WHILE_OFF,
-    SLEEP_WHILE_ON
+    SLEEP_WHILE_ON,
+    SYSTEM_ON,  /*!< Composite state of MEASURE and SLEEP_WHILE_ON (`USE_FSM_HIERARCHICAL`): the FSM is never in it */
+    SYSTEM_OFF  /*!< Composite state of OFF and SLEEP_WHILE_OFF (`USE_FSM_HIERARCHICAL`): the FSM is never in it */
 };
 
 /**
@@ -31,7 +33,38 @@ enum FSM_URBANITE {
  */
 typedef struct fsm_urbanite_t fsm_urbanite_t;
 
+/**
+ * @brief Storage for an Urbanite FSM owned by the caller (e.g. a static variable), to be initialized with `fsm_urbanite_init()`.
+ *
+ * The fields are private: they only reserve the size and the alignment of the `fsm_urbanite_t` struct.
+ */
+typedef struct
+{
+    fsm_t f;                            /*!< Base struct for FSMs */
+    void *reserved_ptr[3];              /*!< Private pointers of the Urbanite FSM */
+    uint32_t reserved[1];               /*!< Private fields of the Urbanite FSM */
+    button_gesture_t reserved_gesture;  /*!< Private gesture recognizer of the Urbanite FSM */
+} fsm_urbanite_storage_t;
+
+#define FSM_URBANITE_SIZE (sizeof(fsm_urbanite_storage_t))    /*!< Size in bytes of the storage of an Urbanite FSM */
+#define FSM_URBANITE_ALIGN (_Alignof(fsm_urbanite_storage_t)) /*!< Alignment in bytes of the storage of an Urbanite FSM */
+
+/**
+ * @brief Initialize an Urbanite FSM on storage owned by the caller.
+ *
+ * The storage must have at least `FSM_URBANITE_SIZE` bytes aligned to `FSM_URBANITE_ALIGN` (e.g. a `fsm_urbanite_storage_t` variable) and must outlive the FSM. No heap memory is used.
+ *
+ * @param p_storage Pointer to the storage of the FSM.
+ * @param p_fsm_button Pointer to the button FSM to interact with the Urbanite. 
+ * @param on_off_press_time_ms Time in ms to consider ON/OFF of the Urbanite parking aid system. 
+ * @param pause_display_time_ms Time in ms to pause the display system. 
+ * @param p_fsm_ultrasound_rear Pointer to the rear ultrasound FSM. 
+ * @param p_fsm_display_rear Pointer to the rear display FSM. 
+ * @return fsm_urbanite_t* Pointer to the Urbanite FSM (same address as `p_storage`).
+ */
+fsm_urbanite_t *fsm_urbanite_init(void *p_storage, fsm_button_t *p_fsm_button, uint32_t on_off_press_time_ms, uint32_t pause_display_time_ms, fsm_ultrasound_t *p_fsm_ultrasound_rear, fsm_display_t *p_fsm_display_rear);
 
+#ifndef USE_NO_HEAP
 /**
  * @brief Create a new Urbanite FSM. 
  * 
@@ -45,6 +78,7 @@ typedef struct fsm_urbanite_t fsm_urbanite_t;
  * @return fsm_urbanite_t* Pointer to the Urbanite FSM. 
  */
 fsm_urbanite_t * fsm_urbanite_new (fsm_button_t *p_fsm_button, uint32_t on_off_press_time_ms, uint32_t pause_display_time_ms, fsm_ultrasound_t *p_fsm_ultrasound_rear, fsm_display_t *p_fsm_display_rear);
+#endif
 
 /**
  * @brief Fire the Urbanite FSM. 
@@ -55,13 +89,46 @@ fsm_urbanite_t * fsm_urbanite_new (fsm_button_t *p_fsm_button, uint32_t on_off_p
  */
 void fsm_urbanite_fire (fsm_urbanite_t *p_fsm);
 
+/**
+ * @brief Turn the Urbanite system ON at the next fire, as if the ON/OFF press had been detected.
+ * 
+ * It is used by the fast start (`USE_FAST_START`), which starts measuring at boot. It has no effect if the system is already ON.
+ * 
+ * @param p_fsm Pointer to an `fsm_urbanite_t` struct.
+ */
+void fsm_urbanite_turn_on (fsm_urbanite_t *p_fsm);
+
+/**
+ * @brief Check if the Urbanite FSM has an input to handle: a request to turn on, a gesture event of the button or a new measurement.
+ * 
+ * Without any of them, a fire can only move the FSM to a sleep state. It is the check of the task of the Urbanite FSM in the scheduler (`USE_SCHEDULER`), which then parks the task.
+ * 
+ * @param p_fsm Pointer to an `fsm_urbanite_t` struct.
+ * @return true If the Urbanite FSM has an input to handle.
+ * @return false
+ */
+bool fsm_urbanite_check_activity (fsm_urbanite_t *p_fsm);
+
+#ifdef USE_FSM_GUARD_COUNT
+/**
+ * @brief Get the number of input functions of the transitions tables called since the start, for all the Urbanite FSMs. It measures the cost of the guards of a dispatcher.
+ * 
+ * The calls are only counted in the builds of the benchmarks (`USE_FSM_GUARD_COUNT`), so that the firmware does not pay for them.
+ * 
+ * @return uint32_t Number of calls.
+ */
+uint32_t fsm_urbanite_get_guard_calls (void);
+#endif
+
+#ifndef USE_NO_HEAP
 /**
  * @brief Destroy an Urbanite FSM. 
  * 
- * This function destroys an Urbanite FSM and frees the memory.
+ * This function destroys an Urbanite FSM and frees the memory. Only for FSMs created with `fsm_urbanite_new()`.
  * 
  * @param p_fsm Pointer to an `fsm_urbanite_t` struct.
  */
 void fsm_urbanite_destroy (fsm_urbanite_t *p_fsm);
+#endif
 
 #endif /* FSM_URBANITE_H_ */
\ No newline at end of file
@@ -0,0 +1,172 @@
+/**
+ * @file scheduler.h
+ * @brief Header for scheduler.c file.
+ *
+ * The scheduler runs the FSMs of the system as cooperative tasks, each one with its own rate instead of the rate of the main loop. Every task has a period, a relative deadline and a priority:
+ *
+ * - A periodic task is released every `period_us` by a software timer (`soft_timer.h`). If it has a check function and the check is false at a release, the task is parked: the release is skipped and its timer is stopped, so that an FSM that is idle is neither fired nor wakes the CPU. A parked task is polled once per step, and released at once when its check becomes true, with its period restarting from then.
+ * - A task with a period of 0 is released by its check function alone, which is polled once per step: it is meant for the FSMs that only need attention on events. While its check is true it runs at every step, so the CPU does not sleep: a check that stays true for long, like a held button, fits better a periodic task with a check.
+ *
+ * `scheduler_step()` runs the released tasks to completion, one at a time and always the released task of highest priority first. It measures the response time of every job, from its release to its completion, and counts the deadline misses: the jobs that completed after their deadline and the releases that came while the previous job of the task had not run yet. When no task is released, the main loop sleeps: the software timers have armed the alarm of the system for the next release, and the interrupts of the events wake the CPU too. The checks of the tasks must therefore become true only in a job of another task or after an interrupt.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "soft_timer.h"
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Function that runs a job of a task, e.g. fires an FSM.
+ *
+ * @param p_ctx Context of the task.
+ */
+typedef void (*scheduler_fire_t)(void *p_ctx);
+
+/**
+ * @brief Function that checks whether a task has work to do.
+ *
+ * @param p_ctx Context of the task.
+ * @return true If the task must be released.
+ */
+typedef bool (*scheduler_check_t)(void *p_ctx);
+
+/**
+ * @brief Configuration of a task.
+ */
+typedef struct
+{
+    /** @brief Function that runs a job of the task */
+    scheduler_fire_t fire;
+    /** @brief Function that checks whether the task has work to do (NULL: always) */
+    scheduler_check_t check;
+    /** @brief Context of the functions */
+    void *p_ctx;
+    /** @brief Period in µs (0: released by the check function only) */
+    uint32_t period_us;
+    /** @brief Longest time in µs from the release of a job to its completion */
+    uint32_t deadline_us;
+    /** @brief Priority (0: highest) */
+    uint8_t priority;
+} scheduler_task_config_t;
+
+/**
+ * @brief Task of the scheduler.
+ *
+ * The fields are private; the struct is public so that the tasks can be embedded in the storage of their owners.
+ */
+typedef struct
+{
+    /** @brief Configuration of the task */
+    scheduler_task_config_t config;
+    /** @brief Timer of the periodic releases */
+    soft_timer_t timer;
+    /** @brief Service of the timer, set when the task is added, to park the task from the callback of the timer */
+    soft_timer_service_t *p_timers;
+    /** @brief Time in µs of the release of the pending job */
+    uint64_t release_us;
+    /** @brief Flag to indicate that a job has been released and has not run yet */
+    bool released;
+    /** @brief Step of the scheduler in which the last job ran */
+    uint32_t last_step;
+    /** @brief Jobs run */
+    uint32_t runs;
+    /** @brief Deadline misses */
+    uint32_t misses;
+    /** @brief Longest response time in µs */
+    uint32_t max_response_us;
+} scheduler_task_t;
+
+/**
+ * @brief Scheduler: tasks ordered by priority, and the software timers of their releases.
+ *
+ * The fields are private.
+ */
+typedef struct
+{
+    /** @brief Array of the tasks, owned by the caller, in the order of their priorities */
+    scheduler_task_t **p_tasks;
+    /** @brief Length of the array of the tasks */
+    uint32_t capacity;
+    /** @brief Tasks added */
+    uint32_t count;
+    /** @brief Service of the timers of the periodic releases */
+    soft_timer_service_t *p_timers;
+    /** @brief Steps run, to run at most one job per task and step */
+    uint32_t steps;
+} scheduler_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initialize a scheduler with no tasks.
+ *
+ * @param p_scheduler Pointer to the scheduler.
+ * @param p_tasks Array of the tasks, with one element per task.
+ * @param capacity Length of the array.
+ * @param p_timers Service of the software timers, with one free timer per periodic task.
+ */
+void scheduler_init(scheduler_t *p_scheduler, scheduler_task_t **p_tasks, uint32_t capacity, soft_timer_service_t *p_timers);
+
+/**
+ * @brief Initialize a task that has not been added to a scheduler.
+ *
+ * @param p_task Pointer to the task.
+ * @param p_config Configuration of the task (copied).
+ */
+void scheduler_task_init(scheduler_task_t *p_task, const scheduler_task_config_t *p_config);
+
+/**
+ * @brief Add a task to a scheduler. Its first periodic release is `first_release_us`; a task with a period of 0 is released as soon as its check is true.
+ *
+ * @param p_scheduler Pointer to the scheduler.
+ * @param p_task Pointer to the task.
+ * @param first_release_us Time in µs of the first periodic release (`port_system_get_micros64()`).
+ * @return true If the task has been added, false if the scheduler or the software timers are full.
+ */
+bool scheduler_add_task(scheduler_t *p_scheduler, scheduler_task_t *p_task, uint64_t first_release_us);
+
+/**
+ * @brief Run the released tasks in the order of their priorities.
+ *
+ * The event tasks are polled once, at the start of the step. After every job it looks for new periodic releases again, so that a task of higher priority released during a job runs before the tasks of lower priority that were already waiting. Every task runs at most one job per step: a task released again during the step, e.g. an overloaded one, waits for the next step, so that the step always returns.
+ *
+ * @param p_scheduler Pointer to the scheduler.
+ * @return uint32_t Number of jobs run: 0 if the CPU can sleep until the next release or event.
+ */
+uint32_t scheduler_step(scheduler_t *p_scheduler);
+
+/**
+ * @brief Get the number of jobs a task has run.
+ *
+ * @param p_task Pointer to the task.
+ * @return uint32_t Number of jobs.
+ */
+uint32_t scheduler_task_get_runs(const scheduler_task_t *p_task);
+
+/**
+ * @brief Get the number of deadline misses of a task: jobs completed after their deadline, and releases that came while the previous job had not run yet.
+ *
+ * @param p_task Pointer to the task.
+ * @return uint32_t Number of misses.
+ */
+uint32_t scheduler_task_get_misses(const scheduler_task_t *p_task);
+
+/**
+ * @brief Get the longest response time of a task, from the release of a job to its completion.
+ *
+ * @param p_task Pointer to the task.
+ * @return uint32_t Response time in µs.
+ */
+uint32_t scheduler_task_get_max_response_us(const scheduler_task_t *p_task);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,140 @@
+/**
+ * @file soft_timer.h
+ * @brief Header for soft_timer.c file.
+ *
+ * The software timers multiplex any number of one-shot and periodic deadlines onto the single alarm of the system port (`port_system_alarm_start()`). The running timers of a service are kept in a binary min-heap ordered by deadline, so that starting, stopping and expiring a timer costs O(log n) and finding the next deadline O(1). The service arms the alarm for the earliest deadline only when it changes.
+ *
+ * The service does not allocate memory: the timers and the array of the heap belong to the caller. The callbacks run in `soft_timer_dispatch()`, called from the main loop, never from an ISR; they can start and stop any timer, their own included.
+ *
+ * The times are in µs of `port_system_get_micros64()`, which does not wrap around.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef SOFT_TIMER_H_
+#define SOFT_TIMER_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define SOFT_TIMER_STOPPED UINT32_MAX /*!< Position in the heap of a timer that is not running */
+#define SOFT_TIMER_NEVER UINT64_MAX   /*!< Deadline of an empty service */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Callback of a timer.
+ *
+ * @param p_arg Argument given to `soft_timer_init()`.
+ */
+typedef void (*soft_timer_callback_t)(void *p_arg);
+
+/**
+ * @brief Software timer.
+ *
+ * The fields are private; the struct is public so that the timers can be embedded in the storage of their owners.
+ */
+typedef struct
+{
+    /** @brief Time in µs of the next expiry */
+    uint64_t deadline_us;
+    /** @brief Period in µs (0: one-shot) */
+    uint32_t period_us;
+    /** @brief Position in the heap of the service (`SOFT_TIMER_STOPPED`: not running) */
+    uint32_t index;
+    /** @brief Function called at every expiry */
+    soft_timer_callback_t callback;
+    /** @brief Argument of the callback */
+    void *p_arg;
+} soft_timer_t;
+
+/**
+ * @brief Service of software timers: min-heap of the running timers.
+ *
+ * The fields are private.
+ */
+typedef struct
+{
+    /** @brief Array of the heap, owned by the caller */
+    soft_timer_t **p_heap;
+    /** @brief Length of the array of the heap: most timers that can run at the same time */
+    uint32_t capacity;
+    /** @brief Running timers */
+    uint32_t count;
+    /** @brief Deadline the alarm of the system is armed for (`SOFT_TIMER_NEVER`: disarmed) */
+    uint64_t alarm_us;
+} soft_timer_service_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initialize a service with no running timers.
+ *
+ * @param p_service Pointer to the service.
+ * @param p_heap Array of the heap, with one element per timer that can run at the same time.
+ * @param capacity Length of the array.
+ */
+void soft_timer_service_init(soft_timer_service_t *p_service, soft_timer_t **p_heap, uint32_t capacity);
+
+/**
+ * @brief Initialize a stopped timer.
+ *
+ * @param p_timer Pointer to the timer.
+ * @param callback Function called at every expiry.
+ * @param p_arg Argument of the callback.
+ */
+void soft_timer_init(soft_timer_t *p_timer, soft_timer_callback_t callback, void *p_arg);
+
+/**
+ * @brief Start a timer, or restart it if it is running. O(log n).
+ *
+ * A periodic timer expires at `deadline_us`, then every `period_us`. The period is kept from the deadlines, not from the dispatches, so it does not drift; if the dispatches fall behind by more than a period, the missed expiries are skipped.
+ *
+ * @param p_service Pointer to the service.
+ * @param p_timer Pointer to the timer.
+ * @param deadline_us Time of the first expiry, in µs of `port_system_get_micros64()`.
+ * @param period_us Period in µs, or 0 for a one-shot timer.
+ * @return true If the timer runs, false if the heap is full.
+ */
+bool soft_timer_start(soft_timer_service_t *p_service, soft_timer_t *p_timer, uint64_t deadline_us, uint32_t period_us);
+
+/**
+ * @brief Stop a timer. O(log n). Stopping a stopped timer does nothing.
+ *
+ * @param p_service Pointer to the service.
+ * @param p_timer Pointer to the timer.
+ */
+void soft_timer_stop(soft_timer_service_t *p_service, soft_timer_t *p_timer);
+
+/**
+ * @brief Check whether a timer is running.
+ *
+ * @param p_timer Pointer to the timer.
+ * @return true If the timer is running.
+ */
+bool soft_timer_is_running(const soft_timer_t *p_timer);
+
+/**
+ * @brief Run the callbacks of the timers that are due, in the order of their deadlines, and arm the alarm of the system for the next deadline.
+ *
+ * Every due expiry costs O(log n); a call with nothing due costs one comparison.
+ *
+ * @param p_service Pointer to the service.
+ * @param now_us Current time in µs (`port_system_get_micros64()`).
+ * @return uint32_t Number of callbacks run.
+ */
+uint32_t soft_timer_dispatch(soft_timer_service_t *p_service, uint64_t now_us);
+
+/**
+ * @brief Get the earliest deadline of the running timers. O(1).
+ *
+ * @param p_service Pointer to the service.
+ * @return uint64_t Deadline in µs, or `SOFT_TIMER_NEVER` if no timer is running.
+ */
+uint64_t soft_timer_get_next_deadline(const soft_timer_service_t *p_service);
+
+#endif /* SOFT_TIMER_H_ */
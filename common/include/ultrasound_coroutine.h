@@ -0,0 +1,118 @@
+/**
+ * @file ultrasound_coroutine.h
+ * @brief Header for ultrasound_coroutine.c file.
+ *
+ * The measurement sequence of an ultrasound sensor written as a coroutine (`coroutine.h`) instead of the transitions table of `fsm_ultrasound.c`. It uses the same port and computes the same distances (`ultrasound_distance.h`): the median of `FSM_ULTRASOUND_NUM_MEASUREMENTS` echoes, and with `USE_FAST_START` the first echo after a start. The sequence waits for the start of a measurement, the end of the trigger and the echo, and gives up an echo that has not arrived when the next measurement is due.
+ *
+ * The main loop resumes it with `ultrasound_coroutine_run()` where it would fire the FSM. The caller owns the storage: nothing is allocated.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef ULTRASOUND_COROUTINE_H_
+#define ULTRASOUND_COROUTINE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "coroutine.h"
+#include "fsm_ultrasound.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define ULTRASOUND_COROUTINE_ECHO_TIMEOUT_US (PORT_PARKING_SENSOR_TIMEOUT_MS * 1000U) /*!< Time in µs from the start of a measurement after which its echo is given up */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Measurement coroutine of an ultrasound sensor.
+ *
+ * The fields are private; the struct is public so that the caller owns its storage.
+ */
+typedef struct
+{
+    /** @brief State of the coroutine */
+    coroutine_t co;
+    /** @brief ID of the ultrasound sensor */
+    uint32_t ultrasound_id;
+    /** @brief Distance measured by the ultrasound sensor in cm (median of the last echoes) */
+    uint32_t distance_cm;
+    /** @brief Distances of the last echoes in cm */
+    uint32_t distance_arr[FSM_ULTRASOUND_NUM_MEASUREMENTS];
+    /** @brief Time in µs after which the echo of the current measurement is given up */
+    uint64_t echo_deadline_us;
+    /** @brief Echoes given up */
+    uint32_t timeouts;
+    /** @brief Index of the distance array */
+    uint8_t distance_idx;
+    /** @brief Status of the ultrasound sensor (ON/OFF) */
+    bool status;
+    /** @brief Flag to indicate if a new measurement is ready */
+    bool new_measurement;
+    /** @brief Flag to publish the next echo at once as a provisional distance (fast start, `USE_FAST_START`) */
+    bool provisional_pending;
+} ultrasound_coroutine_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initialize the measurement coroutine of an ultrasound sensor, and its port. The sensor is OFF.
+ *
+ * @param p_uc Pointer to the coroutine.
+ * @param ultrasound_id Unique ultrasound sensor identifier number.
+ */
+void ultrasound_coroutine_init(ultrasound_coroutine_t *p_uc, uint32_t ultrasound_id);
+
+/**
+ * @brief Resume the measurement sequence until its next wait. It never ends: after an echo it waits for the next measurement.
+ *
+ * @param p_uc Pointer to the coroutine.
+ * @return coroutine_status_t `COROUTINE_WAITING`.
+ */
+coroutine_status_t ultrasound_coroutine_run(ultrasound_coroutine_t *p_uc);
+
+/**
+ * @brief Start the measurements (same as `fsm_ultrasound_start()`).
+ *
+ * @param p_uc Pointer to the coroutine.
+ */
+void ultrasound_coroutine_start(ultrasound_coroutine_t *p_uc);
+
+/**
+ * @brief Stop the measurements (same as `fsm_ultrasound_stop()`). The sequence goes back to wait for a start.
+ *
+ * @param p_uc Pointer to the coroutine.
+ */
+void ultrasound_coroutine_stop(ultrasound_coroutine_t *p_uc);
+
+/**
+ * @brief Return the distance of the last measurement, and reset the flag of a new measurement.
+ *
+ * @param p_uc Pointer to the coroutine.
+ * @return uint32_t Distance in cm.
+ */
+uint32_t ultrasound_coroutine_get_distance(ultrasound_coroutine_t *p_uc);
+
+/**
+ * @brief Check whether a new measurement is ready.
+ *
+ * @param p_uc Pointer to the coroutine.
+ * @return true If a distance has been measured since the last `ultrasound_coroutine_get_distance()`.
+ */
+bool ultrasound_coroutine_get_new_measurement_ready(const ultrasound_coroutine_t *p_uc);
+
+/**
+ * @brief Return the number of echoes given up because they did not arrive in time.
+ *
+ * @param p_uc Pointer to the coroutine.
+ * @return uint32_t Number of echoes.
+ */
+uint32_t ultrasound_coroutine_get_timeouts(const ultrasound_coroutine_t *p_uc);
+
+#endif /* ULTRASOUND_COROUTINE_H_ */
@@ -0,0 +1,52 @@
+/**
+ * @file ultrasound_distance.h
+ * @brief Header for ultrasound_distance.c file.
+ *
+ * Distance of an echo, median of the distances of the last echoes and distance to publish after each echo, shared by the ultrasound FSM (`fsm_ultrasound.c`) and the measurement coroutine (`ultrasound_coroutine.c`), so that both compute the same distances.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+#ifndef ULTRASOUND_DISTANCE_H_
+#define ULTRASOUND_DISTANCE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Compute the distance in cm of the echo received by an ultrasound sensor, from the ticks and the overflows of the timer of its echo signal.
+ *
+ * @param ultrasound_id ID of the ultrasound sensor.
+ * @return uint32_t Distance in cm.
+ */
+uint32_t ultrasound_distance_get_echo_cm(uint32_t ultrasound_id);
+
+/**
+ * @brief Compute the median of an array of distances: the middle distance if their number is odd, the mean of the two middle ones if it is even.
+ *
+ * @param p_distances Array of distances in cm. It is sorted in place.
+ * @param num_distances Number of distances (at least 1).
+ * @return uint32_t Median in cm.
+ */
+uint32_t ultrasound_distance_median(uint32_t *p_distances, uint32_t num_distances);
+
+/**
+ * @brief Store the distance of an echo in the array of the last distances, and give the distance to publish, if any.
+ *
+ * The median of the array is published when the array is full. With `USE_FAST_START`, the first echo after a start is also published at once as a provisional distance.
+ *
+ * @param p_distances Array of the last `FSM_ULTRASOUND_NUM_MEASUREMENTS` distances in cm.
+ * @param p_idx Index of the array where the distance is stored. It is advanced to the next one.
+ * @param p_provisional_pending Flag set at the start of the measurements. It is cleared when the provisional distance is published.
+ * @param distance_cm Distance of the echo in cm.
+ * @param p_distance_cm Distance to publish in cm. It is only written if the function returns true.
+ * @return true If there is a new distance to publish.
+ */
+bool ultrasound_distance_add(uint32_t *p_distances, uint8_t *p_idx, bool *p_provisional_pending, uint32_t distance_cm, uint32_t *p_distance_cm);
+
+#endif /* ULTRASOUND_DISTANCE_H_ */
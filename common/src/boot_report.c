@@ -0,0 +1,137 @@
+/**
+ * @file boot_report.c
+ * @brief Timestamps of the boot sequence and of the first measurement.
+ *
+ * The marks are kept in a small array of raw counts of the time base. Printing is left to the end (first color), so that the report does not delay the boot itself. Only the differences of the counts are converted to µs, so that the wrap-around of the time base does not break the intervals.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <inttypes.h>
+
+/* HW dependent includes */
+#include "port_boot.h"
+
+/* Project includes */
+#include "boot_report.h"
+
+/* Global variables ------------------------------------------------------------*/
+static uint32_t marks_ticks[BOOT_REPORT_NUM_MARKS]; /*!< Count of the time base at every mark (`port_boot_timer_get_ticks()`) */
+static bool marks_recorded[BOOT_REPORT_NUM_MARKS];  /*!< Flag of every mark: it has been recorded */
+static bool boot_reported;                          /*!< Flag to indicate that the marks of the boot have been printed: the next reports only have the marks of their wake */
+
+/**
+ * @brief Names of the marks in the report.
+ */
+static const char *const mark_names[BOOT_REPORT_NUM_MARKS] = {
+    [BOOT_REPORT_MAIN] = "main",
+    [BOOT_REPORT_SYSTEM_INIT] = "port_system_init",
+    [BOOT_REPORT_LED_SETUP] = "port_led_gpio_setup",
+    [BOOT_REPORT_FSM_ULTRASOUND_INIT] = "fsm_ultrasound_init",
+    [BOOT_REPORT_FSM_DISPLAY_INIT] = "fsm_display_init",
+    [BOOT_REPORT_FSM_BUTTON_INIT] = "fsm_button_init",
+    [BOOT_REPORT_FSM_URBANITE_INIT] = "fsm_urbanite_init",
+    [BOOT_REPORT_ULTRASOUND_START] = "ultrasound start (wake)",
+    [BOOT_REPORT_FIRST_ECHO] = "first echo",
+    [BOOT_REPORT_FIRST_DISTANCE] = "first distance",
+    [BOOT_REPORT_FIRST_COLOR] = "first color"};
+
+/* Public functions -----------------------------------------------------------*/
+void boot_report_start(void)
+{
+    port_boot_timer_start();
+    for (uint32_t mark = 0; mark < BOOT_REPORT_NUM_MARKS; mark++)
+    {
+        marks_recorded[mark] = false;
+    }
+    boot_reported = false;
+    boot_report_mark(BOOT_REPORT_MAIN);
+}
+
+void boot_report_mark(boot_report_mark_t mark)
+{
+    if (mark >= BOOT_REPORT_NUM_MARKS)
+    {
+        return;
+    }
+    if (mark == BOOT_REPORT_ULTRASOUND_START)
+    {
+        for (uint32_t later = BOOT_REPORT_ULTRASOUND_START + 1; later < BOOT_REPORT_NUM_MARKS; later++)
+        {
+            marks_recorded[later] = false;
+        }
+    }
+    else if (marks_recorded[mark])
+    {
+        return;
+    }
+    marks_ticks[mark] = port_boot_timer_get_ticks();
+    marks_recorded[mark] = true;
+    if (mark == BOOT_REPORT_FIRST_COLOR)
+    {
+        boot_report_print();
+        boot_reported = true;
+    }
+}
+
+bool boot_report_get_us(boot_report_mark_t mark, uint32_t *p_us)
+{
+    if (mark >= BOOT_REPORT_NUM_MARKS || !marks_recorded[mark])
+    {
+        return false;
+    }
+    *p_us = port_boot_timer_ticks_to_us(marks_ticks[mark] - marks_ticks[BOOT_REPORT_MAIN]);
+    return true;
+}
+
+void boot_report_print(void)
+{
+    /* The marks of the boot are only in the first report: at a later wake they can be further than the range of the time base */
+    boot_report_mark_t origin = boot_reported ? BOOT_REPORT_ULTRASOUND_START : BOOT_REPORT_MAIN;
+    if (!marks_recorded[origin])
+    {
+        return;
+    }
+    bool printed[BOOT_REPORT_NUM_MARKS] = {false};
+    uint32_t now_ticks = port_boot_timer_get_ticks();
+    uint32_t previous_ticks = marks_ticks[origin];
+    printf("[BOOT] %-24s %10s %10s\n", "mark", "us", "+us");
+    /* In order of time, the oldest first: with USE_FAST_START part of the initialization comes after the start of the ultrasound */
+    for (uint32_t printed_count = 0; printed_count < BOOT_REPORT_NUM_MARKS; printed_count++)
+    {
+        uint32_t next = BOOT_REPORT_NUM_MARKS;
+        for (uint32_t mark = origin; mark < BOOT_REPORT_NUM_MARKS; mark++)
+        {
+            if (marks_recorded[mark] && !printed[mark] && (next == BOOT_REPORT_NUM_MARKS || now_ticks - marks_ticks[mark] > now_ticks - marks_ticks[next]))
+            {
+                next = mark;
+            }
+        }
+        if (next == BOOT_REPORT_NUM_MARKS)
+        {
+            break;
+        }
+        printf("[BOOT] %-24s %10" PRIu32 " %10" PRIu32 "\n", mark_names[next],
+               port_boot_timer_ticks_to_us(marks_ticks[next] - marks_ticks[origin]), port_boot_timer_ticks_to_us(marks_ticks[next] - previous_ticks));
+        previous_ticks = marks_ticks[next];
+        printed[next] = true;
+    }
+    if (marks_recorded[BOOT_REPORT_FIRST_COLOR] && marks_recorded[BOOT_REPORT_ULTRASOUND_START])
+    {
+        uint32_t wake_us = port_boot_timer_ticks_to_us(marks_ticks[BOOT_REPORT_FIRST_COLOR] - marks_ticks[BOOT_REPORT_ULTRASOUND_START]);
+        if (origin == BOOT_REPORT_MAIN)
+        {
+            printf("[BOOT] main to first color: %" PRIu32 " us, wake to first color: %" PRIu32 " us\n",
+                   port_boot_timer_ticks_to_us(marks_ticks[BOOT_REPORT_FIRST_COLOR] - marks_ticks[BOOT_REPORT_MAIN]), wake_us);
+        }
+        else
+        {
+            printf("[BOOT] wake to first color: %" PRIu32 " us\n", wake_us);
+        }
+    }
+}
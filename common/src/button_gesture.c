@@ -0,0 +1,223 @@
+/**
+ * @file button_gesture.c
+ * @brief Gesture recognizer of the buttons: clicks, double clicks, long presses, held thresholds, hold-repeat and chords.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* Project includes */
+#include "button_gesture.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define BUTTON_GESTURE_FLAG_HELD 0x01U    /*!< The button is held */
+#define BUTTON_GESTURE_FLAG_CLICKED 0x02U /*!< The last release was a click that can be doubled */
+#define BUTTON_GESTURE_FLAG_CHORD 0x04U   /*!< The press in progress is part of a chord */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Push an event to the queue, or count it as dropped if the queue is full.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param type Type of the event.
+ * @param slot Slot of the button.
+ * @param count Number of the hold-repeat event.
+ * @param tick Timestamp of the event.
+ * @param duration_ms Duration of the press.
+ */
+static void _button_gesture_push(button_gesture_t *p_gesture, button_gesture_type_t type, uint32_t slot, uint16_t count, uint32_t tick, uint32_t duration_ms)
+{
+    if ((uint8_t)(p_gesture->tail - p_gesture->head) == BUTTON_GESTURE_QUEUE_SIZE)
+    {
+        if (p_gesture->dropped < UINT8_MAX)
+        {
+            p_gesture->dropped++;
+        }
+        return;
+    }
+    button_gesture_event_t *p_event = &p_gesture->queue[p_gesture->tail & (BUTTON_GESTURE_QUEUE_SIZE - 1)];
+    p_event->type = (uint8_t)type;
+    p_event->slot = (uint8_t)slot;
+    p_event->count = count;
+    p_event->tick = tick;
+    p_event->duration_ms = duration_ms;
+    p_gesture->tail++;
+}
+
+/**
+ * @brief Compute the time from the press to the next held or hold-repeat event of a button.
+ *
+ * @param p_gesture Pointer to the recognizer.
+ * @param p_button Pointer to the state of the button.
+ * @return uint32_t Time in ms, or `UINT32_MAX` if there is no next event.
+ */
+static uint32_t _button_gesture_next_ms(const button_gesture_t *p_gesture, const button_gesture_button_t *p_button)
+{
+    const button_gesture_config_t *p_config = &p_gesture->config;
+    uint32_t next_ms = UINT32_MAX;
+    if (p_button->held < BUTTON_GESTURE_NUM_HELD && p_config->held_ms[p_button->held] != 0)
+    {
+        next_ms = p_config->held_ms[p_button->held];
+    }
+    if (p_config->repeat_ms != 0)
+    {
+        uint32_t repeat_ms = p_config->long_press_ms + p_button->repeats * p_config->repeat_ms;
+        if (repeat_ms < next_ms)
+        {
+            next_ms = repeat_ms;
+        }
+    }
+    return next_ms;
+}
+
+/* Public functions -----------------------------------------------------------*/
+void button_gesture_init(button_gesture_t *p_gesture, const button_gesture_config_t *p_config)
+{
+    p_gesture->config = *p_config;
+    for (uint32_t slot = 0; slot < BUTTON_GESTURE_MAX_BUTTONS; slot++)
+    {
+        p_gesture->buttons[slot].press_tick = 0;
+        p_gesture->buttons[slot].click_tick = 0;
+        p_gesture->buttons[slot].next_ms = UINT32_MAX;
+        p_gesture->buttons[slot].repeats = 0;
+        p_gesture->buttons[slot].flags = 0;
+        p_gesture->buttons[slot].held = 0;
+    }
+    p_gesture->head = 0;
+    p_gesture->tail = 0;
+    p_gesture->dropped = 0;
+    p_gesture->chord_mask = 0;
+    p_gesture->held_mask = 0;
+}
+
+void button_gesture_set_chord(button_gesture_t *p_gesture, uint8_t chord_mask)
+{
+    p_gesture->chord_mask = chord_mask;
+}
+
+void button_gesture_press(button_gesture_t *p_gesture, uint32_t slot, uint32_t tick)
+{
+    if (slot >= BUTTON_GESTURE_MAX_BUTTONS)
+    {
+        return;
+    }
+    button_gesture_button_t *p_button = &p_gesture->buttons[slot];
+    p_button->press_tick = tick;
+    p_button->repeats = 0;
+    p_button->held = 0;
+    p_button->next_ms = _button_gesture_next_ms(p_gesture, p_button);
+    p_button->flags |= BUTTON_GESTURE_FLAG_HELD;
+    p_gesture->held_mask |= (uint8_t)(1U << slot);
+
+    uint8_t chord_mask = p_gesture->chord_mask;
+    if (chord_mask != 0 && (p_gesture->held_mask & chord_mask) == chord_mask && (chord_mask & (1U << slot)))
+    {
+        /* This press completes the chord: its buttons no longer click when they are released */
+        for (uint32_t chord_slot = 0; chord_slot < BUTTON_GESTURE_MAX_BUTTONS; chord_slot++)
+        {
+            if (chord_mask & (1U << chord_slot))
+            {
+                p_gesture->buttons[chord_slot].flags |= BUTTON_GESTURE_FLAG_CHORD;
+            }
+        }
+        _button_gesture_push(p_gesture, BUTTON_GESTURE_CHORD, slot, 0, tick, 0);
+    }
+}
+
+void button_gesture_release(button_gesture_t *p_gesture, uint32_t slot, uint32_t tick)
+{
+    if (slot >= BUTTON_GESTURE_MAX_BUTTONS)
+    {
+        return;
+    }
+    button_gesture_button_t *p_button = &p_gesture->buttons[slot];
+    const button_gesture_config_t *p_config = &p_gesture->config;
+    uint32_t duration_ms = tick - p_button->press_tick;
+    uint8_t flags = p_button->flags;
+    p_gesture->held_mask &= (uint8_t)~(1U << slot);
+    p_button->flags = flags & (uint8_t)~(BUTTON_GESTURE_FLAG_HELD | BUTTON_GESTURE_FLAG_CHORD);
+
+    if (flags & BUTTON_GESTURE_FLAG_CHORD)
+    {
+        p_button->flags &= (uint8_t)~BUTTON_GESTURE_FLAG_CLICKED;
+    }
+    else if (duration_ms >= p_config->long_press_ms)
+    {
+        p_button->flags &= (uint8_t)~BUTTON_GESTURE_FLAG_CLICKED;
+        _button_gesture_push(p_gesture, BUTTON_GESTURE_LONG_PRESS, slot, 0, tick, duration_ms);
+    }
+    else if (duration_ms >= p_config->min_click_ms)
+    {
+        if (p_config->double_click_ms != 0 && (flags & BUTTON_GESTURE_FLAG_CLICKED) && (p_button->press_tick - p_button->click_tick) <= p_config->double_click_ms)
+        {
+            p_button->flags &= (uint8_t)~BUTTON_GESTURE_FLAG_CLICKED;
+            _button_gesture_push(p_gesture, BUTTON_GESTURE_DOUBLE_CLICK, slot, 0, tick, duration_ms);
+        }
+        else
+        {
+            p_button->flags |= BUTTON_GESTURE_FLAG_CLICKED;
+            p_button->click_tick = tick;
+            _button_gesture_push(p_gesture, BUTTON_GESTURE_CLICK, slot, 0, tick, duration_ms);
+        }
+    }
+}
+
+void button_gesture_tick(button_gesture_t *p_gesture, uint32_t now)
+{
+    const button_gesture_config_t *p_config = &p_gesture->config;
+    uint32_t held = p_gesture->held_mask;
+    while (held != 0)
+    {
+        uint32_t slot = (uint32_t)__builtin_ctz(held);
+        held &= held - 1U;
+        button_gesture_button_t *p_button = &p_gesture->buttons[slot];
+        uint32_t elapsed_ms = now - p_button->press_tick;
+        if ((p_button->flags & BUTTON_GESTURE_FLAG_CHORD) || elapsed_ms < p_button->next_ms)
+        {
+            continue;
+        }
+        while (p_button->held < BUTTON_GESTURE_NUM_HELD && p_config->held_ms[p_button->held] != 0 && elapsed_ms >= p_config->held_ms[p_button->held])
+        {
+            uint32_t threshold_ms = p_config->held_ms[p_button->held];
+            p_button->held++;
+            _button_gesture_push(p_gesture, BUTTON_GESTURE_HELD, slot, p_button->held, p_button->press_tick + threshold_ms, threshold_ms);
+        }
+        if (p_config->repeat_ms != 0 && elapsed_ms >= p_config->long_press_ms)
+        {
+            /* One event per call, with the number of the last repeat that is due: the missed ones are not queued */
+            uint32_t due = (elapsed_ms - p_config->long_press_ms) / p_config->repeat_ms + 1U;
+            if (due > p_button->repeats)
+            {
+                uint32_t offset_ms = p_config->long_press_ms + (due - 1U) * p_config->repeat_ms;
+                p_button->repeats = (uint16_t)due;
+                _button_gesture_push(p_gesture, BUTTON_GESTURE_HOLD_REPEAT, slot, (uint16_t)due, p_button->press_tick + offset_ms, offset_ms);
+            }
+        }
+        p_button->next_ms = _button_gesture_next_ms(p_gesture, p_button);
+    }
+}
+
+bool button_gesture_pop(button_gesture_t *p_gesture, button_gesture_event_t *p_event)
+{
+    if (p_gesture->head == p_gesture->tail)
+    {
+        return false;
+    }
+    *p_event = p_gesture->queue[p_gesture->head & (BUTTON_GESTURE_QUEUE_SIZE - 1)];
+    p_gesture->head++;
+    return true;
+}
+
+bool button_gesture_pending(const button_gesture_t *p_gesture)
+{
+    return p_gesture->head != p_gesture->tail;
+}
+
+uint32_t button_gesture_get_dropped(const button_gesture_t *p_gesture)
+{
+    return p_gesture->dropped;
+}
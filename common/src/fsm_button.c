@@ -16,6 +16,8 @@
 /* Project includes */
 #include "fsm_button.h"
 #include "fsm.h"
+#include "fsm_trace.h"
+#include "fsm_indexed.h"
 
 /**
  * @brief Structure of the Button FSM.
@@ -23,6 +25,10 @@
 struct fsm_button_t {
     /** @brief Base struct for FSMs */
     fsm_t f; 
+    /** @brief Gesture recognizer fed with the presses and releases (NULL if none) */
+    button_gesture_t *p_gesture;
+    /** @brief Slot of the button in the gesture recognizer */
+    uint32_t gesture_slot;
     /** @brief Debounce time in ms */
     uint32_t debounce_time_ms; 
     /** @brief Next timeout for the FSM */
@@ -35,6 +41,9 @@ struct fsm_button_t {
     uint32_t button_id; 
 };
 
+_Static_assert(sizeof(fsm_button_t) <= FSM_BUTTON_SIZE, "FSM_BUTTON_SIZE is smaller than the button FSM");
+_Static_assert(_Alignof(fsm_button_t) <= FSM_BUTTON_ALIGN, "FSM_BUTTON_ALIGN is smaller than the alignment of the button FSM");
+
 /* State machine input or transition functions */
 
 /**
@@ -70,7 +79,11 @@ static bool check_button_released(fsm_t * p_this)
  */
 static bool check_timeout(fsm_t * p_this)
 {
-    return port_system_get_millis() >= ((fsm_button_t *)p_this)->next_timeout;
+#ifdef USE_HW_DEBOUNCE
+    return true; /* The port has already debounced the edge with its timer */
+#else
+    return port_system_time_reached(port_system_get_millis(), ((fsm_button_t *)p_this)->next_timeout); /* Also right when the tick wraps around during the debounce */
+#endif
 }
 
 /* State machine output or action functions */
@@ -83,8 +96,14 @@ static bool check_timeout(fsm_t * p_this)
 static void do_store_tick_pressed(fsm_t * p_this)
 {
     fsm_button_t * estado = ((fsm_button_t *)p_this);
-    estado -> tick_pressed = port_system_get_millis();
-    estado -> next_timeout = port_system_get_millis() + estado->debounce_time_ms;
+    estado -> tick_pressed = port_button_get_tick(estado->button_id); /* Captured by the ISR at the edge: it does not depend on the latency of the loop */
+#ifndef USE_HW_DEBOUNCE
+    estado -> next_timeout = estado->tick_pressed + estado->debounce_time_ms;
+#endif
+    if (estado->p_gesture != NULL)
+    {
+        button_gesture_press(estado->p_gesture, estado->gesture_slot, estado->tick_pressed);
+    }
 }
 
 /**
@@ -95,8 +114,15 @@ static void do_store_tick_pressed(fsm_t * p_this)
 static void do_set_duration(fsm_t * p_this)
 {
     fsm_button_t * estado = ((fsm_button_t *)p_this);
-    estado->duration = port_system_get_millis() - estado->tick_pressed;
-    estado->next_timeout = port_system_get_millis() + estado->debounce_time_ms;
+    uint32_t tick_released = port_button_get_tick(estado->button_id);
+    estado->duration = tick_released - estado->tick_pressed;
+#ifndef USE_HW_DEBOUNCE
+    estado->next_timeout = tick_released + estado->debounce_time_ms;
+#endif
+    if (estado->p_gesture != NULL)
+    {
+        button_gesture_release(estado->p_gesture, estado->gesture_slot, tick_released);
+    }
 }
 
 /**
@@ -104,7 +130,7 @@ static void do_set_duration(fsm_t * p_this)
  * 
  * @image html docs/assets/imgs/fsm_button.png "Texto alternativo"
  */
-static fsm_trans_t fsm_trans_button[] = {
+static const fsm_trans_t fsm_trans_button[] = {
     { BUTTON_RELEASED, check_button_pressed, BUTTON_PRESSED_WAIT, do_store_tick_pressed },
     { BUTTON_PRESSED_WAIT, check_timeout, BUTTON_PRESSED, NULL},
     { BUTTON_PRESSED, check_button_released, BUTTON_RELEASED_WAIT, do_set_duration},
@@ -112,7 +138,49 @@ static fsm_trans_t fsm_trans_button[] = {
     { -1, NULL, -1, NULL }
 };
 
+#if defined(USE_FSM_INDEXED) && !defined(USE_FSM_SWITCH)
+/**
+ * @brief Rows of the transitions table of every state of the button FSM, built from the table by `fsm_indexed_init()`.
+ */
+static fsm_indexed_slot_t fsm_trans_button_slots[BUTTON_PRESSED_WAIT + 1];
+
+/**
+ * @brief Index of the transitions table of the button FSM.
+ */
+static const fsm_indexed_t fsm_index_button = {fsm_trans_button_slots, FSM_INDEXED_NUM_STATES(fsm_trans_button_slots)};
+#endif
+
+#ifdef USE_FSM_SWITCH
+#include "fsm_trans_button_switch.h" /* Generated from fsm_trans_button by tools/fsm_codegen.py */
+#endif
+
+#ifdef USE_TRACE
+/**
+ * @brief Names of the states of the button FSM in the trace.
+ */
+static const char *const fsm_button_state_names[] = {
+    [BUTTON_RELEASED] = "BUTTON_RELEASED",
+    [BUTTON_RELEASED_WAIT] = "BUTTON_RELEASED_WAIT",
+    [BUTTON_PRESSED] = "BUTTON_PRESSED",
+    [BUTTON_PRESSED_WAIT] = "BUTTON_PRESSED_WAIT"};
+#endif
+
 /* Other auxiliary functions */
+/**
+ * @brief Check whether the button is still held, to emit the held events of the gesture recognizer.
+ *
+ * @param p_fsm Pointer to the button FSM.
+ * @return true If the button is held.
+ */
+static bool _fsm_button_is_held(fsm_button_t *p_fsm)
+{
+#ifdef USE_HW_DEBOUNCE
+    return !port_button_get_value(p_fsm->button_id); /* The port posts the release a debounce time after its first edge: read the level (active low) */
+#else
+    return port_button_get_pressed(p_fsm->button_id);
+#endif
+}
+
 uint32_t fsm_button_get_duration(fsm_button_t *p_fsm)
 {
     return p_fsm->duration;
@@ -128,16 +196,20 @@ uint32_t fsm_button_get_debounce_time_ms(fsm_button_t *p_fsm)
     return p_fsm->debounce_time_ms;
 }
 
-/**
- * @brief Initializes the button FSM.
- * 
- * @param p_fsm_button 
- * @param debounce_time 
- * @param button_id 
- */
-static void fsm_button_init(fsm_button_t *p_fsm_button, uint32_t debounce_time, uint32_t button_id)
+void fsm_button_set_gesture(fsm_button_t *p_fsm, button_gesture_t *p_gesture, uint32_t slot)
 {
-    fsm_init(&p_fsm_button->f, fsm_trans_button);
+    p_fsm->p_gesture = p_gesture;
+    p_fsm->gesture_slot = slot;
+}
+
+/* Public functions -----------------------------------------------------------*/
+fsm_button_t *fsm_button_init(void *p_storage, uint32_t debounce_time, uint32_t button_id)
+{
+    fsm_button_t *p_fsm_button = (fsm_button_t *)p_storage;
+    fsm_init(&p_fsm_button->f, (fsm_trans_t *)fsm_trans_button); /* The FSM library only reads the table */
+#if defined(USE_FSM_INDEXED) && !defined(USE_FSM_SWITCH)
+    fsm_indexed_init(fsm_trans_button_slots, FSM_INDEXED_NUM_STATES(fsm_trans_button_slots), fsm_trans_button);
+#endif
 
     /* TODO alumnos: */
     /* Initialize the FSM with the proper parameters */
@@ -146,28 +218,55 @@ static void fsm_button_init(fsm_button_t *p_fsm_button, uint32_t debounce_time,
     p_fsm_button->tick_pressed = 0;
     p_fsm_button->duration = 0;
     p_fsm_button->next_timeout = 0;
+    p_fsm_button->p_gesture = NULL;
+    p_fsm_button->gesture_slot = 0;
     port_button_init(button_id);
+#ifdef USE_HW_DEBOUNCE
+    port_button_set_debounce_time_ms(button_id, debounce_time);
+#endif
+#ifdef USE_TRACE
+    fsm_trace_register(&p_fsm_button->f, "fsm_button", fsm_button_state_names);
+#endif
+    return p_fsm_button;
 }
 
-/* Public functions -----------------------------------------------------------*/
+#ifndef USE_NO_HEAP
 fsm_button_t *fsm_button_new(uint32_t debounce_time_ms, uint32_t button_id)
 {
-    fsm_button_t *p_fsm_button = malloc(sizeof(fsm_button_t)); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
-    fsm_button_init(p_fsm_button, debounce_time_ms, button_id);   /* Initialize the FSM */
-    return p_fsm_button;                                       /* Composite pattern: return the fsm_t pointer as a fsm_button_t pointer */
+    void *p_storage = malloc(FSM_BUTTON_SIZE);                      /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
+    return fsm_button_init(p_storage, debounce_time_ms, button_id); /* Composite pattern: return the fsm_t pointer as a fsm_button_t pointer */
 }
+#endif
 
 /* FSM-interface functions. These functions are used to interact with the FSM */
 void fsm_button_fire(fsm_button_t *p_fsm)
 {
+    /* Held events are emitted before the release of this fire is fed to the recognizer */
+    if (p_fsm->p_gesture != NULL && p_fsm->f.current_state == BUTTON_PRESSED && _fsm_button_is_held(p_fsm))
+    {
+        button_gesture_tick(p_fsm->p_gesture, port_system_get_millis());
+    }
+#ifdef USE_TRACE
+    fsm_trace_fire(&p_fsm->f);
+#elif defined(USE_FSM_SWITCH)
+    fsm_trans_button_switch_fire(&p_fsm->f);
+#elif defined(USE_FSM_INDEXED)
+    fsm_indexed_fire(&p_fsm->f, &fsm_index_button);
+#else
     fsm_fire(&p_fsm->f);
+#endif
     //fsm_fire((fsm_t *)p_fsm);
 }
 
+#ifndef USE_NO_HEAP
 void fsm_button_destroy(fsm_button_t *p_fsm)
 {
+#ifdef USE_TRACE
+    fsm_trace_unregister(&p_fsm->f);
+#endif
     free(&p_fsm->f);
 }
+#endif
 
 fsm_t *fsm_button_get_inner_fsm(fsm_button_t *p_fsm)
 {
@@ -181,9 +280,14 @@ uint32_t fsm_button_get_state(fsm_button_t *p_fsm)
 
 bool fsm_button_check_activity(fsm_button_t *p_fsm)
 {
+#ifdef USE_HW_DEBOUNCE
+    /* The debounce is done by the timer of the port, which wakes the CPU: only the press needs the system tick to measure its duration */
+    return p_fsm->f.current_state != BUTTON_RELEASED && p_fsm->f.current_state != BUTTON_RELEASED_WAIT;
+#else
     if (p_fsm->f.current_state == BUTTON_RELEASED){
         return false;
     } else {
         return true;
     }
+#endif
 }
\ No newline at end of file
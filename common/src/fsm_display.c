@@ -17,6 +17,9 @@
 /* Project includes */
 #include "fsm.h"
 #include "fsm_display.h"
+#include "fsm_trace.h"
+#include "fsm_indexed.h"
+#include "boot_report.h"
 /* Typedefs --------------------------------------------------------------------*/
 
 /**
@@ -28,40 +31,43 @@ struct  fsm_display_t {
     fsm_t f; 
     /** @brief Distance measured by the ultrasound sensor in cm */
     int32_t distance_cm; 
+    /** @brief ID of the display */
+    uint32_t display_id; 
     /** @brief Flag to indicate if a new color is ready */
     bool new_color; 
     /** @brief Status of the display (ON/OFF) */
     bool status; 
     /** @brief Flag to indicate if the display is idle */
     bool idle; 
-    /** @brief ID of the display */
-    uint32_t display_id; 
 };
 
+_Static_assert(sizeof(fsm_display_t) <= FSM_DISPLAY_SIZE, "FSM_DISPLAY_SIZE is smaller than the display FSM");
+_Static_assert(_Alignof(fsm_display_t) <= FSM_DISPLAY_ALIGN, "FSM_DISPLAY_ALIGN is smaller than the alignment of the display FSM");
+
 /* Private functions -----------------------------------------------------------*/
 /**
- * @brief Linear change of color
+ * @brief Linear change of color, in fixed point.
+ * 
+ * Every channel is `(color1 * (steps - step) + color2 * step) / steps`, truncated. It is bit-exact with the previous floating-point version, `(1 - f) * color1 + f * color2` with `f = step / steps`, for every distance of the display range (see test/native/test_display_fixed_point.c).
  * 
- * @param color1  The starting color (when factor f = 0.0).
- * @param color2  The ending color (when factor f = 1.0).
- * @param f Interpolation factor between 0.0 and 1.0. 
- *          - If f = 0.0, the result is color1.
- *          - If f = 1.0, the result is color2.
- *          - Intermediate values produce a blended color.
+ * @param color1  The starting color (when step = 0).
+ * @param color2  The ending color (when step = steps).
+ * @param step Position between both colors, from 0 to `steps`.
+ * @param steps Number of steps between both colors (the width of the range of distances in cm). Must be greater than 0.
  * @return rgb_color_t The resulting interpolated color.
  */
-static rgb_color_t changing_color(rgb_color_t color1, rgb_color_t color2, float f) {
+static rgb_color_t changing_color(rgb_color_t color1, rgb_color_t color2, uint32_t step, uint32_t steps) {
     rgb_color_t result;
-    result.r = (uint8_t)((1.0f - f) * color1.r + f * color2.r);
-    result.g = (uint8_t)((1.0f -f) * color1.g + f * color2.g);
-    result.b = (uint8_t)((1.0f - f) * color1.b + f * color2.b);
+    result.r = (uint8_t)((color1.r * (steps - step) + color2.r * step) / steps);
+    result.g = (uint8_t)((color1.g * (steps - step) + color2.g * step) / steps);
+    result.b = (uint8_t)((color1.b * (steps - step) + color2.b * step) / steps);
     return result;
 }
 
 /**
  * @brief Set color levels of the RGB LEDs according to the distance.
  * 
- * This function sets the levels of an RGB LED according to the distance measured by the ultrasound sensor. This RGB LED structure is later passed to the port_display_set_rgb() function to set the color of the RGB LED.
+ * This function sets the levels of an RGB LED according to the distance measured by the ultrasound sensor. This RGB LED structure is later passed to the port_display_set_rgb() function to set the color of the RGB LED. Only integer arithmetic is used.
  * 
  * @param p_color Pointer to an rgb_color_t struct that will store the levels of the RGB LED.
  * @param distance_cm Distance measured by the ultrasound sensor in centimeters. 
@@ -69,23 +75,23 @@ static rgb_color_t changing_color(rgb_color_t color1, rgb_color_t color2, float
 static void _compute_display_levels(rgb_color_t *p_color, int32_t distance_cm) {
     if (distance_cm <= WARNING_MIN_CM && distance_cm >= DANGER_MIN_CM) {
         // Rojo -> Amarillo
-        float t = (float)(distance_cm - DANGER_MIN_CM) / (WARNING_MIN_CM - DANGER_MIN_CM);
-        *p_color = changing_color(COLOR_RED, COLOR_YELLOW, t);
+        *p_color = changing_color(COLOR_RED, COLOR_YELLOW, distance_cm - DANGER_MIN_CM, WARNING_MIN_CM - DANGER_MIN_CM);
+    }
+    else if (distance_cm < DANGER_MIN_CM) {
+        // Fuera de rango (distancia negativa)
+        *p_color = COLOR_OFF;
     }
     else if (distance_cm <= NO_PROBLEM_MIN_CM) {
         // Amarillo -> Verde
-        float t = (float)(distance_cm - WARNING_MIN_CM) / (NO_PROBLEM_MIN_CM - WARNING_MIN_CM);
-        *p_color = changing_color(COLOR_YELLOW, COLOR_GREEN, t);
+        *p_color = changing_color(COLOR_YELLOW, COLOR_GREEN, distance_cm - WARNING_MIN_CM, NO_PROBLEM_MIN_CM - WARNING_MIN_CM);
     }
     else if (distance_cm <= INFO_MIN_CM) {
         // Verde -> Turquesa
-        float t = (float)(distance_cm - NO_PROBLEM_MIN_CM) / (INFO_MIN_CM - NO_PROBLEM_MIN_CM);
-        *p_color = changing_color(COLOR_GREEN, COLOR_TURQUOISE, t);
+        *p_color = changing_color(COLOR_GREEN, COLOR_TURQUOISE, distance_cm - NO_PROBLEM_MIN_CM, INFO_MIN_CM - NO_PROBLEM_MIN_CM);
     }
     else if (distance_cm <= OK_MIN_CM) {
         // Turquesa -> Azul
-        float t = (float)(distance_cm - INFO_MIN_CM) / (OK_MIN_CM - INFO_MIN_CM);
-        *p_color = changing_color(COLOR_TURQUOISE, COLOR_BLUE, t);
+        *p_color = changing_color(COLOR_TURQUOISE, COLOR_BLUE, distance_cm - INFO_MIN_CM, OK_MIN_CM - INFO_MIN_CM);
     }
     else if (distance_cm <= OK_MAX_CM) {
         // Azul fijo
@@ -158,6 +164,7 @@ static void do_set_color (fsm_t *p_this){
     rgb_color_t color;
     _compute_display_levels(&color, p_fsm_display->distance_cm);
     port_display_set_rgb(p_fsm_display->display_id, color);
+    BOOT_REPORT_MARK(BOOT_REPORT_FIRST_COLOR);
     p_fsm_display->new_color = false;
     p_fsm_display->idle = true;
 }
@@ -179,44 +186,76 @@ static void do_set_off (fsm_t *p_this){
  * @brief Array representing the transitions table of the FSM display.
  * 
  */
-static fsm_trans_t fsm_trans_display[] = {
+static const fsm_trans_t fsm_trans_display[] = {
     { WAIT_DISPLAY, check_active, SET_DISPLAY, do_set_on },
     { SET_DISPLAY, check_set_new_color,  SET_DISPLAY, do_set_color},
     { SET_DISPLAY, check_off, WAIT_DISPLAY, do_set_off},
     { -1, NULL, -1, NULL }
 };
 
+#ifdef USE_FSM_INDEXED
 /**
- * @brief Initialize a display system FSM.
- * 
- * This function initializes the default values of the FSM struct and calls to the port to initialize the associated HW given the ID.
- * 
- * @param p_fsm_display Pointer to the display FSM. 
- * @param display_id Unique display identifier number. 
+ * @brief Rows of the transitions table of every state of the display FSM, built from the table by `fsm_indexed_init()`.
  */
-static void fsm_display_init (fsm_display_t *p_fsm_display, uint32_t display_id){
-    fsm_init(&p_fsm_display->f, fsm_trans_display);
+static fsm_indexed_slot_t fsm_trans_display_slots[SET_DISPLAY + 1];
+
+/**
+ * @brief Index of the transitions table of the display FSM.
+ */
+static const fsm_indexed_t fsm_index_display = {fsm_trans_display_slots, FSM_INDEXED_NUM_STATES(fsm_trans_display_slots)};
+#endif
+
+#ifdef USE_TRACE
+/**
+ * @brief Names of the states of the display FSM in the trace.
+ */
+static const char *const fsm_display_state_names[] = {
+    [WAIT_DISPLAY] = "WAIT_DISPLAY",
+    [SET_DISPLAY] = "SET_DISPLAY"};
+#endif
+
+/* Public functions -----------------------------------------------------------*/
+fsm_display_t *fsm_display_init (void *p_storage, uint32_t display_id){
+    fsm_display_t *p_fsm_display = (fsm_display_t *)p_storage;
+    fsm_init(&p_fsm_display->f, (fsm_trans_t *)fsm_trans_display); /* The FSM library only reads the table */
+#ifdef USE_FSM_INDEXED
+    fsm_indexed_init(fsm_trans_display_slots, FSM_INDEXED_NUM_STATES(fsm_trans_display_slots), fsm_trans_display);
+#endif
     p_fsm_display->display_id = display_id;
     p_fsm_display->distance_cm = 10000; //inicializar a un valor que no se use
     p_fsm_display->new_color = false;
     p_fsm_display->status = false;
     p_fsm_display->idle = false;
     port_display_init(display_id);
+#ifdef USE_TRACE
+    fsm_trace_register(&p_fsm_display->f, "fsm_display", fsm_display_state_names);
+#endif
+    return p_fsm_display;
 }
-/* Public functions -----------------------------------------------------------*/
+
+#ifndef USE_NO_HEAP
 fsm_display_t *fsm_display_new(uint32_t display_id)
 {
-    fsm_display_t *p_fsm_display = malloc(sizeof(fsm_display_t)); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
-    fsm_display_init(p_fsm_display, display_id); /* Initialize the FSM */
-    return p_fsm_display;
+    void *p_storage = malloc(FSM_DISPLAY_SIZE); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
+    return fsm_display_init(p_storage, display_id); /* Initialize the FSM */
 };
 
 void fsm_display_destroy (fsm_display_t * p_fsm){
+#ifdef USE_TRACE
+    fsm_trace_unregister(&p_fsm->f);
+#endif
     free(p_fsm);
 }
+#endif
 
 void fsm_display_fire (fsm_display_t * p_fsm){
+#ifdef USE_TRACE
+    fsm_trace_fire(&p_fsm->f);
+#elif defined(USE_FSM_INDEXED)
+    fsm_indexed_fire(&p_fsm->f, &fsm_index_display);
+#else
     fsm_fire(&p_fsm->f);
+#endif
 }
 
 
@@ -234,7 +273,13 @@ void fsm_display_set_status (fsm_display_t *p_fsm, bool pause){
 }
 
 bool fsm_display_check_activity (fsm_display_t *p_fsm){
-    return (p_fsm->status && !p_fsm->idle); //triplazo
+    /* The guards of the rows of the current state: turn on, a new color, or turn off */
+    fsm_t *p_this = &p_fsm->f;
+    if (p_this->current_state == WAIT_DISPLAY)
+    {
+        return check_active(p_this);
+    }
+    return check_set_new_color(p_this) || check_off(p_this);
 }
 
 fsm_t * fsm_display_get_inner_fsm (fsm_display_t *p_fsm){
@@ -0,0 +1,128 @@
+/**
+ * @file fsm_hierarchical.c
+ * @brief FSM dispatcher with nested states, inherited transitions and entry/exit actions.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "fsm_hierarchical.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Check whether a state contains another one, or is the same state.
+ *
+ * @param p_states States of the FSM.
+ * @param ancestor State that may contain `state`.
+ * @param state State.
+ * @return true If `ancestor` is `state` or contains it.
+ */
+static bool _fsm_hierarchical_contains(const fsm_hierarchical_state_t *p_states, int ancestor, int state)
+{
+    for (; state != FSM_HIERARCHICAL_NONE; state = p_states[state].parent)
+    {
+        if (state == ancestor)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Fire a transition: exit the states up to the lowest state that contains the current leaf and the destination, run the output function and enter the states down to the new leaf.
+ *
+ * @param p_fsm Pointer to the FSM.
+ * @param p_states States of the FSM.
+ * @param p_t Row of the transition.
+ */
+static void _fsm_hierarchical_transition(fsm_t *p_fsm, const fsm_hierarchical_state_t *p_states, const fsm_trans_t *p_t)
+{
+    int leaf = p_fsm->current_state;
+    int target = p_t->dest_state;
+    while (p_states[target].initial != FSM_HIERARCHICAL_NONE)
+    {
+        target = p_states[target].initial;
+    }
+    if (target == leaf)
+    {
+        if (p_t->out)
+        {
+            p_t->out(p_fsm);
+        }
+        return;
+    }
+
+    int lca = p_t->dest_state;
+    while (lca != FSM_HIERARCHICAL_NONE && !_fsm_hierarchical_contains(p_states, lca, leaf))
+    {
+        lca = p_states[lca].parent;
+    }
+    for (int state = leaf; state != lca; state = p_states[state].parent)
+    {
+        if (p_states[state].exit)
+        {
+            p_states[state].exit(p_fsm);
+        }
+    }
+
+    p_fsm->current_state = target;
+    if (p_t->out)
+    {
+        p_t->out(p_fsm);
+    }
+
+    /* The states to enter, from the new leaf up: they are entered from the top down */
+    int path[FSM_HIERARCHICAL_MAX_DEPTH];
+    uint32_t depth = 0;
+    for (int state = target; state != lca && depth < FSM_HIERARCHICAL_MAX_DEPTH; state = p_states[state].parent)
+    {
+        path[depth++] = state;
+    }
+    while (depth > 0)
+    {
+        const fsm_hierarchical_state_t *p_state = &p_states[path[--depth]];
+        if (p_state->entry)
+        {
+            p_state->entry(p_fsm);
+        }
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+bool fsm_hierarchical_init(const fsm_hierarchical_t *p_hierarchical)
+{
+    return fsm_indexed_init(p_hierarchical->p_slots, p_hierarchical->num_states, p_hierarchical->p_tt);
+}
+
+int fsm_hierarchical_fire(fsm_t *p_fsm, const fsm_hierarchical_t *p_hierarchical)
+{
+    const fsm_hierarchical_state_t *p_states = p_hierarchical->p_states;
+    if ((uint32_t)p_fsm->current_state >= p_hierarchical->num_states)
+    {
+        return 0;
+    }
+
+    for (int state = p_fsm->current_state; state != FSM_HIERARCHICAL_NONE; state = p_states[state].parent)
+    {
+        const fsm_indexed_slot_t *p_slot = &p_hierarchical->p_slots[state];
+        const fsm_trans_t *p_t = &p_hierarchical->p_tt[p_slot->first];
+        const fsm_trans_t *p_end = p_t + p_slot->count;
+        for (; p_t < p_end; ++p_t)
+        {
+            if (p_t->in != NULL && !p_t->in(p_fsm))
+            {
+                continue;
+            }
+            _fsm_hierarchical_transition(p_fsm, p_states, p_t);
+            return 1;
+        }
+    }
+    return 0;
+}
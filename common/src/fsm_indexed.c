@@ -0,0 +1,80 @@
+/**
+ * @file fsm_indexed.c
+ * @brief FSM dispatcher with transitions tables indexed by state.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* Project includes */
+#include "fsm_indexed.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Empty every slot.
+ *
+ * @param p_slots Rows of every state.
+ * @param num_states Number of states.
+ */
+static void _fsm_indexed_clear(fsm_indexed_slot_t *p_slots, uint32_t num_states)
+{
+    for (uint32_t state = 0; state < num_states; state++)
+    {
+        p_slots[state].first = 0;
+        p_slots[state].count = 0;
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+bool fsm_indexed_init(fsm_indexed_slot_t *p_slots, uint32_t num_states, const fsm_trans_t *p_tt)
+{
+    _fsm_indexed_clear(p_slots, num_states);
+    int previous = -1;
+    for (uint32_t row = 0; p_tt[row].orig_state >= 0; row++)
+    {
+        uint32_t state = (uint32_t)p_tt[row].orig_state;
+        bool seen = state < num_states && p_slots[state].count > 0;
+        if (state >= num_states || row > UINT8_MAX || p_slots[state].count == UINT8_MAX || (seen && p_tt[row].orig_state != previous))
+        {
+            _fsm_indexed_clear(p_slots, num_states);
+            return false;
+        }
+        if (!seen)
+        {
+            p_slots[state].first = (uint8_t)row;
+        }
+        p_slots[state].count++;
+        previous = p_tt[row].orig_state;
+    }
+    return true;
+}
+
+int fsm_indexed_fire(fsm_t *p_fsm, const fsm_indexed_t *p_index)
+{
+    uint32_t state = (uint32_t)p_fsm->current_state;
+    if (state >= p_index->num_states)
+    {
+        return 0;
+    }
+
+    const fsm_indexed_slot_t *p_slot = &p_index->p_slots[state];
+    const fsm_trans_t *p_t = &p_fsm->p_tt[p_slot->first];
+    const fsm_trans_t *p_end = p_t + p_slot->count;
+    for (; p_t < p_end; ++p_t)
+    {
+        if (p_t->in(p_fsm))
+        {
+            p_fsm->current_state = p_t->dest_state;
+            if (p_t->out)
+            {
+                p_t->out(p_fsm);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
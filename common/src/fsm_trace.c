@@ -0,0 +1,131 @@
+/**
+ * @file fsm_trace.c
+ * @brief FSM trace main file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_trace.h"
+
+/* Project includes */
+#include "fsm_trace.h"
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure of a traced FSM.
+ */
+typedef struct
+{
+    /** @brief Pointer to the FSM, `NULL` if the entry is free */
+    fsm_t *p_fsm;
+    /** @brief Names of the states of the FSM, indexed by state */
+    const char *const *p_state_names;
+    /** @brief State whose span is open in the trace */
+    int state;
+} fsm_trace_entry_t;
+
+/* Global variables ------------------------------------------------------------*/
+/** @brief Traced FSMs. The index of the entry is the track of the FSM in the trace. */
+static fsm_trace_entry_t fsm_trace_arr[FSM_TRACE_MAX_FSMS];
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get the track of a traced FSM.
+ *
+ * @param p_fsm Pointer to the FSM.
+ *
+ * @return uint32_t Track of the FSM.
+ * @return FSM_TRACE_MAX_FSMS If the FSM is not traced.
+ */
+static uint32_t _fsm_trace_get_track(fsm_t *p_fsm)
+{
+    uint32_t track;
+    for (track = 0; track < FSM_TRACE_MAX_FSMS; track++)
+    {
+        if (fsm_trace_arr[track].p_fsm == p_fsm)
+        {
+            break;
+        }
+    }
+    return track;
+}
+
+/**
+ * @brief Close the span of the traced state of an FSM and open the span of a new state.
+ *
+ * @param track Track of the FSM.
+ * @param state New state of the FSM.
+ */
+static void _fsm_trace_set_state(uint32_t track, int state)
+{
+    fsm_trace_entry_t *p_entry = &fsm_trace_arr[track];
+    port_trace_state_end(track, p_entry->p_state_names[p_entry->state]);
+    port_trace_state_begin(track, p_entry->p_state_names[state]);
+    p_entry->state = state;
+}
+
+/* Public functions -----------------------------------------------------------*/
+void fsm_trace_register(fsm_t *p_fsm, const char *p_name, const char *const *p_state_names)
+{
+    uint32_t track = _fsm_trace_get_track(NULL);
+    if (track == FSM_TRACE_MAX_FSMS)
+    {
+        return;
+    }
+    fsm_trace_arr[track].p_fsm = p_fsm;
+    fsm_trace_arr[track].p_state_names = p_state_names;
+    fsm_trace_arr[track].state = p_fsm->current_state;
+    port_trace_track(track, p_name);
+    port_trace_state_begin(track, p_state_names[p_fsm->current_state]);
+}
+
+void fsm_trace_unregister(fsm_t *p_fsm)
+{
+    uint32_t track = _fsm_trace_get_track(p_fsm);
+    if (track == FSM_TRACE_MAX_FSMS)
+    {
+        return;
+    }
+    port_trace_state_end(track, fsm_trace_arr[track].p_state_names[fsm_trace_arr[track].state]);
+    fsm_trace_arr[track].p_fsm = NULL;
+}
+
+int fsm_trace_fire(fsm_t *p_fsm)
+{
+    uint32_t track = _fsm_trace_get_track(p_fsm);
+    if ((track < FSM_TRACE_MAX_FSMS) && (fsm_trace_arr[track].state != p_fsm->current_state))
+    {
+        /* The state has been changed out of the FSM (e.g. `fsm_set_state()`) */
+        _fsm_trace_set_state(track, p_fsm->current_state);
+    }
+
+    fsm_trans_t *p_t;
+    for (p_t = p_fsm->p_tt; p_t->orig_state >= 0; ++p_t)
+    {
+        if ((p_fsm->current_state == p_t->orig_state) && p_t->in(p_fsm))
+        {
+            p_fsm->current_state = p_t->dest_state;
+            if (track < FSM_TRACE_MAX_FSMS)
+            {
+                const char *const *p_names = fsm_trace_arr[track].p_state_names;
+                port_trace_transition(track, (uint32_t)(p_t - p_fsm->p_tt), p_names[p_t->orig_state], p_names[p_t->dest_state]);
+                if (p_t->orig_state != p_t->dest_state)
+                {
+                    _fsm_trace_set_state(track, p_t->dest_state);
+                }
+            }
+            if (p_t->out)
+            {
+                p_t->out(p_fsm);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -18,6 +18,10 @@
 
 /* Project includes */
 #include "fsm.h"
+#include "fsm_trace.h"
+#include "fsm_indexed.h"
+#include "boot_report.h"
+#include "ultrasound_distance.h"
 
 /* Typedefs --------------------------------------------------------------------*/
 
@@ -31,31 +35,26 @@ struct fsm_ultrasound_t
     fsm_t f;
     /** @brief Distance measured by the ultrasound sensor in cm */
     uint32_t distance_cm;
-    /** @brief Status of the ultrasound sensor (ON/OFF) */
-    bool status;
-    /** @brief Flag to indicate if a new measurement is ready */
-    bool new_measurement;
     /** @brief ID of the ultrasound sensor*/
     uint32_t ultrasound_id;
     /** @brief Array to store the distances measured by the ultrasound sensor */
     uint32_t distance_arr[FSM_ULTRASOUND_NUM_MEASUREMENTS];
-    /** @brief Index of the distance array */
-    uint32_t distance_idx;
+    /** @brief Index of the distance array (it shares a word with the flags, so there is no padding between fields) */
+    uint8_t distance_idx;
+    /** @brief Status of the ultrasound sensor (ON/OFF) */
+    bool status;
+    /** @brief Flag to indicate if a new measurement is ready */
+    bool new_measurement;
+    /** @brief Flag to publish the next echo at once as a provisional distance (fast start, `USE_FAST_START`) */
+    bool provisional_pending;
 };
 
-/* Private functions -----------------------------------------------------------*/
+_Static_assert(FSM_ULTRASOUND_NUM_MEASUREMENTS <= UINT8_MAX, "FSM_ULTRASOUND_NUM_MEASUREMENTS does not fit in distance_idx");
 
-/**
- * @brief Comparison function for qsort.
- * 
- * @param a 
- * @param b 
- * @return int 
- */
-int _compare(const void *a, const void *b)
-{
-    return (*(uint32_t *)a - *(uint32_t *)b);
-}
+_Static_assert(sizeof(fsm_ultrasound_t) <= FSM_ULTRASOUND_SIZE, "FSM_ULTRASOUND_SIZE is smaller than the ultrasound FSM");
+_Static_assert(_Alignof(fsm_ultrasound_t) <= FSM_ULTRASOUND_ALIGN, "FSM_ULTRASOUND_ALIGN is smaller than the alignment of the ultrasound FSM");
+
+/* Private functions -----------------------------------------------------------*/
 
 /* State machine input or transition functions */
 
@@ -184,38 +183,24 @@ static void do_stop_trigger(fsm_t *p_this)
  *
  This function is called when the ultrasound sensor has received the echo signal. It calculates the distance in cm and stores it in the array of distances.
  *
- When the array is full, it computes the median of the array and resets the index of the array.
+ When the array is full, it publishes the median of the array (`ultrasound_distance_add()`); with `USE_FAST_START` it also publishes the first echo after the start.
  *
  * @param p_this Pointer to an `fsm_t` struct that contains an `fsm_ultrasound_t`.
  */
 static void do_set_distance(fsm_t *p_this)
 {
-    // port_ultrasound_reset_echo_ticks(((fsm_ultrasound_t *)p_this)->ultrasound_id); // echo signal cleared
-    uint32_t init = port_ultrasound_get_echo_init_tick(((fsm_ultrasound_t *)p_this)->ultrasound_id);
-    uint32_t echo_end = port_ultrasound_get_echo_end_tick(((fsm_ultrasound_t *)p_this)->ultrasound_id);
-    uint32_t overflows = port_ultrasound_get_echo_overflows(((fsm_ultrasound_t *)p_this)->ultrasound_id);
+    fsm_ultrasound_t *p_fsm = (fsm_ultrasound_t *)p_this;
+    // port_ultrasound_reset_echo_ticks(p_fsm->ultrasound_id); // echo signal cleared
+    uint32_t distance = ultrasound_distance_get_echo_cm(p_fsm->ultrasound_id);
+    BOOT_REPORT_MARK(BOOT_REPORT_FIRST_ECHO);
 
-    uint32_t t = overflows * 0xFFFFFFFF + echo_end - init;
-    uint32_t distance = t * SPEED_OF_SOUND_MS / 2 / 10000;
-
-    ((fsm_ultrasound_t *)p_this)->distance_arr[((fsm_ultrasound_t *)p_this)->distance_idx] = distance;
-    if (((fsm_ultrasound_t *)p_this)->distance_idx >= FSM_ULTRASOUND_NUM_MEASUREMENTS - 1)
+    if (ultrasound_distance_add(p_fsm->distance_arr, &p_fsm->distance_idx, &p_fsm->provisional_pending, distance, &p_fsm->distance_cm))
     {
-        qsort(((fsm_ultrasound_t *)p_this)->distance_arr, FSM_ULTRASOUND_NUM_MEASUREMENTS, sizeof(uint32_t), _compare);
-        if (FSM_ULTRASOUND_NUM_MEASUREMENTS % 2 == 0)
-        {
-            ((fsm_ultrasound_t *)p_this)->distance_cm = (((fsm_ultrasound_t *)p_this)->distance_arr[FSM_ULTRASOUND_NUM_MEASUREMENTS / 2 - 1] + ((fsm_ultrasound_t *)p_this)->distance_arr[FSM_ULTRASOUND_NUM_MEASUREMENTS / 2]) / 2;
-        }
-        else
-        {
-            ((fsm_ultrasound_t *)p_this)->distance_cm = ((fsm_ultrasound_t *)p_this)->distance_arr[FSM_ULTRASOUND_NUM_MEASUREMENTS / 2 - 1];
-        }
-        ((fsm_ultrasound_t *)p_this)->new_measurement = true;
+        p_fsm->new_measurement = true;
+        BOOT_REPORT_MARK(BOOT_REPORT_FIRST_DISTANCE);
     }
-    // NO SABEMOS SI VA DENTRO DEL IF
-    ((fsm_ultrasound_t *)p_this)->distance_idx = (((fsm_ultrasound_t *)p_this)->distance_idx + 1) % FSM_ULTRASOUND_NUM_MEASUREMENTS;
-    port_ultrasound_stop_echo_timer(((fsm_ultrasound_t *)p_this)->ultrasound_id);
-    port_ultrasound_reset_echo_ticks(((fsm_ultrasound_t *)p_this)->ultrasound_id);
+    port_ultrasound_stop_echo_timer(p_fsm->ultrasound_id);
+    port_ultrasound_reset_echo_ticks(p_fsm->ultrasound_id);
 }
 
 /**
@@ -236,7 +221,7 @@ static void do_stop_measurement(fsm_t *p_this)
  * @brief Array representing the transitions table of the FSM ultrasound. 
  * 
  */
-fsm_trans_t fsm_trans_ultrasound[] = {
+static const fsm_trans_t fsm_trans_ultrasound[] = {
     {WAIT_START, check_on, TRIGGER_START, do_start_measurement},
     {TRIGGER_START, check_trigger_end, WAIT_ECHO_START, do_stop_trigger},
     {WAIT_ECHO_START, check_echo_init, WAIT_ECHO_END, NULL},
@@ -245,23 +230,51 @@ fsm_trans_t fsm_trans_ultrasound[] = {
     {SET_DISTANCE, check_off, WAIT_START, do_stop_measurement},
     {-1, NULL, -1, NULL}};
 
-/* Other auxiliary functions */
+#if defined(USE_FSM_INDEXED) && !defined(USE_FSM_SWITCH)
 /**
- * @brief Initialize a button FSM.
- * 
- * @param p_fsm_ultrasound 
- * @param ultrasound_id 
+ * @brief Rows of the transitions table of every state of the ultrasound FSM, built from the table by `fsm_indexed_init()`.
  */
-void fsm_ultrasound_init(fsm_ultrasound_t *p_fsm_ultrasound, uint32_t ultrasound_id)
+static fsm_indexed_slot_t fsm_trans_ultrasound_slots[SET_DISTANCE + 1];
+
+/**
+ * @brief Index of the transitions table of the ultrasound FSM.
+ */
+static const fsm_indexed_t fsm_index_ultrasound = {fsm_trans_ultrasound_slots, FSM_INDEXED_NUM_STATES(fsm_trans_ultrasound_slots)};
+#endif
+
+#ifdef USE_FSM_SWITCH
+#include "fsm_trans_ultrasound_switch.h" /* Generated from fsm_trans_ultrasound by tools/fsm_codegen.py */
+#endif
+
+#ifdef USE_TRACE
+/**
+ * @brief Names of the states of the ultrasound FSM in the trace.
+ */
+static const char *const fsm_ultrasound_state_names[] = {
+    [WAIT_START] = "WAIT_START",
+    [TRIGGER_START] = "TRIGGER_START",
+    [WAIT_ECHO_START] = "WAIT_ECHO_START",
+    [WAIT_ECHO_END] = "WAIT_ECHO_END",
+    [SET_DISTANCE] = "SET_DISTANCE"};
+#endif
+
+/* Public functions -----------------------------------------------------------*/
+fsm_ultrasound_t *fsm_ultrasound_init(void *p_storage, uint32_t ultrasound_id)
 {
+    fsm_ultrasound_t *p_fsm_ultrasound = (fsm_ultrasound_t *)p_storage;
+
     // Initialize the FSM
-    fsm_init(&p_fsm_ultrasound->f, fsm_trans_ultrasound);
+    fsm_init(&p_fsm_ultrasound->f, (fsm_trans_t *)fsm_trans_ultrasound); /* The FSM library only reads the table */
+#if defined(USE_FSM_INDEXED) && !defined(USE_FSM_SWITCH)
+    fsm_indexed_init(fsm_trans_ultrasound_slots, FSM_INDEXED_NUM_STATES(fsm_trans_ultrasound_slots), fsm_trans_ultrasound);
+#endif
 
     /* TODO alumnos: */
     // Initialize the fields of the FSM structure
     p_fsm_ultrasound->distance_cm = 0;
     p_fsm_ultrasound->status = false;
     p_fsm_ultrasound->new_measurement = false;
+    p_fsm_ultrasound->provisional_pending = false;
     p_fsm_ultrasound->distance_idx = 0;
     p_fsm_ultrasound->ultrasound_id = ultrasound_id; // ESTO ARREGLA COSAS
     // memset(p_fsm_ultrasound->distance_arr, 0, sizeof(uint32_t) * FSM_ULTRASOUND_NUM_MEASUREMENTS);
@@ -270,15 +283,19 @@ void fsm_ultrasound_init(fsm_ultrasound_t *p_fsm_ultrasound, uint32_t ultrasound
         p_fsm_ultrasound->distance_arr[i] = 0;
     }
     port_ultrasound_init(ultrasound_id);
+#ifdef USE_TRACE
+    fsm_trace_register(&p_fsm_ultrasound->f, "fsm_ultrasound", fsm_ultrasound_state_names);
+#endif
+    return p_fsm_ultrasound;
 }
 
-/* Public functions -----------------------------------------------------------*/
+#ifndef USE_NO_HEAP
 fsm_ultrasound_t *fsm_ultrasound_new(uint32_t ultrasound_id)
 {
-    fsm_ultrasound_t *p_fsm_ultrasound = malloc(sizeof(fsm_ultrasound_t)); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
-    fsm_ultrasound_init(p_fsm_ultrasound, ultrasound_id);                  /* Initialize the FSM */
-    return p_fsm_ultrasound;
+    void *p_storage = malloc(FSM_ULTRASOUND_SIZE);           /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
+    return fsm_ultrasound_init(p_storage, ultrasound_id);    /* Initialize the FSM */
 }
+#endif
 
 // Other auxiliary functions
 void fsm_ultrasound_set_state(fsm_ultrasound_t *p_fsm, int8_t state)
@@ -288,13 +305,26 @@ void fsm_ultrasound_set_state(fsm_ultrasound_t *p_fsm, int8_t state)
 
 void fsm_ultrasound_fire(fsm_ultrasound_t *p_fsm)
 {
+#ifdef USE_TRACE
+    fsm_trace_fire(&p_fsm->f);
+#elif defined(USE_FSM_SWITCH)
+    fsm_trans_ultrasound_switch_fire(&p_fsm->f);
+#elif defined(USE_FSM_INDEXED)
+    fsm_indexed_fire(&p_fsm->f, &fsm_index_ultrasound);
+#else
     fsm_fire(&p_fsm->f);
+#endif
 }
 
+#ifndef USE_NO_HEAP
 void fsm_ultrasound_destroy(fsm_ultrasound_t *p_fsm)
 {
+#ifdef USE_TRACE
+    fsm_trace_unregister(&p_fsm->f);
+#endif
     free(&p_fsm->f);
 }
+#endif
 
 fsm_t *fsm_ultrasound_get_inner_fsm(fsm_ultrasound_t *p_fsm)
 {
@@ -323,6 +353,8 @@ void fsm_ultrasound_start(fsm_ultrasound_t *p_fsm)
     p_fsm->status = true; // revisar
     p_fsm->distance_idx = 0;
     p_fsm->distance_cm = 0;
+    p_fsm->provisional_pending = true;
+    BOOT_REPORT_MARK(BOOT_REPORT_ULTRASOUND_START);
     port_ultrasound_reset_echo_ticks(p_fsm->ultrasound_id);
     port_ultrasound_set_trigger_ready(p_fsm->ultrasound_id, true);
     port_ultrasound_start_new_measurement_timer();
@@ -350,5 +382,21 @@ bool fsm_ultrasound_get_new_measurement_ready(fsm_ultrasound_t *p_fsm)
 
 bool fsm_ultrasound_check_activity(fsm_ultrasound_t *p_fsm)
 {
-    return false;
+    /* The guards of the rows of the current state: a start, a stop, or a flag set by the ISRs that the FSM has not handled yet */
+    fsm_t *p_this = &p_fsm->f;
+    switch (p_this->current_state)
+    {
+    case WAIT_START:
+        return check_on(p_this);
+    case TRIGGER_START:
+        return check_trigger_end(p_this);
+    case WAIT_ECHO_START:
+        return check_echo_init(p_this);
+    case WAIT_ECHO_END:
+        return check_echo_received(p_this);
+    case SET_DISTANCE:
+        return check_new_measurement(p_this) || check_off(p_this);
+    default:
+        return false;
+    }
 }
\ No newline at end of file
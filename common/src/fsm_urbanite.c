@@ -8,10 +8,15 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include "port_system.h"
 #include "fsm.h"
 #include "fsm_urbanite.h"
+#include "fsm_trace.h"
+#include "fsm_indexed.h"
+#include "fsm_hierarchical.h"
 #include "port_led.h"
+#include "port_memory.h"
 
 /**
  * @brief Structure of the Urbanite FSM.
@@ -23,22 +28,46 @@ struct fsm_urbanite_t
     fsm_t f; 
     /** @brief Pointer to the button FSM */
     fsm_button_t *p_fsm_button; 
-    /** @brief Time in milliseconds for the button press to turn on/off the system */
-    uint32_t on_off_press_time_ms; 
-    /** @brief Time in milliseconds for the button press to pause/resume the display */
-    uint32_t pause_display_time_ms; 
     /** @brief Flag to indicate if the display is paused */
     bool is_paused; 
+    /** @brief Flag to turn the system ON at the next fire without waiting for the ON/OFF press (`fsm_urbanite_turn_on()`) */
+    bool turn_on_requested;
+    /** @brief Type of the gesture event of the current fire (`button_gesture_type_t`), `BUTTON_GESTURE_NONE` if there is none */
+    uint8_t event;
     /** @brief Pointer to the ultrasound FSM */
     fsm_ultrasound_t *p_fsm_ultrasound_rear;  
     /** @brief Pointer to the display FSM */
     fsm_display_t *p_fsm_display_rear; 
+    /** @brief Gesture recognizer of the button: holding it for the ON/OFF time turns the system on or off, a click pauses or resumes the display */
+    button_gesture_t gesture;
 };
 
+_Static_assert(sizeof(fsm_urbanite_t) <= FSM_URBANITE_SIZE, "FSM_URBANITE_SIZE is smaller than the Urbanite FSM");
+_Static_assert(_Alignof(fsm_urbanite_t) <= FSM_URBANITE_ALIGN, "FSM_URBANITE_ALIGN is smaller than the alignment of the Urbanite FSM");
+
+#ifdef USE_FSM_GUARD_COUNT
+static uint32_t fsm_urbanite_guard_calls = 0; /*!< Input functions of the transitions tables called, for all the Urbanite FSMs (`USE_FSM_GUARD_COUNT`) */
+#define FSM_URBANITE_COUNT_GUARD() (fsm_urbanite_guard_calls++) /*!< Count a call to an input function of the transitions tables */
+#else
+#define FSM_URBANITE_COUNT_GUARD() ((void)0) /*!< The calls to the input functions are only counted by the benchmarks (`USE_FSM_GUARD_COUNT`) */
+#endif
+
 /* STATE MACHINE INPUT FUNCTIONS */
 
 /**
- * @brief Check if the button is pressed for a certain time to turn on the system.
+ * @brief Check if the button has been held long enough to turn the system on or off (held event, while the button is still held).
+ * 
+ * @param urbanite Pointer to the Urbanite FSM.
+ * @return true 
+ * @return false 
+ */
+static bool _check_on_off_press(fsm_urbanite_t *urbanite)
+{
+    return urbanite->event == BUTTON_GESTURE_HELD;
+}
+
+/**
+ * @brief Check if the button is pressed for a certain time to turn on the system, or if the system has been asked to turn on (`fsm_urbanite_turn_on()`).
  * 
  * @param p_this 
  * @return true 
@@ -46,11 +75,9 @@ struct fsm_urbanite_t
  */
 static bool check_on(fsm_t *p_this)
 {
+    FSM_URBANITE_COUNT_GUARD();
     fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    fsm_button_t *state = urbanite->p_fsm_button;
-    uint32_t valor = fsm_button_get_duration(state);
-
-    return (valor > 0 && valor > urbanite->on_off_press_time_ms);
+    return urbanite->turn_on_requested || _check_on_off_press(urbanite);
 }
 
 /**
@@ -62,25 +89,38 @@ static bool check_on(fsm_t *p_this)
  */
 static bool check_off(fsm_t *p_this)
 {
-    return check_on(p_this);
+    FSM_URBANITE_COUNT_GUARD();
+    return _check_on_off_press((fsm_urbanite_t *)p_this);
 }
 
 /**
  * @brief Check if a new measurement is ready from the ultrasound sensor.
  * 
- * @param p_this 
+ * @param urbanite Pointer to the Urbanite FSM.
  * @return true 
  * @return false 
  */
-static bool check_new_measure(fsm_t *p_this)
+static bool _check_new_measure(fsm_urbanite_t *urbanite)
 {
-    fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
     fsm_ultrasound_t *measure = urbanite->p_fsm_ultrasound_rear;
     return fsm_ultrasound_get_new_measurement_ready(measure);
 }
 
 /**
- * @brief Check if the button is pressed for a certain time to pause the display.
+ * @brief Check if a new measurement is ready from the ultrasound sensor.
+ * 
+ * @param p_this 
+ * @return true 
+ * @return false 
+ */
+static bool check_new_measure(fsm_t *p_this)
+{
+    FSM_URBANITE_COUNT_GUARD();
+    return _check_new_measure((fsm_urbanite_t *)p_this);
+}
+
+/**
+ * @brief Check if the button has been clicked to pause the display (click or double click event).
  * 
  * @param p_this 
  * @return true 
@@ -88,17 +128,22 @@ static bool check_new_measure(fsm_t *p_this)
  */
 static bool check_pause_display(fsm_t *p_this)
 {
+    FSM_URBANITE_COUNT_GUARD();
     fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    fsm_button_t *button = urbanite->p_fsm_button;
-    uint32_t valor = fsm_button_get_duration(button);
-    if (valor > 0 && valor < urbanite->on_off_press_time_ms && valor > urbanite->pause_display_time_ms)
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return urbanite->event == BUTTON_GESTURE_CLICK || urbanite->event == BUTTON_GESTURE_DOUBLE_CLICK;
+}
+
+/**
+ * @brief Check if there is activity in the system.
+ * 
+ * @param urbanite Pointer to the Urbanite FSM.
+ * @return true 
+ * @return false 
+ */
+static bool _check_activity(fsm_urbanite_t *urbanite)
+{
+    //printf("[URBANITE][%ld] Urbanite system activity check\n", fsm_button_get_duration(urbanite->p_fsm_button));
+    return (urbanite->turn_on_requested || button_gesture_pending(&urbanite->gesture) || fsm_button_check_activity(urbanite->p_fsm_button) || fsm_display_check_activity(urbanite->p_fsm_display_rear) || fsm_ultrasound_check_activity(urbanite->p_fsm_ultrasound_rear));
 }
 
 /**
@@ -110,9 +155,8 @@ static bool check_pause_display(fsm_t *p_this)
  */
 static bool check_activity(fsm_t *p_this)
 {
-    fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    //printf("[URBANITE][%ld] Urbanite system activity check\n", fsm_button_get_duration(urbanite->p_fsm_button));
-    return (fsm_button_check_activity(urbanite->p_fsm_button) || fsm_display_check_activity(urbanite->p_fsm_display_rear) || fsm_ultrasound_check_activity(urbanite->p_fsm_ultrasound_rear));
+    FSM_URBANITE_COUNT_GUARD();
+    return _check_activity((fsm_urbanite_t *)p_this);
 }
 
 /**
@@ -124,7 +168,8 @@ static bool check_activity(fsm_t *p_this)
  */
 static bool check_no_activity(fsm_t *p_this)
 {
-    return !check_activity(p_this);
+    FSM_URBANITE_COUNT_GUARD();
+    return !_check_activity((fsm_urbanite_t *)p_this);
 }
 
 /**
@@ -136,11 +181,24 @@ static bool check_no_activity(fsm_t *p_this)
  */
 static bool check_activity_in_measure(fsm_t *p_this)
 {
-    return check_new_measure(p_this);
+    FSM_URBANITE_COUNT_GUARD();
+    return _check_new_measure((fsm_urbanite_t *)p_this);
 }
 
 /* STATE MACHINE OUTPUT FUNCTIONS */
 
+/**
+ * @brief Enter the low power mode of the sleep states, until the next interrupt.
+ * 
+ * With the scheduler (`USE_SCHEDULER`) the FSM is fired from a job and does not sleep: the main loop sleeps when no task is released.
+ */
+static void _enter_low_power_mode(void)
+{
+#ifndef USE_SCHEDULER
+    port_system_sleep();
+#endif
+}
+
 /**
  * @brief Turn the Urbanite system ON. 
  * 
@@ -149,15 +207,14 @@ static bool check_activity_in_measure(fsm_t *p_this)
 static void do_start_up_measure(fsm_t *p_this)
 {
     fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    fsm_button_t *button = urbanite->p_fsm_button;
     fsm_ultrasound_t *ultrasound = urbanite->p_fsm_ultrasound_rear;
     fsm_display_t *display = urbanite->p_fsm_display_rear;
 
     port_led_on();
-    fsm_button_reset_duration(button);
+    urbanite->turn_on_requested = false;
     fsm_ultrasound_start(ultrasound);
     fsm_display_set_status(display, true);
-    printf("[URBANITE][%ld] Urbanite system ON\n", port_system_get_millis());
+    printf("[URBANITE][%" PRIu32 "] Urbanite system ON\n", port_system_get_millis());
 }
 
 /**
@@ -168,16 +225,17 @@ static void do_start_up_measure(fsm_t *p_this)
 static void do_stop_urbanite(fsm_t *p_this)
 {
     fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    fsm_button_t *button = urbanite->p_fsm_button;
     fsm_ultrasound_t *ultrasound = urbanite->p_fsm_ultrasound_rear;
     fsm_display_t *display = urbanite->p_fsm_display_rear;
 
     port_led_off();
-    fsm_button_reset_duration(button);
     fsm_ultrasound_stop(ultrasound);
     fsm_display_set_status(display, false);
     urbanite->is_paused = false;
-    printf("[URBANITE][%ld] Urbanite system OFF\n", port_system_get_millis());
+    printf("[URBANITE][%" PRIu32 "] Urbanite system OFF\n", port_system_get_millis());
+#ifdef USE_MEMORY_MONITOR
+    port_memory_print_report();
+#endif
 }
 
 /**
@@ -188,20 +246,18 @@ static void do_stop_urbanite(fsm_t *p_this)
 static void do_pause_display(fsm_t *p_this)
 {
     fsm_urbanite_t *urbanite = ((fsm_urbanite_t *)p_this);
-    fsm_button_t *button = urbanite->p_fsm_button;
     fsm_display_t *display = urbanite->p_fsm_display_rear;
 
-    fsm_button_reset_duration(button);
     urbanite->is_paused = !(urbanite->is_paused);
     fsm_display_set_status(display, !urbanite->is_paused);
     
     if (urbanite->is_paused)
     {
-        printf("[URBANITE][%ld] Urbanite system display PAUSE\n", port_system_get_millis());
+        printf("[URBANITE][%" PRIu32 "] Urbanite system display PAUSE\n", port_system_get_millis());
     }
     else
     {
-        printf("[URBANITE][%ld] Urbanite system display RESUME\n", port_system_get_millis());
+        printf("[URBANITE][%" PRIu32 "] Urbanite system display RESUME\n", port_system_get_millis());
     }
 }
 
@@ -233,7 +289,7 @@ static void do_display_distance(fsm_t *p_this)
     {
         fsm_display_set_distance(display, distance_cm);
     }
-    printf("[URBANITE][%ld] Distance: %ld cm\n", port_system_get_millis(), distance_cm);
+    printf("[URBANITE][%" PRIu32 "] Distance: %" PRIu32 " cm\n", port_system_get_millis(), distance_cm);
 }
 
 /**
@@ -244,7 +300,7 @@ static void do_display_distance(fsm_t *p_this)
 static void do_sleep_off(fsm_t *p_this)
 {
     port_led_off();
-    port_system_sleep();
+    _enter_low_power_mode();
 }
 /**
  * @brief Start the low power mode while the Urbanite is measuring the distance and it is waiting for a new measurement. 
@@ -253,7 +309,7 @@ static void do_sleep_off(fsm_t *p_this)
  */
 static void do_sleep_while_measure(fsm_t *p_this)
 {
-    port_system_sleep();
+    _enter_low_power_mode();
 }
 
 /**
@@ -263,7 +319,7 @@ static void do_sleep_while_measure(fsm_t *p_this)
  */
 static void do_sleep_while_off(fsm_t *p_this)
 {
-    port_system_sleep();
+    _enter_low_power_mode();
 }
 
 /**
@@ -273,19 +329,20 @@ static void do_sleep_while_off(fsm_t *p_this)
  */
 static void do_sleep_while_on(fsm_t *p_this)
 {
-    port_system_sleep();
+    _enter_low_power_mode();
 }
 
 /**
  * @brief Array representing the transitions table of the FSM Urbanite. 
  * 
+ * The rows of the button events of MEASURE come before the row of the new measurement: `fsm_urbanite_fire()` takes one gesture event per fire and drops it if no transition uses it.
  */
-static fsm_trans_t fsm_trans_urbanite[] = {
+static const fsm_trans_t fsm_trans_urbanite[] = {
     {OFF, check_on, MEASURE, do_start_up_measure},
     {OFF, check_no_activity, SLEEP_WHILE_OFF, do_sleep_off}, 
     {MEASURE, check_off, OFF, do_stop_urbanite},
-    {MEASURE, check_new_measure, MEASURE, do_display_distance},
     {MEASURE, check_pause_display, MEASURE, do_pause_display},
+    {MEASURE, check_new_measure, MEASURE, do_display_distance},
     {MEASURE, check_no_activity, SLEEP_WHILE_ON, do_sleep_while_measure},
     {SLEEP_WHILE_ON, check_activity_in_measure, MEASURE, NULL},
     {SLEEP_WHILE_ON, check_no_activity, SLEEP_WHILE_ON, do_sleep_while_on},
@@ -294,52 +351,166 @@ static fsm_trans_t fsm_trans_urbanite[] = {
     { -1, NULL, -1, NULL }
 };
 
+#ifdef USE_FSM_HIERARCHICAL
 /**
- * @brief Create a new Urbanite FSM.
- * 
- * @param p_fsm_urbanite Pointer to the Urbanite FSM. 
- * @param p_fsm_button Pointer to the button FSM that activates the system and disables the display if it disturbs the driver. 
- * @param on_off_press_time_ms Button press time in milliseconds to turn the system ON or OFF 
- * @param pause_display_time_ms Time in milliseconds to pause the display after a short press of the button 
- * @param p_fsm_ultrasound_rear Pointer to the ultrasound FSM that measures the distance to the rear obstacle. 
- * @param p_fsm_display_rear Pointer to the display FSM that shows the distance to the rear obstacle.
+ * @brief Transitions table of the hierarchical Urbanite FSM (`USE_FSM_HIERARCHICAL`), with the rows of every state together.
+ *
+ * SYSTEM_ON turns the system on when it is entered and off when it is exited, whatever its inner state. The rows of MEASURE are in the order of the flat table. The sleep of each composite state is shared by its inner states: the activity is checked once per fire, and its "else" row wakes the system up.
+ */
+static const fsm_trans_t fsm_trans_urbanite_hierarchical[] = {
+    {OFF, check_on, SYSTEM_ON, NULL},
+    {MEASURE, check_off, SYSTEM_OFF, NULL},
+    {MEASURE, check_pause_display, MEASURE, do_pause_display},
+    {MEASURE, check_new_measure, MEASURE, do_display_distance},
+    {SLEEP_WHILE_ON, check_new_measure, MEASURE, NULL},
+    {SYSTEM_ON, check_no_activity, SLEEP_WHILE_ON, do_sleep_while_on},
+    {SYSTEM_OFF, check_no_activity, SLEEP_WHILE_OFF, do_sleep_off},
+    {SYSTEM_OFF, NULL, OFF, NULL},
+    { -1, NULL, -1, NULL }
+};
+
+/**
+ * @brief States of the hierarchical Urbanite FSM: ON{MEASURE, SLEEP_WHILE_ON} and OFF{OFF, SLEEP_WHILE_OFF}.
+ */
+static const fsm_hierarchical_state_t fsm_urbanite_states[] = {
+    [OFF] = {SYSTEM_OFF, FSM_HIERARCHICAL_NONE, NULL, NULL},
+    [MEASURE] = {SYSTEM_ON, FSM_HIERARCHICAL_NONE, NULL, NULL},
+    [SLEEP_WHILE_OFF] = {SYSTEM_OFF, FSM_HIERARCHICAL_NONE, NULL, NULL},
+    [SLEEP_WHILE_ON] = {SYSTEM_ON, FSM_HIERARCHICAL_NONE, NULL, NULL},
+    [SYSTEM_ON] = {FSM_HIERARCHICAL_NONE, MEASURE, do_start_up_measure, do_stop_urbanite},
+    [SYSTEM_OFF] = {FSM_HIERARCHICAL_NONE, OFF, NULL, NULL}};
+
+/**
+ * @brief Rows of the hierarchical transitions table of every state of the Urbanite FSM, built from the table by `fsm_hierarchical_init()`.
+ */
+static fsm_indexed_slot_t fsm_urbanite_slots[FSM_HIERARCHICAL_NUM_STATES(fsm_urbanite_states)];
+
+/**
+ * @brief Hierarchy of the Urbanite FSM.
+ */
+static const fsm_hierarchical_t fsm_hierarchical_urbanite = {fsm_trans_urbanite_hierarchical, fsm_urbanite_states, fsm_urbanite_slots, FSM_HIERARCHICAL_NUM_STATES(fsm_urbanite_states)};
+#elif defined(USE_FSM_INDEXED)
+/**
+ * @brief Rows of the transitions table of every state of the Urbanite FSM, built from the table by `fsm_indexed_init()`.
  */
-static void fsm_urbanite_init(fsm_urbanite_t *p_fsm_urbanite,
-                              fsm_button_t *p_fsm_button,
-                              uint32_t on_off_press_time_ms,
-                              uint32_t pause_display_time_ms,
-                              fsm_ultrasound_t *p_fsm_ultrasound_rear,
-                              fsm_display_t *p_fsm_display_rear)
+static fsm_indexed_slot_t fsm_trans_urbanite_slots[SLEEP_WHILE_ON + 1];
+
+/**
+ * @brief Index of the transitions table of the Urbanite FSM.
+ */
+static const fsm_indexed_t fsm_index_urbanite = {fsm_trans_urbanite_slots, FSM_INDEXED_NUM_STATES(fsm_trans_urbanite_slots)};
+#endif
+
+#ifdef USE_TRACE
+/**
+ * @brief Names of the states of the Urbanite FSM in the trace.
+ */
+static const char *const fsm_urbanite_state_names[] = {
+    [OFF] = "OFF",
+    [MEASURE] = "MEASURE",
+    [SLEEP_WHILE_OFF] = "SLEEP_WHILE_OFF",
+    [SLEEP_WHILE_ON] = "SLEEP_WHILE_ON"};
+#endif
+
+/* Public functions -----------------------------------------------------------*/
+fsm_urbanite_t *fsm_urbanite_init(void *p_storage,
+                                  fsm_button_t *p_fsm_button,
+                                  uint32_t on_off_press_time_ms,
+                                  uint32_t pause_display_time_ms,
+                                  fsm_ultrasound_t *p_fsm_ultrasound_rear,
+                                  fsm_display_t *p_fsm_display_rear)
 {
+    fsm_urbanite_t *p_fsm_urbanite = (fsm_urbanite_t *)p_storage;
+    /* A press shorter than the pause time is ignored; the ON/OFF press acts when it reaches its time, and its release (a long press) is dropped. The Urbanite does not use double clicks or hold-repeat */
+    button_gesture_config_t gesture_config = {
+        .min_click_ms = pause_display_time_ms,
+        .long_press_ms = on_off_press_time_ms,
+        .double_click_ms = 0,
+        .repeat_ms = 0,
+        .held_ms = {on_off_press_time_ms, 0}};
     //encender el led
-    fsm_init(&p_fsm_urbanite->f, fsm_trans_urbanite);
+    fsm_init(&p_fsm_urbanite->f, (fsm_trans_t *)fsm_trans_urbanite); /* The FSM library only reads the table */
+#if defined(USE_FSM_INDEXED) && !defined(USE_FSM_HIERARCHICAL)
+    fsm_indexed_init(fsm_trans_urbanite_slots, FSM_INDEXED_NUM_STATES(fsm_trans_urbanite_slots), fsm_trans_urbanite);
+#elif defined(USE_FSM_HIERARCHICAL)
+    fsm_hierarchical_init(&fsm_hierarchical_urbanite);
+#endif
     p_fsm_urbanite->p_fsm_button = p_fsm_button;
-    p_fsm_urbanite->on_off_press_time_ms = on_off_press_time_ms;
     p_fsm_urbanite->p_fsm_ultrasound_rear = p_fsm_ultrasound_rear;
-    p_fsm_urbanite->pause_display_time_ms = pause_display_time_ms;
     p_fsm_urbanite->p_fsm_display_rear = p_fsm_display_rear;
     p_fsm_urbanite->is_paused = false;
+    p_fsm_urbanite->turn_on_requested = false;
+    p_fsm_urbanite->event = BUTTON_GESTURE_NONE;
+    button_gesture_init(&p_fsm_urbanite->gesture, &gesture_config);
+    fsm_button_set_gesture(p_fsm_button, &p_fsm_urbanite->gesture, 0);
+#ifdef USE_TRACE
+    fsm_trace_register(&p_fsm_urbanite->f, "fsm_urbanite", fsm_urbanite_state_names);
+#endif
+    return p_fsm_urbanite;
 };
 
+#ifndef USE_NO_HEAP
 fsm_urbanite_t *fsm_urbanite_new(fsm_button_t *p_fsm_button,
                                  uint32_t on_off_press_time_ms,
                                  uint32_t pause_display_time_ms,
                                  fsm_ultrasound_t *p_fsm_ultrasound_rear,
                                  fsm_display_t *p_fsm_display_rear)
 {
-    fsm_urbanite_t *p_fsm_urbanite = (fsm_urbanite_t *)malloc(sizeof(fsm_urbanite_t)); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
-    fsm_urbanite_init(p_fsm_urbanite, p_fsm_button, on_off_press_time_ms, pause_display_time_ms, p_fsm_ultrasound_rear, p_fsm_display_rear);
-    return p_fsm_urbanite;
+    void *p_storage = malloc(FSM_URBANITE_SIZE); /* Do malloc to reserve memory of all other FSM elements, although it is interpreted as fsm_t (the first element of the structure) */
+    return fsm_urbanite_init(p_storage, p_fsm_button, on_off_press_time_ms, pause_display_time_ms, p_fsm_ultrasound_rear, p_fsm_display_rear);
 }
+#endif
 
 void fsm_urbanite_fire(fsm_urbanite_t *p_fsm_urbanite)
 {
     //printf("[URBANITE][%ld] Urbanite system state: %d\n", port_system_get_millis(), p_fsm_urbanite->f.current_state);
+    /* The states that handle the button take one gesture event per fire; the sleep states leave it queued to wake up */
+    int state = p_fsm_urbanite->f.current_state;
+    button_gesture_event_t event;
+    if ((state == OFF || state == MEASURE) && button_gesture_pop(&p_fsm_urbanite->gesture, &event))
+    {
+        p_fsm_urbanite->event = event.type;
+    }
+#ifdef USE_TRACE
+    fsm_trace_fire(&p_fsm_urbanite->f);
+#elif defined(USE_FSM_HIERARCHICAL)
+    fsm_hierarchical_fire(&p_fsm_urbanite->f, &fsm_hierarchical_urbanite);
+#elif defined(USE_FSM_INDEXED)
+    fsm_indexed_fire(&p_fsm_urbanite->f, &fsm_index_urbanite);
+#else
     fsm_fire(&p_fsm_urbanite->f);
+#endif
+    p_fsm_urbanite->event = BUTTON_GESTURE_NONE; /* An event that no transition has taken is dropped */
     //printf("[URBANITE][%ld] Urbanite system activity check\n", fsm_button_get_duration(p_fsm_urbanite->p_fsm_button));
 }
 
+void fsm_urbanite_turn_on(fsm_urbanite_t *p_fsm_urbanite)
+{
+    int state = fsm_get_state(&p_fsm_urbanite->f);
+    if (state == OFF || state == SLEEP_WHILE_OFF)
+    {
+        p_fsm_urbanite->turn_on_requested = true;
+    }
+}
+
+bool fsm_urbanite_check_activity(fsm_urbanite_t *p_fsm_urbanite)
+{
+    return p_fsm_urbanite->turn_on_requested || button_gesture_pending(&p_fsm_urbanite->gesture) || _check_new_measure(p_fsm_urbanite);
+}
+
+#ifdef USE_FSM_GUARD_COUNT
+uint32_t fsm_urbanite_get_guard_calls(void)
+{
+    return fsm_urbanite_guard_calls;
+}
+#endif
+
+#ifndef USE_NO_HEAP
 void fsm_urbanite_destroy(fsm_urbanite_t *p_fsm_urbanite)
 {
+#ifdef USE_TRACE
+    fsm_trace_unregister(&p_fsm_urbanite->f);
+#endif
     free(&p_fsm_urbanite->f);
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file scheduler.c
+ * @brief Cooperative scheduler of the FSMs: periodic and event tasks run in the order of their priorities, with deadline tracking.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "scheduler.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Release a job of a task. If the previous job has not run yet, the release is a deadline miss and the job keeps its first release.
+ *
+ * @param p_task Pointer to the task.
+ * @param release_us Time of the release in µs.
+ */
+static void _scheduler_release(scheduler_task_t *p_task, uint64_t release_us)
+{
+    if (p_task->released)
+    {
+        p_task->misses++;
+        return;
+    }
+    p_task->released = true;
+    p_task->release_us = release_us;
+}
+
+/**
+ * @brief Callback of the timer of a periodic task: release a job, unless the check of the task says it has nothing to do. Then the task is parked: its timer is stopped until the check becomes true.
+ *
+ * @param p_arg Pointer to the task.
+ */
+static void _scheduler_timer_callback(void *p_arg)
+{
+    scheduler_task_t *p_task = (scheduler_task_t *)p_arg;
+    if (p_task->config.check != NULL && !p_task->released && !p_task->config.check(p_task->config.p_ctx))
+    {
+        soft_timer_stop(p_task->p_timers, &p_task->timer);
+        return;
+    }
+    /* The timer has moved its deadline to the next period: the release is the last deadline that was due */
+    _scheduler_release(p_task, p_task->timer.deadline_us - p_task->config.period_us);
+}
+
+/**
+ * @brief Release the event tasks and the parked periodic tasks whose checks are true. A parked task restarts its period from its release.
+ *
+ * @param p_scheduler Pointer to the scheduler.
+ * @param now_us Current time in µs.
+ */
+static void _scheduler_poll_events(scheduler_t *p_scheduler, uint64_t now_us)
+{
+    for (uint32_t i = 0; i < p_scheduler->count; i++)
+    {
+        scheduler_task_t *p_task = p_scheduler->p_tasks[i];
+        bool parked = p_task->config.period_us != 0 && !soft_timer_is_running(&p_task->timer);
+        if ((p_task->config.period_us == 0 || parked) && !p_task->released && p_task->config.check(p_task->config.p_ctx))
+        {
+            _scheduler_release(p_task, now_us);
+            if (parked)
+            {
+                soft_timer_start(p_scheduler->p_timers, &p_task->timer, now_us + p_task->config.period_us, p_task->config.period_us);
+            }
+        }
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+void scheduler_init(scheduler_t *p_scheduler, scheduler_task_t **p_tasks, uint32_t capacity, soft_timer_service_t *p_timers)
+{
+    p_scheduler->p_tasks = p_tasks;
+    p_scheduler->capacity = capacity;
+    p_scheduler->count = 0;
+    p_scheduler->p_timers = p_timers;
+    p_scheduler->steps = 0;
+}
+
+void scheduler_task_init(scheduler_task_t *p_task, const scheduler_task_config_t *p_config)
+{
+    p_task->config = *p_config;
+    soft_timer_init(&p_task->timer, _scheduler_timer_callback, p_task);
+    p_task->p_timers = NULL;
+    p_task->release_us = 0;
+    p_task->released = false;
+    p_task->last_step = 0;
+    p_task->runs = 0;
+    p_task->misses = 0;
+    p_task->max_response_us = 0;
+}
+
+bool scheduler_add_task(scheduler_t *p_scheduler, scheduler_task_t *p_task, uint64_t first_release_us)
+{
+    if (p_scheduler->count == p_scheduler->capacity || (p_task->config.period_us == 0 && p_task->config.check == NULL))
+    {
+        return false;
+    }
+    p_task->p_timers = p_scheduler->p_timers;
+    if (p_task->config.period_us != 0 && !soft_timer_start(p_scheduler->p_timers, &p_task->timer, first_release_us, p_task->config.period_us))
+    {
+        return false;
+    }
+    /* Insertion in the order of the priorities, after the tasks of the same priority */
+    uint32_t i = p_scheduler->count;
+    while (i > 0 && p_scheduler->p_tasks[i - 1U]->config.priority > p_task->config.priority)
+    {
+        p_scheduler->p_tasks[i] = p_scheduler->p_tasks[i - 1U];
+        i--;
+    }
+    p_scheduler->p_tasks[i] = p_task;
+    p_scheduler->count++;
+    return true;
+}
+
+uint32_t scheduler_step(scheduler_t *p_scheduler)
+{
+    uint32_t jobs = 0;
+    uint64_t now_us = port_system_get_micros64();
+    uint32_t step = ++p_scheduler->steps;
+    _scheduler_poll_events(p_scheduler, now_us); /* Once per step: an event task whose check stays true runs once per step, not forever */
+    for (;;)
+    {
+        soft_timer_dispatch(p_scheduler->p_timers, now_us);
+        scheduler_task_t *p_task = NULL;
+        for (uint32_t i = 0; i < p_scheduler->count; i++)
+        {
+            /* At most one job per task and step: an overloaded task cannot keep the step from returning */
+            if (p_scheduler->p_tasks[i]->released && p_scheduler->p_tasks[i]->last_step != step)
+            {
+                p_task = p_scheduler->p_tasks[i];
+                break;
+            }
+        }
+        if (p_task == NULL)
+        {
+            return jobs;
+        }
+
+        p_task->released = false;
+        p_task->last_step = step;
+        p_task->config.fire(p_task->config.p_ctx);
+        now_us = port_system_get_micros64();
+        uint64_t response_us = now_us - p_task->release_us;
+        if (response_us > p_task->config.deadline_us)
+        {
+            p_task->misses++;
+        }
+        if (response_us > p_task->max_response_us)
+        {
+            p_task->max_response_us = (response_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)response_us;
+        }
+        p_task->runs++;
+        jobs++;
+    }
+}
+
+uint32_t scheduler_task_get_runs(const scheduler_task_t *p_task)
+{
+    return p_task->runs;
+}
+
+uint32_t scheduler_task_get_misses(const scheduler_task_t *p_task)
+{
+    return p_task->misses;
+}
+
+uint32_t scheduler_task_get_max_response_us(const scheduler_task_t *p_task)
+{
+    return p_task->max_response_us;
+}
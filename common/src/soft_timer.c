@@ -0,0 +1,234 @@
+/**
+ * @file soft_timer.c
+ * @brief Software timers: one-shot and periodic deadlines multiplexed onto the alarm of the system with a binary min-heap.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "soft_timer.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Put a timer at a position of the heap and record the position in the timer.
+ *
+ * @param p_service Pointer to the service.
+ * @param index Position in the heap.
+ * @param p_timer Pointer to the timer.
+ */
+static inline void _soft_timer_place(soft_timer_service_t *p_service, uint32_t index, soft_timer_t *p_timer)
+{
+    p_service->p_heap[index] = p_timer;
+    p_timer->index = index;
+}
+
+/**
+ * @brief Move a timer up the heap until its parent is not later than it.
+ *
+ * @param p_service Pointer to the service.
+ * @param index Position of the timer.
+ */
+static void _soft_timer_sift_up(soft_timer_service_t *p_service, uint32_t index)
+{
+    soft_timer_t **p_heap = p_service->p_heap;
+    soft_timer_t *p_timer = p_heap[index];
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1U) / 2U;
+        if (p_heap[parent]->deadline_us <= p_timer->deadline_us)
+        {
+            break;
+        }
+        _soft_timer_place(p_service, index, p_heap[parent]);
+        index = parent;
+    }
+    _soft_timer_place(p_service, index, p_timer);
+}
+
+/**
+ * @brief Move a timer down the heap until none of its children is earlier than it.
+ *
+ * @param p_service Pointer to the service.
+ * @param index Position of the timer.
+ */
+static void _soft_timer_sift_down(soft_timer_service_t *p_service, uint32_t index)
+{
+    soft_timer_t **p_heap = p_service->p_heap;
+    soft_timer_t *p_timer = p_heap[index];
+    uint32_t count = p_service->count;
+    for (;;)
+    {
+        uint32_t child = 2U * index + 1U;
+        if (child >= count)
+        {
+            break;
+        }
+        if (child + 1U < count && p_heap[child + 1U]->deadline_us < p_heap[child]->deadline_us)
+        {
+            child++;
+        }
+        if (p_timer->deadline_us <= p_heap[child]->deadline_us)
+        {
+            break;
+        }
+        _soft_timer_place(p_service, index, p_heap[child]);
+        index = child;
+    }
+    _soft_timer_place(p_service, index, p_timer);
+}
+
+/**
+ * @brief Restore the order of the heap around a timer whose deadline has changed.
+ *
+ * @param p_service Pointer to the service.
+ * @param index Position of the timer.
+ */
+static void _soft_timer_fix(soft_timer_service_t *p_service, uint32_t index)
+{
+    if (index > 0 && p_service->p_heap[(index - 1U) / 2U]->deadline_us > p_service->p_heap[index]->deadline_us)
+    {
+        _soft_timer_sift_up(p_service, index);
+    }
+    else
+    {
+        _soft_timer_sift_down(p_service, index);
+    }
+}
+
+/**
+ * @brief Remove a running timer from the heap.
+ *
+ * @param p_service Pointer to the service.
+ * @param p_timer Pointer to the timer.
+ */
+static void _soft_timer_remove(soft_timer_service_t *p_service, soft_timer_t *p_timer)
+{
+    uint32_t index = p_timer->index;
+    p_timer->index = SOFT_TIMER_STOPPED;
+    p_service->count--;
+    if (index == p_service->count)
+    {
+        return; /* It was the last one of the array */
+    }
+    _soft_timer_place(p_service, index, p_service->p_heap[p_service->count]);
+    _soft_timer_fix(p_service, index);
+}
+
+/**
+ * @brief Arm the alarm of the system for the earliest deadline, if it has changed.
+ *
+ * @param p_service Pointer to the service.
+ */
+static void _soft_timer_update_alarm(soft_timer_service_t *p_service)
+{
+    uint64_t next_us = soft_timer_get_next_deadline(p_service);
+    if (next_us == p_service->alarm_us)
+    {
+        return;
+    }
+    p_service->alarm_us = next_us;
+    if (next_us == SOFT_TIMER_NEVER)
+    {
+        port_system_alarm_stop();
+    }
+    else
+    {
+        port_system_alarm_start(next_us);
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+void soft_timer_service_init(soft_timer_service_t *p_service, soft_timer_t **p_heap, uint32_t capacity)
+{
+    p_service->p_heap = p_heap;
+    p_service->capacity = capacity;
+    p_service->count = 0;
+    p_service->alarm_us = SOFT_TIMER_NEVER;
+    port_system_alarm_stop();
+}
+
+void soft_timer_init(soft_timer_t *p_timer, soft_timer_callback_t callback, void *p_arg)
+{
+    p_timer->deadline_us = SOFT_TIMER_NEVER;
+    p_timer->period_us = 0;
+    p_timer->index = SOFT_TIMER_STOPPED;
+    p_timer->callback = callback;
+    p_timer->p_arg = p_arg;
+}
+
+bool soft_timer_start(soft_timer_service_t *p_service, soft_timer_t *p_timer, uint64_t deadline_us, uint32_t period_us)
+{
+    p_timer->deadline_us = deadline_us;
+    p_timer->period_us = period_us;
+    if (p_timer->index != SOFT_TIMER_STOPPED)
+    {
+        _soft_timer_fix(p_service, p_timer->index);
+    }
+    else
+    {
+        if (p_service->count == p_service->capacity)
+        {
+            return false;
+        }
+        p_service->count++;
+        _soft_timer_place(p_service, p_service->count - 1U, p_timer);
+        _soft_timer_sift_up(p_service, p_timer->index);
+    }
+    _soft_timer_update_alarm(p_service);
+    return true;
+}
+
+void soft_timer_stop(soft_timer_service_t *p_service, soft_timer_t *p_timer)
+{
+    if (p_timer->index == SOFT_TIMER_STOPPED)
+    {
+        return;
+    }
+    _soft_timer_remove(p_service, p_timer);
+    _soft_timer_update_alarm(p_service);
+}
+
+bool soft_timer_is_running(const soft_timer_t *p_timer)
+{
+    return p_timer->index != SOFT_TIMER_STOPPED;
+}
+
+uint32_t soft_timer_dispatch(soft_timer_service_t *p_service, uint64_t now_us)
+{
+    uint32_t fired = 0;
+    while (p_service->count > 0 && p_service->p_heap[0]->deadline_us <= now_us)
+    {
+        soft_timer_t *p_timer = p_service->p_heap[0];
+        if (p_timer->period_us != 0)
+        {
+            /* Keep it in the heap before the callback, which may stop it. The next deadline is after now: the missed expiries are skipped */
+            p_timer->deadline_us += p_timer->period_us;
+            if (p_timer->deadline_us <= now_us)
+            {
+                p_timer->deadline_us += ((now_us - p_timer->deadline_us) / p_timer->period_us + 1U) * p_timer->period_us;
+            }
+            _soft_timer_sift_down(p_service, 0);
+        }
+        else
+        {
+            _soft_timer_remove(p_service, p_timer);
+        }
+        fired++;
+        p_timer->callback(p_timer->p_arg);
+    }
+    _soft_timer_update_alarm(p_service);
+    return fired;
+}
+
+uint64_t soft_timer_get_next_deadline(const soft_timer_service_t *p_service)
+{
+    return (p_service->count > 0) ? p_service->p_heap[0]->deadline_us : SOFT_TIMER_NEVER;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file ultrasound_coroutine.c
+ * @brief Measurement sequence of an ultrasound sensor as a coroutine.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* HW dependent includes */
+#include "port_ultrasound.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "ultrasound_coroutine.h"
+#include "ultrasound_distance.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Compute the distance of the echo received, store it, and publish the distance given by `ultrasound_distance_add()`, as `fsm_ultrasound.c`.
+ *
+ * @param p_uc Pointer to the coroutine.
+ */
+static void _ultrasound_coroutine_set_distance(ultrasound_coroutine_t *p_uc)
+{
+    uint32_t distance = ultrasound_distance_get_echo_cm(p_uc->ultrasound_id);
+    if (ultrasound_distance_add(p_uc->distance_arr, &p_uc->distance_idx, &p_uc->provisional_pending, distance, &p_uc->distance_cm))
+    {
+        p_uc->new_measurement = true;
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+void ultrasound_coroutine_init(ultrasound_coroutine_t *p_uc, uint32_t ultrasound_id)
+{
+    coroutine_init(&p_uc->co);
+    p_uc->ultrasound_id = ultrasound_id;
+    p_uc->distance_cm = 0;
+    for (uint32_t i = 0; i < FSM_ULTRASOUND_NUM_MEASUREMENTS; i++)
+    {
+        p_uc->distance_arr[i] = 0;
+    }
+    p_uc->echo_deadline_us = 0;
+    p_uc->timeouts = 0;
+    p_uc->distance_idx = 0;
+    p_uc->status = false;
+    p_uc->new_measurement = false;
+    p_uc->provisional_pending = false;
+    port_ultrasound_init(ultrasound_id);
+}
+
+coroutine_status_t ultrasound_coroutine_run(ultrasound_coroutine_t *p_uc)
+{
+    COROUTINE_BEGIN(&p_uc->co);
+    for (;;)
+    {
+        /* The new measurement timer sets the trigger ready every PORT_PARKING_SENSOR_TIMEOUT_MS */
+        COROUTINE_WAIT_UNTIL(&p_uc->co, p_uc->status && port_ultrasound_get_trigger_ready(p_uc->ultrasound_id));
+        port_ultrasound_start_measurement(p_uc->ultrasound_id);
+        p_uc->echo_deadline_us = port_system_get_micros64() + ULTRASOUND_COROUTINE_ECHO_TIMEOUT_US;
+
+        COROUTINE_WAIT_UNTIL(&p_uc->co, port_ultrasound_get_trigger_end(p_uc->ultrasound_id));
+        port_ultrasound_stop_trigger_timer(p_uc->ultrasound_id);
+        port_ultrasound_set_trigger_end(p_uc->ultrasound_id, false);
+
+        /* The echo is received when its falling edge is captured: its rising edge has been captured before */
+        COROUTINE_WAIT_UNTIL(&p_uc->co, port_ultrasound_get_echo_received(p_uc->ultrasound_id) || port_system_get_micros64() >= p_uc->echo_deadline_us);
+        if (port_ultrasound_get_echo_received(p_uc->ultrasound_id))
+        {
+            _ultrasound_coroutine_set_distance(p_uc);
+        }
+        else
+        {
+            p_uc->timeouts++;
+        }
+        port_ultrasound_stop_echo_timer(p_uc->ultrasound_id);
+        port_ultrasound_reset_echo_ticks(p_uc->ultrasound_id);
+    }
+    COROUTINE_END(&p_uc->co);
+}
+
+void ultrasound_coroutine_start(ultrasound_coroutine_t *p_uc)
+{
+    p_uc->status = true;
+    p_uc->distance_idx = 0;
+    p_uc->distance_cm = 0;
+    p_uc->provisional_pending = true;
+    port_ultrasound_reset_echo_ticks(p_uc->ultrasound_id);
+    port_ultrasound_set_trigger_ready(p_uc->ultrasound_id, true);
+    port_ultrasound_start_new_measurement_timer();
+}
+
+void ultrasound_coroutine_stop(ultrasound_coroutine_t *p_uc)
+{
+    p_uc->status = false;
+    port_ultrasound_stop_ultrasound(p_uc->ultrasound_id);
+    coroutine_init(&p_uc->co);
+}
+
+uint32_t ultrasound_coroutine_get_distance(ultrasound_coroutine_t *p_uc)
+{
+    p_uc->new_measurement = false;
+    return p_uc->distance_cm;
+}
+
+bool ultrasound_coroutine_get_new_measurement_ready(const ultrasound_coroutine_t *p_uc)
+{
+    return p_uc->new_measurement;
+}
+
+uint32_t ultrasound_coroutine_get_timeouts(const ultrasound_coroutine_t *p_uc)
+{
+    return p_uc->timeouts;
+}
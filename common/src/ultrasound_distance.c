@@ -0,0 +1,77 @@
+/**
+ * @file ultrasound_distance.c
+ * @brief Distance of an echo and median filter of the ultrasound sensors.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdlib.h>
+
+/* HW dependent includes */
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm_ultrasound.h"
+#include "ultrasound_distance.h"
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Comparison function for qsort.
+ *
+ * @param a Pointer to the first distance.
+ * @param b Pointer to the second distance.
+ * @return int Negative, zero or positive as the first distance is smaller, equal or larger.
+ */
+static int _ultrasound_distance_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Public functions -----------------------------------------------------------*/
+uint32_t ultrasound_distance_get_echo_cm(uint32_t ultrasound_id)
+{
+    uint32_t init = port_ultrasound_get_echo_init_tick(ultrasound_id);
+    uint32_t echo_end = port_ultrasound_get_echo_end_tick(ultrasound_id);
+    uint32_t overflows = port_ultrasound_get_echo_overflows(ultrasound_id);
+
+    /* Every overflow adds a period of the timer; the unsigned difference is right when the end tick is below the init tick */
+    uint32_t t = overflows * PORT_ULTRASOUND_ECHO_TIMER_PERIOD_TICKS + echo_end - init;
+    return t * SPEED_OF_SOUND_MS / 2 / 10000;
+}
+
+uint32_t ultrasound_distance_median(uint32_t *p_distances, uint32_t num_distances)
+{
+    qsort(p_distances, num_distances, sizeof(uint32_t), _ultrasound_distance_compare);
+    if (num_distances % 2 == 0)
+    {
+        return (p_distances[num_distances / 2 - 1] + p_distances[num_distances / 2]) / 2;
+    }
+    return p_distances[num_distances / 2];
+}
+
+bool ultrasound_distance_add(uint32_t *p_distances, uint8_t *p_idx, bool *p_provisional_pending, uint32_t distance_cm, uint32_t *p_distance_cm)
+{
+    bool publish = false;
+    p_distances[*p_idx] = distance_cm;
+#ifdef USE_FAST_START
+    if (*p_provisional_pending)
+    {
+        /* Publish the first echo at once; the median replaces it when the array is full */
+        *p_provisional_pending = false;
+        *p_distance_cm = distance_cm;
+        publish = true;
+    }
+#endif
+    if (*p_idx >= FSM_ULTRASOUND_NUM_MEASUREMENTS - 1)
+    {
+        *p_distance_cm = ultrasound_distance_median(p_distances, FSM_ULTRASOUND_NUM_MEASUREMENTS);
+        publish = true;
+    }
+    *p_idx = (*p_idx + 1) % FSM_ULTRASOUND_NUM_MEASUREMENTS;
+    return publish;
+}
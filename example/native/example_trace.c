@@ -0,0 +1,133 @@
+/**
+ * @file example_trace.c
+ * @brief Example that streams a Chrome/Perfetto trace of the Urbanite FSMs from the native simulator.
+ *
+ * The main loop of `main.c` is run against a repeated scenario: the system is turned on with a long press, the obstacle gets closer, the display is paused and resumed with short presses (while the Urbanite FSM sleeps in `SLEEP_WHILE_ON`) and the system is turned off.
+ *
+ * Usage: `example_trace [<trace file> [<simulated ms> [systick]]]`. Open the trace file with https://ui.perfetto.dev or `chrome://tracing`.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C libraries */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* HW libraries */
+#include "port_system.h"
+#include "port_button.h"
+#include "port_ultrasound.h"
+#include "port_display.h"
+#include "native_system.h"
+#include "native_button.h"
+#include "native_ultrasound.h"
+#include "native_trace.h"
+#include "fsm_button.h"
+#include "fsm_ultrasound.h"
+#include "fsm_display.h"
+#include "fsm_urbanite.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define URBANITE_ON_OFF_PRESS_TIME_MS 1000 /*!< Time in ms to press the button to turn on/off the system */
+#define URBANITE_PAUSE_DISPLAY_TIME_MS 500 /*!< Time in ms to pause the display system */
+#define EXAMPLE_TRACE_DEFAULT_FILE "urbanite_trace.json" /*!< Default trace file */
+#define EXAMPLE_TRACE_DEFAULT_MS 24000                   /*!< Default simulated time in ms (two scenarios) */
+#define EXAMPLE_TRACE_SCENARIO_MS 12000                  /*!< Duration in ms of the scenario, which is repeated */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Stimulus of the scenario.
+ */
+typedef struct
+{
+    uint32_t time_ms;     /*!< Time in ms since the start of the scenario */
+    bool button_pressed;  /*!< State of the button from this time on */
+    uint32_t distance_cm; /*!< Distance to the obstacle from this time on */
+} example_trace_stimulus_t;
+
+/* Global variables ------------------------------------------------------------*/
+/** @brief Stimuli of the scenario, sorted by time. */
+static const example_trace_stimulus_t scenario[] = {
+    {200, true, 180},   /* Long press to turn the system on */
+    {1400, false, 180},
+    {3000, false, 60},
+    {4500, false, 20},
+    {5000, true, 20},   /* Short press to pause the display */
+    {5600, false, 20},
+    {7000, true, 20},   /* Short press to resume the display */
+    {7600, false, 120},
+    {9000, true, 120},  /* Long press to turn the system off */
+    {10200, false, 120}};
+
+/** 
+ * @brief  The application entry point.
+ * @param argc Number of arguments.
+ * @param argv Arguments: trace file, simulated time in ms and `systick` to also trace the SysTick ISR.
+ * @retval int
+ */
+int main(int argc, char *argv[])
+{
+    const char *p_path = (argc > 1) ? argv[1] : EXAMPLE_TRACE_DEFAULT_FILE;
+    uint64_t duration_ms = (argc > 2) ? strtoull(argv[2], NULL, 10) : EXAMPLE_TRACE_DEFAULT_MS;
+    bool trace_systick = (argc > 3) && (strcmp(argv[3], "systick") == 0);
+
+    /* The trace is opened before the FSMs are created so that their initial states are recorded */
+    if (!native_trace_open(p_path, trace_systick))
+    {
+        fprintf(stderr, "Cannot open the trace file %s\n", p_path);
+        return 1;
+    }
+
+    /* Init board */
+    port_system_init();
+
+    /* Create state machines */
+    fsm_button_t *p_fsm_button = fsm_button_new(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    fsm_ultrasound_t *p_fsm_ultrasound_rear = fsm_ultrasound_new(PORT_REAR_PARKING_SENSOR_ID);
+    fsm_display_t *p_fsm_display_rear = fsm_display_new(PORT_REAR_PARKING_DISPLAY_ID);
+    fsm_urbanite_t *p_fsm_urbanite = fsm_urbanite_new(p_fsm_button, URBANITE_ON_OFF_PRESS_TIME_MS, URBANITE_PAUSE_DISPLAY_TIME_MS, p_fsm_ultrasound_rear, p_fsm_display_rear);
+
+    uint64_t scenario_start_ms = 0;
+    uint32_t next_stimulus = 0;
+    while (native_system_get_time_ms() < duration_ms)
+    {
+        /* Apply the stimuli whose time has come */
+        uint64_t now_ms = native_system_get_time_ms();
+        while (scenario_start_ms + scenario[next_stimulus].time_ms <= now_ms)
+        {
+            native_button_set_value(PORT_PARKING_BUTTON_ID, !scenario[next_stimulus].button_pressed);
+            native_ultrasound_set_distance_cm(PORT_REAR_PARKING_SENSOR_ID, scenario[next_stimulus].distance_cm);
+            if (++next_stimulus == sizeof(scenario) / sizeof(scenario[0]))
+            {
+                next_stimulus = 0;
+                scenario_start_ms += EXAMPLE_TRACE_SCENARIO_MS;
+            }
+        }
+
+        /* Main loop of the Urbanite. One iteration takes 1 ms of simulated time, unless the system sleeps. */
+        fsm_button_fire(p_fsm_button);
+        fsm_ultrasound_fire(p_fsm_ultrasound_rear);
+        fsm_display_fire(p_fsm_display_rear);
+        fsm_urbanite_fire(p_fsm_urbanite);
+        if (native_system_get_time_ms() == now_ms)
+        {
+            native_system_advance_ms(1);
+        }
+    }
+
+    /* Free memory */
+    fsm_button_destroy(p_fsm_button);
+    fsm_ultrasound_destroy(p_fsm_ultrasound_rear);
+    fsm_display_destroy(p_fsm_display_rear);
+    fsm_urbanite_destroy(p_fsm_urbanite);
+    native_trace_close();
+
+    printf("Trace of %" PRIu64 " ms written to %s\n", duration_ms, p_path);
+    return 0;
+}
@@ -22,35 +22,192 @@
 #include "fsm_ultrasound.h"
 #include "fsm_display.h"
 #include "fsm_urbanite.h"
+#include "boot_report.h"
+#ifdef USE_SCHEDULER
+#include "scheduler.h"
+#endif
 
 /* Defines ------------------------------------------------------------------*/
 #define URBANITE_ON_OFF_PRESS_TIME_MS 1000 /*!< Time in ms to press the button to turn on/off the system */
 #define URBANITE_PAUSE_DISPLAY_TIME_MS 500 /*!< Time in ms to pause the display system */
 
+#ifdef USE_SCHEDULER
+/* Tasks of the scheduler: period and deadline in µs (period 0: event task, released by its check) and priority (0: highest). The ultrasound path comes first */
+#define SCHEDULER_NUM_TASKS 4                  /*!< Tasks of the scheduler, one per FSM */
+#define SCHEDULER_ULTRASOUND_PERIOD_US 0       /*!< The ultrasound FSM handles the flags of the trigger and echo ISRs: it runs at the first step after them */
+#define SCHEDULER_ULTRASOUND_DEADLINE_US 1000  /*!< 1 ms bounds the response of the ultrasound FSM to its ISRs */
+#define SCHEDULER_ULTRASOUND_PRIORITY 0        /*!< Priority of the ultrasound FSM */
+#define SCHEDULER_URBANITE_PERIOD_US 5000      /*!< The Urbanite FSM moves the distances from the ultrasound to the display, and is parked while it has no input */
+#define SCHEDULER_URBANITE_PRIORITY 1          /*!< Priority of the Urbanite FSM */
+#define SCHEDULER_DISPLAY_PERIOD_US 0          /*!< The display FSM runs at the first step after a new distance or status from the Urbanite FSM */
+#define SCHEDULER_DISPLAY_DEADLINE_US 20000    /*!< 50 Hz are enough for the display */
+#define SCHEDULER_DISPLAY_PRIORITY 2           /*!< Priority of the display FSM */
+#define SCHEDULER_BUTTON_PERIOD_US 10000       /*!< The button FSM only runs while the button is pressed or debounced, and is parked otherwise */
+#define SCHEDULER_BUTTON_PRIORITY 3            /*!< Priority of the button FSM */
+#endif
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t fsm_button_storage;               /*!< Storage of the button FSM */
+static fsm_ultrasound_storage_t fsm_ultrasound_rear_storage;  /*!< Storage of the rear ultrasound FSM */
+static fsm_display_storage_t fsm_display_rear_storage;        /*!< Storage of the rear display FSM */
+static fsm_urbanite_storage_t fsm_urbanite_storage;           /*!< Storage of the Urbanite FSM */
+#ifdef USE_SCHEDULER
+static soft_timer_service_t scheduler_timers;                 /*!< Software timers of the releases of the tasks */
+static soft_timer_t *scheduler_timers_heap[SCHEDULER_NUM_TASKS]; /*!< Array of the heap of the software timers */
+static scheduler_t scheduler;                                 /*!< Scheduler of the FSMs */
+static scheduler_task_t *scheduler_tasks[SCHEDULER_NUM_TASKS]; /*!< Tasks of the scheduler, in the order of their priorities */
+static scheduler_task_t task_ultrasound;                      /*!< Task of the rear ultrasound FSM */
+static scheduler_task_t task_urbanite;                        /*!< Task of the Urbanite FSM */
+static scheduler_task_t task_display;                         /*!< Task of the rear display FSM */
+static scheduler_task_t task_button;                          /*!< Task of the button FSM */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Fire the ultrasound FSM (job of its task).
+ */
+static void _fire_ultrasound(void *p_ctx)
+{
+    fsm_ultrasound_fire((fsm_ultrasound_t *)p_ctx);
+}
+
+/**
+ * @brief Fire the Urbanite FSM (job of its task).
+ */
+static void _fire_urbanite(void *p_ctx)
+{
+    fsm_urbanite_fire((fsm_urbanite_t *)p_ctx);
+}
+
+/**
+ * @brief Fire the display FSM (job of its task).
+ */
+static void _fire_display(void *p_ctx)
+{
+    fsm_display_fire((fsm_display_t *)p_ctx);
+}
+
+/**
+ * @brief Fire the button FSM (job of its task).
+ */
+static void _fire_button(void *p_ctx)
+{
+    fsm_button_fire((fsm_button_t *)p_ctx);
+}
+
+/**
+ * @brief Check whether the ultrasound FSM has work to do: a start or a stop, or a flag of its ISRs.
+ */
+static bool _check_ultrasound(void *p_ctx)
+{
+    return fsm_ultrasound_check_activity((fsm_ultrasound_t *)p_ctx);
+}
+
+/**
+ * @brief Check whether the Urbanite FSM has an input to handle: a gesture event, a new measurement or a request to turn on.
+ */
+static bool _check_urbanite(void *p_ctx)
+{
+    return fsm_urbanite_check_activity((fsm_urbanite_t *)p_ctx);
+}
+
+/**
+ * @brief Check whether the display FSM has work to do: turn on, a new color or turn off.
+ */
+static bool _check_display(void *p_ctx)
+{
+    return fsm_display_check_activity((fsm_display_t *)p_ctx);
+}
+
+/**
+ * @brief Check whether the button FSM has work to do: a press posted by the ISR, or a press or debounce in progress.
+ */
+static bool _check_button(void *p_ctx)
+{
+    return port_button_get_pressed(PORT_PARKING_BUTTON_ID) || fsm_button_check_activity((fsm_button_t *)p_ctx);
+}
+
+/**
+ * @brief Add the FSMs to the scheduler, each one with its rate and priority, released from now on.
+ */
+static void _scheduler_setup(fsm_ultrasound_t *p_fsm_ultrasound, fsm_urbanite_t *p_fsm_urbanite, fsm_display_t *p_fsm_display, fsm_button_t *p_fsm_button)
+{
+    const scheduler_task_config_t configs[SCHEDULER_NUM_TASKS] = {
+        {_fire_ultrasound, _check_ultrasound, p_fsm_ultrasound, SCHEDULER_ULTRASOUND_PERIOD_US, SCHEDULER_ULTRASOUND_DEADLINE_US, SCHEDULER_ULTRASOUND_PRIORITY},
+        {_fire_urbanite, _check_urbanite, p_fsm_urbanite, SCHEDULER_URBANITE_PERIOD_US, SCHEDULER_URBANITE_PERIOD_US, SCHEDULER_URBANITE_PRIORITY},
+        {_fire_display, _check_display, p_fsm_display, SCHEDULER_DISPLAY_PERIOD_US, SCHEDULER_DISPLAY_DEADLINE_US, SCHEDULER_DISPLAY_PRIORITY},
+        {_fire_button, _check_button, p_fsm_button, SCHEDULER_BUTTON_PERIOD_US, SCHEDULER_BUTTON_PERIOD_US, SCHEDULER_BUTTON_PRIORITY},
+    };
+    scheduler_task_t *p_tasks[SCHEDULER_NUM_TASKS] = {&task_ultrasound, &task_urbanite, &task_display, &task_button};
+
+    soft_timer_service_init(&scheduler_timers, scheduler_timers_heap, SCHEDULER_NUM_TASKS);
+    scheduler_init(&scheduler, scheduler_tasks, SCHEDULER_NUM_TASKS, &scheduler_timers);
+    uint64_t now_us = port_system_get_micros64();
+    for (uint32_t i = 0; i < SCHEDULER_NUM_TASKS; i++)
+    {
+        scheduler_task_init(p_tasks[i], &configs[i]);
+        scheduler_add_task(&scheduler, p_tasks[i], now_us);
+    }
+}
+#endif
+
 /** 
  * @brief  The application entry point.
  * @retval int
  */
 int main(void)
 {
+    BOOT_REPORT_START();
+
     /* Init board */
     port_system_init();
+    BOOT_REPORT_MARK(BOOT_REPORT_SYSTEM_INIT);
+#ifndef USE_FAST_START
     port_led_gpio_setup();
     port_led_on();
+    BOOT_REPORT_MARK(BOOT_REPORT_LED_SETUP);
+#endif
 
-    /* Create state machines */
-    fsm_button_t* p_fsm_button = fsm_button_new(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
-    fsm_ultrasound_t* p_fsm_ultrasound_rear = fsm_ultrasound_new( PORT_REAR_PARKING_SENSOR_ID);
-    fsm_display_t* p_fsm_display_rear = fsm_display_new( PORT_REAR_PARKING_DISPLAY_ID);
+    /* Create state machines (static storage, no heap), measurement chain first */
+    fsm_ultrasound_t* p_fsm_ultrasound_rear = fsm_ultrasound_init(&fsm_ultrasound_rear_storage, PORT_REAR_PARKING_SENSOR_ID);
+    BOOT_REPORT_MARK(BOOT_REPORT_FSM_ULTRASOUND_INIT);
+    fsm_display_t* p_fsm_display_rear = fsm_display_init(&fsm_display_rear_storage, PORT_REAR_PARKING_DISPLAY_ID);
+    BOOT_REPORT_MARK(BOOT_REPORT_FSM_DISPLAY_INIT);
+    fsm_button_t* p_fsm_button = fsm_button_init(&fsm_button_storage, PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS, PORT_PARKING_BUTTON_ID);
+    BOOT_REPORT_MARK(BOOT_REPORT_FSM_BUTTON_INIT);
 
-    fsm_urbanite_t *p_fsm_urbanite = fsm_urbanite_new(
+    fsm_urbanite_t *p_fsm_urbanite = fsm_urbanite_init(
+        &fsm_urbanite_storage,
         p_fsm_button,
         URBANITE_ON_OFF_PRESS_TIME_MS,
         URBANITE_PAUSE_DISPLAY_TIME_MS,
         p_fsm_ultrasound_rear,
         p_fsm_display_rear
     );
+    BOOT_REPORT_MARK(BOOT_REPORT_FSM_URBANITE_INIT);
+
+#ifdef USE_FAST_START
+    /* Fast start: turn ON without waiting for the ON/OFF press and send the first trigger, then do the non-critical init while the echo is on its way */
+    fsm_urbanite_turn_on(p_fsm_urbanite);
+    fsm_urbanite_fire(p_fsm_urbanite);
+    fsm_ultrasound_fire(p_fsm_ultrasound_rear);
+    port_led_gpio_setup();
+    port_led_on();
+    BOOT_REPORT_MARK(BOOT_REPORT_LED_SETUP);
+#endif
+
+#ifdef USE_SCHEDULER
+    _scheduler_setup(p_fsm_ultrasound_rear, p_fsm_urbanite, p_fsm_display_rear, p_fsm_button);
 
+    /* Infinite loop */
+    while (1)
+    {
+        /* Fire the released FSMs, then sleep until the next release (alarm) or an event, without the SysTick */
+        if (scheduler_step(&scheduler) == 0)
+        {
+            port_system_sleep_tickless();
+        }
+    } // End of while(1)
+#else
     /* Infinite loop */
     while (1)
     {
@@ -60,12 +217,7 @@ int main(void)
         fsm_display_fire(p_fsm_display_rear);
         fsm_urbanite_fire(p_fsm_urbanite);
     } // End of while(1)
-
-    /* Free memory */
-    fsm_button_destroy(p_fsm_button); 
-    fsm_ultrasound_destroy(p_fsm_ultrasound_rear);
-    fsm_display_destroy(p_fsm_display_rear);
-    fsm_urbanite_destroy(p_fsm_urbanite);
+#endif
 
     return 0;
 }
@@ -0,0 +1,43 @@
+/**
+ * @file port_boot.h
+ * @brief Header for the portable functions of the time base of the boot report. The functions must be implemented in the platform-specific code.
+ *
+ * The boot report (`boot_report.h`) timestamps the boot sequence and the first measurement with this time base. It must work before `port_system_init()`, so it does not rely on the SysTick.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef PORT_BOOT_H_
+#define PORT_BOOT_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Start the time base of the boot report at 0.
+ *
+ * It must be called as soon as possible after reset, before `port_system_init()`.
+ */
+void port_boot_timer_start(void);
+
+/**
+ * @brief Get the count of the time base, in ticks since `port_boot_timer_start()`.
+ *
+ * The count wraps around at 2^32 ticks (the platforms document their own range). Store the counts and convert their differences with `port_boot_timer_ticks_to_us()`: a difference is right across a wrap-around, as long as the interval is shorter than the range.
+ *
+ * @return uint32_t Count in ticks.
+ */
+uint32_t port_boot_timer_get_ticks(void);
+
+/**
+ * @brief Convert an interval of the time base to µs.
+ *
+ * @param ticks Difference of two counts of `port_boot_timer_get_ticks()`.
+ * @return uint32_t Interval in µs.
+ */
+uint32_t port_boot_timer_ticks_to_us(uint32_t ticks);
+
+#endif /* PORT_BOOT_H_ */
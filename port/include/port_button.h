@@ -73,4 +73,34 @@ void port_button_clear_pending_interrupt (uint32_t button_id);
  */
 void port_button_disable_interrupts (uint32_t button_id);
 
+#ifdef USE_HW_DEBOUNCE
+/**
+ * @brief Set the debounce time of a button (only with `USE_HW_DEBOUNCE`).
+ *
+ * The first edge of a press or a release masks the external interrupt of the button and starts a one-shot timer of this time. When it expires, the timer ISR samples the pin: if the level is not the last one reported, it updates the pressed flag and the tick of the button. The bounces of the contact raise no interrupt and the FSM does not poll a timeout.
+ *
+ * @param button_id Button ID. This index is used to select the element of the buttons_arr[] array
+ * @param debounce_time_ms Debounce time in ms.
+ */
+void port_button_set_debounce_time_ms (uint32_t button_id, uint32_t debounce_time_ms);
+#endif
+
+/**
+ * @brief Get the tick of the latest change of the button, captured by the EXTI ISR when the edge happened.
+ *
+ * The FSM uses it instead of the tick when it fires, so that the durations do not depend on the latency of the main loop. Without `USE_HW_DEBOUNCE` it is the tick of the latest edge (the last bounce seen before the FSM reads it). With `USE_HW_DEBOUNCE` it is the tick of the first edge of the debounced press or release, not the tick when the timer confirmed it.
+ *
+ * @param button_id Button ID. This index is used to select the element of the buttons_arr[] array
+ * @return uint32_t System tick in ms.
+ */
+uint32_t port_button_get_tick (uint32_t button_id);
+
+/**
+ * @brief Set the tick of the latest change of the button, as the EXTI ISR does at an edge. Used with `port_button_set_pressed()` to inject a press or a release in software.
+ *
+ * @param button_id Button ID. This index is used to select the element of the buttons_arr[] array
+ * @param tick System tick in ms.
+ */
+void port_button_set_tick (uint32_t button_id, uint32_t tick);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file port_memory.h
+ * @brief Header for the portable functions to monitor the RAM usage (stack and heap) of the system. The functions must be implemented in the platform-specific code.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef PORT_MEMORY_H_
+#define PORT_MEMORY_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure with the RAM high-water marks of the system.
+ *
+ * All the values are in bytes. The stack values are the maximum depth reached since `port_memory_init()` was called, the heap value is the maximum amount of memory ever handed out by the heap allocator.
+ */
+typedef struct
+{
+    /** @brief Bytes reserved by the linker for the main (thread mode) stack */
+    uint32_t main_stack_size;
+    /** @brief Maximum depth reached by the main (thread mode) stack */
+    uint32_t main_stack_max_used;
+    /** @brief Bytes reserved for the stack used by the interrupt service routines */
+    uint32_t isr_stack_size;
+    /** @brief Maximum depth reached by the stack used by the interrupt service routines */
+    uint32_t isr_stack_max_used;
+    /** @brief Bytes available to the heap (from the end of the static data to the bottom of the main stack) */
+    uint32_t heap_size;
+    /** @brief Maximum amount of memory handed out by the heap */
+    uint32_t heap_peak;
+} port_memory_report_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Start monitoring the RAM usage of the system.
+ *
+ * This function paints the unused part of the stacks with a known pattern so that their high-water marks can be computed later on. It must be called as soon as possible after reset, before the stack has grown.
+ */
+void port_memory_init(void);
+
+/**
+ * @brief Get the RAM high-water marks of the system.
+ *
+ * @param p_report Pointer to the structure where the report is stored.
+ */
+void port_memory_get_report(port_memory_report_t *p_report);
+
+/**
+ * @brief Print the RAM high-water marks of the system.
+ *
+ */
+void port_memory_print_report(void);
+
+#endif /* PORT_MEMORY_H_ */
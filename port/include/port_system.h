@@ -10,6 +10,7 @@
 
 /* Includes del sistema */
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @brief Initializes the system.
@@ -23,10 +24,67 @@ uint32_t port_system_init(void);
  */
 uint32_t port_system_get_millis(void);
 
+/**
+ * @brief Returns the number of milliseconds since the system started, in 64 bits: it does not wrap around after 49.7 days like `port_system_get_millis()`.
+ *
+ * It can be called from the threads and from the ISRs. The high word is carried by the SysTick ISR when the 32-bit counter wraps around, and the read retries if the SysTick interrupt comes between the two words, so the value is never torn.
+ *
+ * @retval number of milliseconds since the system started.
+ */
+uint64_t port_system_get_millis64(void);
+
+/**
+ * @brief Returns the number of microseconds since the system started.
+ *
+ * It is read from a free-running timer at 1 MHz, so it costs a few loads and can be called from the threads and from the ISRs. Unlike `port_system_get_millis()`, it keeps counting while the SysTick interrupt is suspended by `port_system_sleep()`; it stops only in the Stop mode. It wraps around after 71.6 minutes: compare the times by their differences.
+ *
+ * @note On the STM32F4 the time base, like the alarm and `port_system_sleep_tickless()`, is only built with `USE_MICROS_TIME_BASE` (on by default with `USE_SCHEDULER`): its overflow interrupt wakes the CPU 15 times per second.
+ *
+ * @retval number of microseconds since the system started.
+ */
+uint32_t port_system_get_micros(void);
+
+/**
+ * @brief Returns the number of microseconds since the system started, in 64 bits: the same time as `port_system_get_micros()` without its wrap-around.
+ *
+ * It can be called from the threads and from the ISRs and is never torn: the overflows of the timer are counted by its ISR, and the read retries if the ISR counts one between the reads. On the STM32F4 it wraps around after 8.9 years (48 bits).
+ *
+ * @retval number of microseconds since the system started.
+ */
+uint64_t port_system_get_micros64(void);
+
+/**
+ * @brief Arms the alarm of the system for a time of `port_system_get_micros64()`.
+ *
+ * The interrupt of the alarm wakes the CPU from the sleep and resumes the SysTick when the time is reached. There is a single alarm: arming it again replaces the previous time, and a time that has already passed fires at once. It is multiplexed by the software timers (`soft_timer.h`), which run their callbacks from the main loop.
+ *
+ * @param deadline_us Time of the alarm in µs.
+ */
+void port_system_alarm_start(uint64_t deadline_us);
+
+/**
+ * @brief Disarms the alarm of the system.
+ */
+void port_system_alarm_stop(void);
+
+/**
+ * @brief Check whether a deadline in ms has been reached, also when the 32-bit time wraps around between both.
+ *
+ * The difference is taken as signed, so it is right while the deadline is less than 24.8 days away from `now_ms`. Use it instead of `now_ms >= deadline_ms`, which fails for the deadlines computed just before the wrap-around.
+ *
+ * @param now_ms Current time in ms (`port_system_get_millis()`).
+ * @param deadline_ms Deadline in ms.
+ * @return true If the deadline has been reached.
+ */
+static inline bool port_system_time_reached(uint32_t now_ms, uint32_t deadline_ms)
+{
+    return (int32_t)(now_ms - deadline_ms) >= 0;
+}
+
 /**
  * @brief Sets the number of milliseconds since the system started.
  *
- * @param ms New number of milliseconds since the system started.
+ * @param ms New number of milliseconds since the system started. Going from `UINT32_MAX` to 0 is the wrap-around of the counter: it carries into the high word of `port_system_get_millis64()`.
  */
 void port_system_set_millis(uint32_t ms);
 
@@ -58,4 +116,11 @@ void port_system_power_sleep(void);
 
 void port_system_sleep(void);
 
+/**
+ * @brief Sets the system in sleep mode with the SysTick interrupt suspended, and keeps the millisecond time.
+ *
+ * Only the interrupts of the peripherals (the alarm, the EXTI lines, the timers) wake the CPU, not the SysTick every millisecond. When the CPU wakes up, the milliseconds slept that the SysTick has not counted are added to `port_system_get_millis()` from the µs time base, and the SysTick is resumed. It is the sleep of the main loop of the scheduler, which runs its tasks from the alarm and the interrupts of the events, not from the SysTick.
+ */
+void port_system_sleep_tickless(void);
+
 #endif /* PORT_SYSTEM_H_ */
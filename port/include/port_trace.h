@@ -0,0 +1,53 @@
+/**
+ * @file port_trace.h
+ * @brief Header for the portable functions to trace the FSMs of the system on a timeline. The functions must be implemented in the platform-specific code.
+ *
+ * The trace is only available when the project is built with `USE_TRACE` (native platform). Every FSM has its own track, where its states are shown as spans and its transitions as instant events.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef PORT_TRACE_H_
+#define PORT_TRACE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Name a track of the trace.
+ *
+ * @param track Track identifier (one per FSM).
+ * @param p_name Name shown for the track.
+ */
+void port_trace_track(uint32_t track, const char *p_name);
+
+/**
+ * @brief Open the span of a state on a track.
+ *
+ * @param track Track identifier.
+ * @param p_state Name of the state.
+ */
+void port_trace_state_begin(uint32_t track, const char *p_state);
+
+/**
+ * @brief Close the span of a state on a track.
+ *
+ * @param track Track identifier.
+ * @param p_state Name of the state.
+ */
+void port_trace_state_end(uint32_t track, const char *p_state);
+
+/**
+ * @brief Record a transition of an FSM.
+ *
+ * @param track Track identifier.
+ * @param row Index of the row of the transitions table that has been fired.
+ * @param p_from Name of the origin state.
+ * @param p_to Name of the destination state.
+ */
+void port_trace_transition(uint32_t track, uint32_t row, const char *p_from, const char *p_to);
+
+#endif /* PORT_TRACE_H_ */
@@ -19,6 +19,7 @@
 #define PORT_PARKING_SENSOR_TRIGGER_UP_US 10 /*!< Duration in microseconds of the trigger signal */
 #define PORT_PARKING_SENSOR_TIMEOUT_MS 100 /*!< Time in ms to wait for the next measurement */
 #define SPEED_OF_SOUND_MS 343         /*!< Speed of sound in air in m/s */
+#define PORT_ULTRASOUND_ECHO_TIMER_PERIOD_TICKS 65536U /*!< Ticks (µs) of the timer of the echo signal between two overflows: its counter wraps around at 16 bits */
 
 /* Function prototypes and explanation -------------------------------------------------*/
 
@@ -0,0 +1,73 @@
+/**
+ * @file native_button.h
+ * @brief Header for native_button.c file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef NATIVE_BUTTON_H_
+#define NATIVE_BUTTON_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define NATIVE_BUTTON_NUM_BUTTONS 16 /*!< Number of simulated buttons (IDs 0 to 15), one per EXTI line */
+#define NATIVE_BUTTON_NUM_LINES 16   /*!< Number of simulated EXTI lines */
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Set the level of the simulated pin of a button.
+ *
+ * The buttons are active low, as the user button of the Nucleo board: `false` means pressed. If the level changes and the interrupt of the button is enabled (and, with `USE_HW_DEBOUNCE`, not masked by a debounce in progress), the simulated EXTI ISR is run.
+ *
+ * @param button_id Button ID.
+ * @param value New level of the pin.
+ */
+void native_button_set_value(uint32_t button_id, bool value);
+
+/**
+ * @brief Get the EXTI line of a simulated button.
+ *
+ * The parking button is on line 13, as the user button of the Nucleo board (PC13), and the other buttons on the remaining lines.
+ *
+ * @param button_id Button ID.
+ * @return uint32_t EXTI line.
+ */
+uint32_t native_button_get_line(uint32_t button_id);
+
+/**
+ * @brief Mark EXTI lines as pending, as edges on their pins would, without running the ISR.
+ *
+ * Only the lines whose interrupt is enabled (and not masked by a debounce) become pending.
+ *
+ * @param lines Mask of the EXTI lines.
+ */
+void native_button_set_pending_lines(uint32_t lines);
+
+/**
+ * @brief Simulated EXTI ISR of the buttons (same behaviour as the EXTI ISRs of the STM32F4 platform, see `stm32f4_button_exti_isr()`).
+ *
+ * The pending lines of the buttons are walked with count-trailing-zeros and a table gives the button of every line. This function is called by `native_button_set_value()`.
+ */
+void native_button_exti_isr(void);
+
+/**
+ * @brief Get the number of times the simulated EXTI ISR has serviced the line of a button since `port_button_init()`.
+ *
+ * @param button_id Button ID.
+ * @return uint32_t Number of interrupts.
+ */
+uint32_t native_button_get_interrupt_count(uint32_t button_id);
+
+/**
+ * @brief Run one millisecond of the simulated debounce timers of the buttons (only active with `USE_HW_DEBOUNCE`).
+ *
+ * When the debounce timer of a button expires, its simulated ISR samples the pin, posts the change if the level is new and unmasks the external interrupt. This function is called by `native_system_advance_ms()`.
+ */
+void native_button_tick_ms(void);
+
+#endif /* NATIVE_BUTTON_H_ */
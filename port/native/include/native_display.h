@@ -0,0 +1,27 @@
+/**
+ * @file native_display.h
+ * @brief Header for native_display.c file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef NATIVE_DISPLAY_H_
+#define NATIVE_DISPLAY_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* HW dependent includes */
+#include "port_display.h"
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Get the color shown by a simulated RGB display.
+ *
+ * @param display_id Display ID.
+ * @return rgb_color_t Last color set with `port_display_set_rgb()`.
+ */
+rgb_color_t native_display_get_rgb(uint32_t display_id);
+
+#endif /* NATIVE_DISPLAY_H_ */
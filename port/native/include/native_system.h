@@ -0,0 +1,69 @@
+/**
+ * @file native_system.h
+ * @brief Header for native_system.c file.
+ *
+ * The native platform is a host simulator of the Urbanite hardware. The time is virtual: it only advances when the simulation calls `native_system_advance_ms()` or when the firmware waits (`port_system_delay_ms()`, `port_system_sleep()`...). A low power mode lasts until the next simulated interrupt: the next millisecond, or the alarm of the system if it comes first.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef NATIVE_SYSTEM_H_
+#define NATIVE_SYSTEM_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Advance the virtual time of the simulator.
+ *
+ * Every millisecond runs the simulated SysTick (if it is not suspended) and the simulated timers of the peripherals, which set the same flags as the ISRs of the real hardware.
+ *
+ * @param ms Milliseconds to advance.
+ */
+void native_system_advance_ms(uint32_t ms);
+
+/**
+ * @brief Advance the virtual time of the simulator in µs.
+ *
+ * The simulated millisecond events (`native_system_advance_ms()`) run every time the time crosses a millisecond, so the time can be advanced to any point between two of them, e.g. to place an edge in the middle of a millisecond.
+ *
+ * @param us Microseconds to advance.
+ */
+void native_system_advance_us(uint32_t us);
+
+/**
+ * @brief Get the simulated time since the start of the program.
+ *
+ * Unlike `port_system_get_millis()`, this time keeps running while the SysTick interrupt is suspended.
+ *
+ * @return uint64_t Simulated time in ms.
+ */
+uint64_t native_system_get_time_ms(void);
+
+/**
+ * @brief Set the µs time base, e.g. close to the wrap-around of `port_system_get_micros()`.
+ *
+ * @param us New value of `port_system_get_micros64()`.
+ */
+void native_system_set_micros64(uint64_t us);
+
+/**
+ * @brief Get the number of interrupts of the simulated alarm (`port_system_alarm_start()`) since the initialization of the system.
+ *
+ * @return uint32_t Number of interrupts.
+ */
+uint32_t native_system_get_alarm_count(void);
+
+/**
+ * @brief Get the number of low power waits (`port_system_power_sleep()`, `port_system_power_stop()`) ended by an interrupt since the initialization of the system.
+ *
+ * A wait is ended by the SysTick if it is not suspended, or by an interrupt that resumes it: the alarm, the EXTI of the buttons, the echo. A wait with the SysTick suspended and none of these interrupts is not counted: it ends at the next millisecond of the simulation, but the CPU would still be asleep.
+ *
+ * @return uint32_t Number of wake-ups.
+ */
+uint32_t native_system_get_wakeups(void);
+
+#endif /* NATIVE_SYSTEM_H_ */
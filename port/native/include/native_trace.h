@@ -0,0 +1,78 @@
+/**
+ * @file native_trace.h
+ * @brief Header for native_trace.c file.
+ *
+ * The trace is written in the Chrome trace-event JSON format, which can be opened with Perfetto (https://ui.perfetto.dev) or `chrome://tracing`. The events are streamed to the file as they happen, so the memory used does not depend on the length of the simulation.
+ *
+ * The timestamps are the simulated time in µs. Events of the same millisecond are spread over consecutive µs so that their order is kept.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef NATIVE_TRACE_H_
+#define NATIVE_TRACE_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define NATIVE_TRACE_ISR_TRACK 100     /*!< Track of the simulated interrupt service routines */
+#define NATIVE_TRACE_PORT_TRACK 101    /*!< Track of the calls to the port functions */
+#define NATIVE_TRACE_BUFFER_SIZE 65536 /*!< Size in bytes of the buffer of the trace file */
+#define NATIVE_TRACE_MAX_TRACKS 16     /*!< Maximum number of FSM tracks (identifiers 0 to `NATIVE_TRACE_MAX_TRACKS - 1`) */
+
+#ifdef USE_TRACE
+#define NATIVE_TRACE_ISR(name, id) native_trace_isr(name, id)             /*!< Record a simulated ISR (only with `USE_TRACE`) */
+#define NATIVE_TRACE_SYSTICK() native_trace_systick()                     /*!< Record the simulated SysTick ISR (only with `USE_TRACE`) */
+#define NATIVE_TRACE_PORT_CALL(name, id) native_trace_port_call(name, id) /*!< Record a call to a port function (only with `USE_TRACE`) */
+#else
+#define NATIVE_TRACE_ISR(name, id)
+#define NATIVE_TRACE_SYSTICK()
+#define NATIVE_TRACE_PORT_CALL(name, id)
+#endif
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Open the trace file and write its header.
+ *
+ * The file is closed by `native_trace_close()` or at the exit of the program. Open it before creating the FSMs so that their tracks and initial states are recorded.
+ *
+ * @param p_path Path of the trace file.
+ * @param trace_systick `true` to also record the SysTick ISR (one event per simulated ms).
+ * @return `true` if the file has been opened, `false` otherwise.
+ */
+bool native_trace_open(const char *p_path, bool trace_systick);
+
+/**
+ * @brief Close the trace file.
+ *
+ * The open state spans are closed at the current time so that the file is a valid JSON array.
+ */
+void native_trace_close(void);
+
+/**
+ * @brief Record the execution of a simulated ISR.
+ *
+ * @param p_name Name of the ISR (as in the STM32F4 platform).
+ * @param id Identifier of the peripheral that raised the interrupt.
+ */
+void native_trace_isr(const char *p_name, uint32_t id);
+
+/**
+ * @brief Record the execution of the simulated SysTick ISR, if it was requested when the trace was opened.
+ */
+void native_trace_systick(void);
+
+/**
+ * @brief Record a call to a port function.
+ *
+ * @param p_name Name of the function.
+ * @param id Identifier of the peripheral passed to the function.
+ */
+void native_trace_port_call(const char *p_name, uint32_t id);
+
+#endif /* NATIVE_TRACE_H_ */
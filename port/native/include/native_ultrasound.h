@@ -0,0 +1,36 @@
+/**
+ * @file native_ultrasound.h
+ * @brief Header for native_ultrasound.c file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef NATIVE_ULTRASOUND_H_
+#define NATIVE_ULTRASOUND_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define NATIVE_ULTRASOUND_ECHO_INIT_TICK 100  /*!< Tick of the echo timer at the rising edge of the simulated echo */
+#define NATIVE_ULTRASOUND_DEFAULT_DISTANCE_CM 100 /*!< Distance to the obstacle at reset */
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Set the distance to the obstacle seen by a simulated ultrasound sensor.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ * @param distance_cm Distance in cm that the next echoes will measure.
+ */
+void native_ultrasound_set_distance_cm(uint32_t ultrasound_id, uint32_t distance_cm);
+
+/**
+ * @brief Run one millisecond of the simulated timers of the ultrasound sensors.
+ *
+ * The trigger timer expires in the first millisecond after a measurement is started (the trigger lasts 10 us), the echo is captured in the next one and the new measurement timer expires every `PORT_PARKING_SENSOR_TIMEOUT_MS`. This function is called by `native_system_advance_ms()`.
+ */
+void native_ultrasound_tick_ms(void);
+
+#endif /* NATIVE_ULTRASOUND_H_ */
@@ -0,0 +1,38 @@
+/**
+ * @file native_boot.c
+ * @brief Portable functions of the time base of the boot report for the native (host simulator) platform. All portable functions must be implemented in this file.
+ *
+ * The time base is the virtual time of the simulator, so the report shows the simulated waits (timers, echoes) with a resolution of 1 ms. The code itself takes no virtual time. The ticks are µs.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* HW dependent includes */
+#include "port_boot.h"
+
+/* Platform dependent includes */
+#include "native_system.h"
+
+/* Defines ---------------------------------------------------------------------*/
+#define NATIVE_BOOT_US_PER_MS 1000 /*!< Microseconds per simulated millisecond */
+
+/* Global variables ------------------------------------------------------------*/
+static uint64_t boot_start_ms = 0; /*!< Simulated time of `port_boot_timer_start()` */
+
+/* Public functions -----------------------------------------------------------*/
+void port_boot_timer_start(void)
+{
+    boot_start_ms = native_system_get_time_ms();
+}
+
+uint32_t port_boot_timer_get_ticks(void)
+{
+    return (uint32_t)((native_system_get_time_ms() - boot_start_ms) * NATIVE_BOOT_US_PER_MS);
+}
+
+uint32_t port_boot_timer_ticks_to_us(uint32_t ticks)
+{
+    return ticks;
+}
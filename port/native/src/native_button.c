@@ -0,0 +1,278 @@
+/**
+ * @file native_button.c
+ * @brief Portable functions to interact with the button FSM library for the native (host simulator) platform. All portable functions must be implemented in this file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Platform dependent includes */
+#include "native_button.h"
+#include "native_trace.h"
+
+/* Defines ------------------------------------------------------------------*/
+#define NATIVE_BUTTON_LINE(button_id) (((button_id) + 13U) % NATIVE_BUTTON_NUM_LINES) /*!< EXTI line of a simulated button: the parking button is on line 13 (PC13 on the Nucleo board) and the others on the remaining lines */
+
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief Structure to define the simulated HW of a button */
+typedef struct
+{
+    /** @brief Level of the pin (active low: `false` means pressed) */
+    bool value;
+    /** @brief Flag to indicate that the button is pressed (written by the simulated ISR, read by the FSM) */
+    volatile bool flag_pressed;
+    /** @brief EXTI line of the pin */
+    uint8_t line;
+    /** @brief Number of times the simulated EXTI ISR has serviced the line of the button */
+    uint32_t interrupt_count;
+    /** @brief Tick of the latest change (`port_button_get_tick()`): of the edge, or of the first edge of the debounced change with `USE_HW_DEBOUNCE` */
+    volatile uint32_t tick;
+#ifdef USE_HW_DEBOUNCE
+    /** @brief Tick of the first edge of the press or release being debounced */
+    uint32_t edge_tick;
+#endif
+} native_button_hw_t;
+
+/* Global variables ------------------------------------------------------------*/
+/** @brief Array of elements that represents the simulated buttons. */
+static native_button_hw_t buttons_arr[NATIVE_BUTTON_NUM_BUTTONS];
+
+static uint8_t line_ids[NATIVE_BUTTON_NUM_LINES]; /*!< Button ID of every EXTI line of `exti_lines` */
+static uint32_t exti_lines = 0;                   /*!< Mask of the EXTI lines of the initialized buttons */
+static uint32_t exti_imr = 0;                     /*!< Simulated interrupt mask register of the EXTI */
+static uint32_t exti_pr = 0;                      /*!< Simulated pending register of the EXTI */
+#ifdef USE_HW_DEBOUNCE
+static uint32_t debounce_lines = 0;        /*!< Mask of the EXTI lines masked until the debounce timer expires */
+static uint32_t debounce_period_ms = PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS; /*!< Period of the simulated debounce timer, shared by all the buttons */
+static uint32_t debounce_remaining_ms = 0; /*!< Milliseconds until the simulated debounce timer expires (0 if it is stopped) */
+#endif
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get the button status struct with the given ID.
+ *
+ * @param button_id Button ID.
+ *
+ * @return Pointer to the button state struct.
+ * @return NULL If the button ID is not valid.
+ */
+static native_button_hw_t *_native_button_get(uint32_t button_id)
+{
+    if (button_id < NATIVE_BUTTON_NUM_BUTTONS)
+    {
+        return &buttons_arr[button_id];
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+#ifdef USE_TRACE
+/**
+ * @brief Get the name of the STM32F4 ISR of an EXTI line, for the trace.
+ *
+ * @param line EXTI line.
+ * @return const char* Name of the ISR.
+ */
+static const char *_native_button_isr_name(uint32_t line)
+{
+    static const char *const names[] = {"EXTI0_IRQHandler", "EXTI1_IRQHandler", "EXTI2_IRQHandler", "EXTI3_IRQHandler", "EXTI4_IRQHandler"};
+    if (line < 5)
+    {
+        return names[line];
+    }
+    return (line < 10) ? "EXTI9_5_IRQHandler" : "EXTI15_10_IRQHandler";
+}
+#endif
+
+#ifdef USE_HW_DEBOUNCE
+/**
+ * @brief Start the debounce of a button: mask its EXTI line and (re)start the simulated debounce timer (same behaviour as `stm32f4_button_debounce_start()` of the STM32F4 platform).
+ *
+ * @param p_button Button struct.
+ * @param line_mask Mask of the EXTI line of the button.
+ * @param tick System tick of the edge.
+ */
+static void _native_button_debounce_start(native_button_hw_t *p_button, uint32_t line_mask, uint32_t tick)
+{
+    exti_imr &= ~line_mask;
+    p_button->edge_tick = tick;
+    debounce_lines |= line_mask;
+    debounce_remaining_ms = debounce_period_ms;
+}
+
+/**
+ * @brief Simulated ISR of the debounce timer (same behaviour as `TIM7_IRQHandler()` of the STM32F4 platform).
+ */
+static void _native_button_debounce_isr(void)
+{
+    NATIVE_TRACE_ISR("TIM7_IRQHandler", 0);
+    port_system_systick_resume();
+    uint32_t lines = debounce_lines;
+    debounce_lines = 0;
+    exti_pr &= ~lines;
+    while (lines != 0)
+    {
+        uint32_t line = (uint32_t)__builtin_ctz(lines);
+        uint32_t line_mask = lines & (0U - lines);
+        lines &= lines - 1U;
+        native_button_hw_t *p_button = &buttons_arr[line_ids[line]];
+        bool pressed = !p_button->value;
+        if (pressed != p_button->flag_pressed)
+        {
+            p_button->tick = p_button->edge_tick;
+            p_button->flag_pressed = pressed;
+        }
+        exti_imr |= line_mask;
+    }
+}
+#endif
+
+/* Public functions -----------------------------------------------------------*/
+void native_button_exti_isr(void)
+{
+    port_system_systick_resume();
+    uint32_t pending = exti_pr & exti_lines;
+    uint32_t tick = port_system_get_millis(); /* One read for all the pending lines, as on the STM32F4 */
+    exti_pr &= ~pending;
+    while (pending != 0)
+    {
+        uint32_t line = (uint32_t)__builtin_ctz(pending);
+        uint32_t line_mask = pending & (0U - pending);
+        pending &= pending - 1U;
+        native_button_hw_t *p_button = &buttons_arr[line_ids[line]];
+        NATIVE_TRACE_ISR(_native_button_isr_name(line), line_ids[line]);
+        p_button->interrupt_count++;
+#ifdef USE_HW_DEBOUNCE
+        _native_button_debounce_start(p_button, line_mask, tick);
+#else
+        (void)line_mask;
+        p_button->tick = tick;
+        p_button->flag_pressed = !p_button->value;
+#endif
+    }
+}
+
+void native_button_set_pending_lines(uint32_t lines)
+{
+    exti_pr |= lines & exti_imr;
+}
+
+void native_button_set_value(uint32_t button_id, bool value)
+{
+    native_button_hw_t *p_button = _native_button_get(button_id);
+    if (p_button->value == value)
+    {
+        return;
+    }
+    p_button->value = value;
+    uint32_t line_mask = 1U << p_button->line;
+    if (exti_imr & line_mask)
+    {
+        exti_pr |= line_mask;
+        native_button_exti_isr();
+    }
+}
+
+uint32_t native_button_get_line(uint32_t button_id)
+{
+    return _native_button_get(button_id)->line;
+}
+
+uint32_t native_button_get_interrupt_count(uint32_t button_id)
+{
+    return _native_button_get(button_id)->interrupt_count;
+}
+
+void native_button_tick_ms(void)
+{
+#ifdef USE_HW_DEBOUNCE
+    if (debounce_remaining_ms > 0 && --debounce_remaining_ms == 0)
+    {
+        _native_button_debounce_isr();
+    }
+#endif
+}
+
+void port_button_init(uint32_t button_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_button_init", button_id);
+    native_button_hw_t *p_button = _native_button_get(button_id);
+    uint32_t line_mask;
+    p_button->value = true;
+    p_button->flag_pressed = false;
+    p_button->interrupt_count = 0;
+    p_button->line = (uint8_t)NATIVE_BUTTON_LINE(button_id);
+    p_button->tick = 0;
+    line_mask = 1U << p_button->line;
+    line_ids[p_button->line] = (uint8_t)button_id;
+    exti_lines |= line_mask;
+    exti_imr |= line_mask;
+    exti_pr &= ~line_mask;
+#ifdef USE_HW_DEBOUNCE
+    debounce_lines &= ~line_mask;
+#endif
+}
+
+bool port_button_get_pressed(uint32_t button_id)
+{
+    return _native_button_get(button_id)->flag_pressed;
+}
+
+bool port_button_get_value(uint32_t button_id)
+{
+    return _native_button_get(button_id)->value;
+}
+
+void port_button_set_pressed(uint32_t button_id, bool pressed)
+{
+    _native_button_get(button_id)->flag_pressed = pressed;
+}
+
+bool port_button_get_pending_interrupt(uint32_t button_id)
+{
+    return (exti_pr & (1U << _native_button_get(button_id)->line)) != 0;
+}
+
+void port_button_clear_pending_interrupt(uint32_t button_id)
+{
+    exti_pr &= ~(1U << _native_button_get(button_id)->line);
+}
+
+void port_button_disable_interrupts(uint32_t button_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_button_disable_interrupts", button_id);
+    native_button_hw_t *p_button = _native_button_get(button_id);
+    uint32_t line_mask = 1U << p_button->line;
+    exti_imr &= ~line_mask;
+    exti_lines &= ~line_mask;
+#ifdef USE_HW_DEBOUNCE
+    debounce_lines &= ~line_mask;
+#endif
+}
+
+#ifdef USE_HW_DEBOUNCE
+void port_button_set_debounce_time_ms(uint32_t button_id, uint32_t debounce_time_ms)
+{
+    debounce_period_ms = (debounce_time_ms > 0) ? debounce_time_ms : 1;
+}
+#endif
+
+uint32_t port_button_get_tick(uint32_t button_id)
+{
+    return _native_button_get(button_id)->tick;
+}
+
+void port_button_set_tick(uint32_t button_id, uint32_t tick)
+{
+    _native_button_get(button_id)->tick = tick;
+}
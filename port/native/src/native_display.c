@@ -0,0 +1,68 @@
+/**
+ * @file native_display.c
+ * @brief Portable functions to interact with the display FSM library for the native (host simulator) platform. All portable functions must be implemented in this file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_display.h"
+
+/* Platform dependent includes */
+#include "native_display.h"
+#include "native_trace.h"
+
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief Structure to define the simulated HW of an RGB display */
+typedef struct
+{
+    /** @brief Color shown by the RGB LED */
+    rgb_color_t color;
+} native_display_hw_t;
+
+/* Global variables ------------------------------------------------------------*/
+/** @brief Array of elements that represents the simulated displays. */
+static native_display_hw_t displays_arr[] = {
+    [PORT_REAR_PARKING_DISPLAY_ID] = {.color = {0, 0, 0}}};
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get the display struct with the given ID.
+ *
+ * @param display_id Display ID.
+ *
+ * @return Pointer to the display struct.
+ * @return NULL If the display ID is not valid.
+ */
+static native_display_hw_t *_native_display_get(uint32_t display_id)
+{
+    if (display_id < sizeof(displays_arr) / sizeof(displays_arr[0]))
+    {
+        return &displays_arr[display_id];
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+rgb_color_t native_display_get_rgb(uint32_t display_id)
+{
+    return _native_display_get(display_id)->color;
+}
+
+void port_display_init(uint32_t display_id)
+{
+    port_display_set_rgb(display_id, COLOR_OFF);
+}
+
+void port_display_set_rgb(uint32_t display_id, rgb_color_t color)
+{
+    NATIVE_TRACE_PORT_CALL("port_display_set_rgb", display_id);
+    _native_display_get(display_id)->color = color;
+}
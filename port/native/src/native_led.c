@@ -0,0 +1,39 @@
+/**
+ * @file native_led.c
+ * @brief Port layer for the LED emulation in the native (host simulator) platform.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* HW independent includes */
+#include "port_led.h"
+
+/* Global variables ------------------------------------------------------------*/
+static bool led_on = false; /*!< State of the simulated LD2 LED */
+
+/* Public functions -----------------------------------------------------------*/
+void port_led_gpio_setup(void)
+{
+    led_on = false;
+}
+
+bool port_led_get(void)
+{
+    return led_on;
+}
+
+void port_led_on(void)
+{
+    led_on = true;
+}
+
+void port_led_off(void)
+{
+    led_on = false;
+}
+
+void port_led_toggle(void)
+{
+    led_on = !led_on;
+}
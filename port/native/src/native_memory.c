@@ -0,0 +1,43 @@
+/**
+ * @file native_memory.c
+ * @brief Portable functions to monitor the RAM usage for the native (host simulator) platform. All portable functions must be implemented in this file.
+ *
+ * The stacks of the host are not painted: only the report format is kept so that the common code can print it.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <inttypes.h>
+
+/* HW dependent includes */
+#include "port_memory.h"
+#include "port_system.h"
+
+/* Public functions -----------------------------------------------------------*/
+void port_memory_init(void)
+{
+}
+
+void port_memory_get_report(port_memory_report_t *p_report)
+{
+    p_report->main_stack_size = 0;
+    p_report->main_stack_max_used = 0;
+    p_report->isr_stack_size = 0;
+    p_report->isr_stack_max_used = 0;
+    p_report->heap_size = 0;
+    p_report->heap_peak = 0;
+}
+
+void port_memory_print_report(void)
+{
+    port_memory_report_t report;
+    port_memory_get_report(&report);
+
+    printf("[MEMORY][%" PRIu32 "] Main stack: %" PRIu32 "/%" PRIu32 " bytes\n", port_system_get_millis(), report.main_stack_max_used, report.main_stack_size);
+    printf("[MEMORY][%" PRIu32 "] ISR stack: %" PRIu32 "/%" PRIu32 " bytes\n", port_system_get_millis(), report.isr_stack_max_used, report.isr_stack_size);
+    printf("[MEMORY][%" PRIu32 "] Heap peak: %" PRIu32 "/%" PRIu32 " bytes\n", port_system_get_millis(), report.heap_peak, report.heap_size);
+}
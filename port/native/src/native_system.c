@@ -0,0 +1,270 @@
+/**
+ * @file native_system.c
+ * @brief Portable functions of the system for the native (host simulator) platform. All portable functions must be implemented in this file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Platform dependent includes */
+#include "native_system.h"
+#include "native_ultrasound.h"
+#include "native_button.h"
+#include "native_trace.h"
+
+/* Global variables ------------------------------------------------------------*/
+static volatile uint32_t msTicks = 0; /*!< Virtual millisecond ticks */
+static volatile uint32_t msTicksHigh = 0; /*!< High word of the 64-bit virtual millisecond ticks: number of wrap-arounds of `msTicks` */
+static bool systick_enabled = true;   /*!< Flag to indicate that the simulated SysTick interrupt is enabled */
+static uint64_t time_us = 0;          /*!< Simulated time in µs, which does not stop with the SysTick */
+static uint64_t micros_base_us = 0;   /*!< Simulated time of the start of the µs time base (`port_system_get_micros64()` counts from it) */
+static bool alarm_armed = false;      /*!< Flag to indicate that the simulated alarm is armed */
+static uint64_t alarm_us = 0;         /*!< Simulated time of the alarm */
+static uint32_t alarm_count = 0;      /*!< Number of interrupts of the simulated alarm */
+static uint32_t wakeups = 0;          /*!< Number of low power waits ended by an interrupt */
+static uint32_t tickless_rem_us = 0;  /*!< Fraction of a millisecond slept by `port_system_sleep_tickless()` and not added yet to the millisecond time */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Simulated SysTick ISR.
+ */
+static void _native_system_systick_isr(void)
+{
+    NATIVE_TRACE_SYSTICK();
+    port_system_set_millis(port_system_get_millis() + 1);
+}
+
+/**
+ * @brief Run the simulated events of a millisecond.
+ */
+static void _native_system_tick_ms(void)
+{
+    /* As on the real hardware, the millisecond ticks stop while the SysTick interrupt is suspended */
+    if (systick_enabled)
+    {
+        _native_system_systick_isr();
+    }
+    native_ultrasound_tick_ms();
+    native_button_tick_ms();
+}
+
+/**
+ * @brief Simulated ISR of the alarm: it fires once and resumes the SysTick.
+ */
+static void _native_system_alarm_isr(void)
+{
+    alarm_armed = false;
+    alarm_count++;
+    port_system_systick_resume();
+}
+
+/**
+ * @brief Advance the virtual time to the next interrupt, as the WFI of a low power mode: the next millisecond (SysTick and simulated peripherals) or the alarm, whichever comes first.
+ */
+static void _native_system_wait_for_interrupt(void)
+{
+    uint32_t step_us = 1000U - (uint32_t)(time_us % 1000U);
+    if (alarm_armed && alarm_us > time_us && alarm_us - time_us < step_us)
+    {
+        step_us = (uint32_t)(alarm_us - time_us);
+    }
+    native_system_advance_us(step_us);
+    if (systick_enabled)
+    {
+        wakeups++; /* The SysTick was running, or an interrupt of a peripheral has resumed it */
+    }
+}
+
+/* Public functions -----------------------------------------------------------*/
+void native_system_advance_ms(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        native_system_advance_us(1000U);
+    }
+}
+
+void native_system_advance_us(uint32_t us)
+{
+    while (us > 0)
+    {
+        uint32_t step_us = 1000U - (uint32_t)(time_us % 1000U); /* to the next millisecond */
+        if (alarm_armed && alarm_us > time_us && alarm_us - time_us < step_us)
+        {
+            step_us = (uint32_t)(alarm_us - time_us); /* to the alarm, in the middle of the millisecond */
+        }
+        if (us < step_us)
+        {
+            time_us += us;
+            break;
+        }
+        time_us += step_us;
+        us -= step_us;
+        if (alarm_armed && time_us >= alarm_us)
+        {
+            _native_system_alarm_isr();
+        }
+        if (time_us % 1000U == 0)
+        {
+            _native_system_tick_ms();
+        }
+    }
+}
+
+uint64_t native_system_get_time_ms(void)
+{
+    return time_us / 1000U;
+}
+
+void native_system_set_micros64(uint64_t us)
+{
+    micros_base_us = time_us - us;
+}
+
+uint32_t native_system_get_alarm_count(void)
+{
+    return alarm_count;
+}
+
+uint32_t native_system_get_wakeups(void)
+{
+    return wakeups;
+}
+
+uint32_t port_system_init()
+{
+    msTicks = 0;
+    msTicksHigh = 0;
+    micros_base_us = time_us;
+    systick_enabled = true;
+    alarm_armed = false;
+    alarm_count = 0;
+    wakeups = 0;
+    tickless_rem_us = 0;
+    return 0;
+}
+
+uint32_t port_system_get_millis()
+{
+    return msTicks;
+}
+
+uint64_t port_system_get_millis64(void)
+{
+    uint32_t high;
+    uint32_t low;
+    do
+    {
+        high = msTicksHigh;
+        low = msTicks;
+    } while (high != msTicksHigh); /* Same read as on the STM32F4 */
+    return ((uint64_t)high << 32) | low;
+}
+
+uint32_t port_system_get_micros(void)
+{
+    return (uint32_t)port_system_get_micros64();
+}
+
+uint64_t port_system_get_micros64(void)
+{
+    return time_us - micros_base_us; /* Like the timer of the STM32F4, it keeps counting while the SysTick is suspended */
+}
+
+void port_system_alarm_start(uint64_t deadline_us)
+{
+    alarm_us = micros_base_us + deadline_us;
+    alarm_armed = true;
+    if (alarm_us <= time_us)
+    {
+        _native_system_alarm_isr(); /* The time has already passed: as on the STM32F4, it fires at once */
+    }
+}
+
+void port_system_alarm_stop(void)
+{
+    alarm_armed = false;
+}
+
+void port_system_set_millis(uint32_t ms)
+{
+    if (ms == 0 && msTicks == UINT32_MAX)
+    {
+        msTicksHigh++; /* Wrap-around: carry into the high word */
+    }
+    msTicks = ms;
+}
+
+void port_system_delay_ms(uint32_t ms)
+{
+    native_system_advance_ms(ms);
+}
+
+void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms)
+{
+    uint32_t until = *p_t + ms;
+    uint32_t now = port_system_get_millis();
+    if (!port_system_time_reached(now, until))
+    {
+        port_system_delay_ms(until - now);
+    }
+    *p_t = port_system_get_millis();
+}
+
+void port_system_systick_suspend()
+{
+    NATIVE_TRACE_PORT_CALL("port_system_systick_suspend", 0);
+    systick_enabled = false;
+}
+
+void port_system_systick_resume()
+{
+    NATIVE_TRACE_PORT_CALL("port_system_systick_resume", 0);
+    systick_enabled = true;
+}
+
+void port_system_power_stop()
+{
+    NATIVE_TRACE_PORT_CALL("port_system_power_stop", 0);
+    _native_system_wait_for_interrupt();
+}
+
+void port_system_power_sleep()
+{
+    NATIVE_TRACE_PORT_CALL("port_system_power_sleep", 0);
+    _native_system_wait_for_interrupt();
+}
+
+void port_system_sleep()
+{
+    NATIVE_TRACE_PORT_CALL("port_system_sleep", 0);
+    port_system_systick_suspend();
+    port_system_power_sleep();
+}
+
+void port_system_sleep_tickless(void)
+{
+    NATIVE_TRACE_PORT_CALL("port_system_sleep_tickless", 0);
+    uint64_t start_us = port_system_get_micros64();
+    uint64_t start_ms = port_system_get_millis64();
+    port_system_systick_suspend();
+    port_system_power_sleep();
+    /* Same catch-up as on the STM32F4 */
+    uint64_t slept_us = port_system_get_micros64() - start_us + tickless_rem_us;
+    uint64_t slept_ms = slept_us / 1000U;
+    uint64_t counted_ms = port_system_get_millis64() - start_ms;
+    tickless_rem_us = (uint32_t)(slept_us % 1000U);
+    if (slept_ms > counted_ms)
+    {
+        uint64_t ms = start_ms + slept_ms;
+        msTicksHigh = (uint32_t)(ms >> 32);
+        msTicks = (uint32_t)ms;
+    }
+    port_system_systick_resume();
+}
@@ -0,0 +1,219 @@
+/**
+ * @file native_trace.c
+ * @brief Portable functions to trace the FSMs on a timeline for the native (host simulator) platform. All portable functions must be implemented in this file.
+ *
+ * Every event is written to the trace file as soon as it is recorded (one JSON object per line). Only the name of the open state of each track is kept in memory.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* HW dependent includes */
+#include "port_trace.h"
+
+/* Platform dependent includes */
+#include "native_trace.h"
+#include "native_system.h"
+
+/* Defines ---------------------------------------------------------------------*/
+#define NATIVE_TRACE_PID 1          /*!< Process identifier of all the events */
+#define NATIVE_TRACE_US_PER_MS 1000 /*!< Microseconds per simulated millisecond */
+
+/* Global variables ------------------------------------------------------------*/
+static FILE *p_trace_file = NULL;                           /*!< Trace file, `NULL` if the trace is closed */
+static char trace_buffer[NATIVE_TRACE_BUFFER_SIZE];         /*!< Buffer of the trace file */
+static bool first_event = true;                             /*!< Flag to indicate that no event has been written yet (no leading comma) */
+static bool systick_traced = false;                         /*!< Flag to indicate that the SysTick ISR is recorded */
+static bool exit_registered = false;                        /*!< Flag to indicate that `native_trace_close()` has been registered with `atexit()` */
+static uint64_t last_ms = 0;                                /*!< Simulated millisecond of the last event */
+static uint32_t events_in_ms = 0;                           /*!< Events already recorded in the simulated millisecond of the last event */
+static const char *open_states[NATIVE_TRACE_MAX_TRACKS];    /*!< Open state of each FSM track, `NULL` if there is none */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Timestamp of a new event in µs.
+ *
+ * Events of the same simulated millisecond get consecutive µs (up to 999) so that the viewer keeps their order.
+ *
+ * @return uint64_t Timestamp in µs.
+ */
+static uint64_t _native_trace_timestamp(void)
+{
+    uint64_t now_ms = native_system_get_time_ms();
+    if (now_ms != last_ms)
+    {
+        last_ms = now_ms;
+        events_in_ms = 0;
+    }
+    uint64_t ts = now_ms * NATIVE_TRACE_US_PER_MS + events_in_ms;
+    if (events_in_ms < NATIVE_TRACE_US_PER_MS - 1)
+    {
+        events_in_ms++;
+    }
+    return ts;
+}
+
+/**
+ * @brief Start a new event: separator and common fields, without the closing brace.
+ *
+ * @param p_name Name of the event.
+ * @param p_cat Category of the event.
+ * @param p_ph Phase of the event (`B`, `E`, `i` or `M`).
+ * @param track Track (thread identifier) of the event.
+ */
+static void _native_trace_event(const char *p_name, const char *p_cat, const char *p_ph, uint32_t track)
+{
+    fprintf(p_trace_file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"pid\":%d,\"tid\":%" PRIu32,
+            first_event ? "" : ",\n", p_name, p_cat, p_ph, NATIVE_TRACE_PID, track);
+    first_event = false;
+}
+
+/**
+ * @brief Write the name of a track.
+ *
+ * @param track Track identifier.
+ * @param p_name Name of the track.
+ */
+static void _native_trace_thread_name(uint32_t track, const char *p_name)
+{
+    _native_trace_event("thread_name", "__metadata", "M", track);
+    fprintf(p_trace_file, ",\"args\":{\"name\":\"%s\"}}", p_name);
+    _native_trace_event("thread_sort_index", "__metadata", "M", track);
+    fprintf(p_trace_file, ",\"args\":{\"sort_index\":%" PRIu32 "}}", track);
+}
+
+/**
+ * @brief Write an instant event on a track.
+ *
+ * @param p_name Name of the event.
+ * @param p_cat Category of the event.
+ * @param track Track identifier.
+ * @param id Identifier of the peripheral, written as argument.
+ */
+static void _native_trace_instant(const char *p_name, const char *p_cat, uint32_t track, uint32_t id)
+{
+    _native_trace_event(p_name, p_cat, "i", track);
+    fprintf(p_trace_file, ",\"s\":\"t\",\"ts\":%" PRIu64 ",\"args\":{\"id\":%" PRIu32 "}}", _native_trace_timestamp(), id);
+}
+
+/* Public functions -----------------------------------------------------------*/
+bool native_trace_open(const char *p_path, bool trace_systick)
+{
+    native_trace_close();
+    p_trace_file = fopen(p_path, "w");
+    if (p_trace_file == NULL)
+    {
+        return false;
+    }
+    setvbuf(p_trace_file, trace_buffer, _IOFBF, sizeof(trace_buffer));
+    if (!exit_registered)
+    {
+        atexit(native_trace_close);
+        exit_registered = true;
+    }
+
+    first_event = true;
+    systick_traced = trace_systick;
+    last_ms = native_system_get_time_ms();
+    events_in_ms = 0;
+    for (uint32_t track = 0; track < NATIVE_TRACE_MAX_TRACKS; track++)
+    {
+        open_states[track] = NULL;
+    }
+
+    fprintf(p_trace_file, "[\n");
+    _native_trace_event("process_name", "__metadata", "M", 0);
+    fprintf(p_trace_file, ",\"args\":{\"name\":\"Urbanite (native simulator)\"}}");
+    _native_trace_thread_name(NATIVE_TRACE_ISR_TRACK, "ISR");
+    _native_trace_thread_name(NATIVE_TRACE_PORT_TRACK, "port");
+    return true;
+}
+
+void native_trace_close(void)
+{
+    if (p_trace_file == NULL)
+    {
+        return;
+    }
+    for (uint32_t track = 0; track < NATIVE_TRACE_MAX_TRACKS; track++)
+    {
+        if (open_states[track] != NULL)
+        {
+            port_trace_state_end(track, open_states[track]);
+        }
+    }
+    fprintf(p_trace_file, "\n]\n");
+    fclose(p_trace_file);
+    p_trace_file = NULL;
+}
+
+void native_trace_isr(const char *p_name, uint32_t id)
+{
+    if (p_trace_file != NULL)
+    {
+        _native_trace_instant(p_name, "isr", NATIVE_TRACE_ISR_TRACK, id);
+    }
+}
+
+void native_trace_systick(void)
+{
+    if (systick_traced)
+    {
+        native_trace_isr("SysTick_Handler", 0);
+    }
+}
+
+void native_trace_port_call(const char *p_name, uint32_t id)
+{
+    if (p_trace_file != NULL)
+    {
+        _native_trace_instant(p_name, "port", NATIVE_TRACE_PORT_TRACK, id);
+    }
+}
+
+void port_trace_track(uint32_t track, const char *p_name)
+{
+    if (p_trace_file != NULL)
+    {
+        _native_trace_thread_name(track, p_name);
+    }
+}
+
+void port_trace_state_begin(uint32_t track, const char *p_state)
+{
+    if (p_trace_file == NULL || track >= NATIVE_TRACE_MAX_TRACKS)
+    {
+        return;
+    }
+    _native_trace_event(p_state, "state", "B", track);
+    fprintf(p_trace_file, ",\"ts\":%" PRIu64 "}", _native_trace_timestamp());
+    open_states[track] = p_state;
+}
+
+void port_trace_state_end(uint32_t track, const char *p_state)
+{
+    if (p_trace_file == NULL || track >= NATIVE_TRACE_MAX_TRACKS || open_states[track] == NULL)
+    {
+        return;
+    }
+    _native_trace_event(p_state, "state", "E", track);
+    fprintf(p_trace_file, ",\"ts\":%" PRIu64 "}", _native_trace_timestamp());
+    open_states[track] = NULL;
+}
+
+void port_trace_transition(uint32_t track, uint32_t row, const char *p_from, const char *p_to)
+{
+    if (p_trace_file == NULL)
+    {
+        return;
+    }
+    _native_trace_event(p_to, "transition", "i", track);
+    fprintf(p_trace_file, ",\"s\":\"t\",\"ts\":%" PRIu64 ",\"args\":{\"row\":%" PRIu32 ",\"from\":\"%s\",\"to\":\"%s\"}}",
+            _native_trace_timestamp(), row, p_from, p_to);
+}
@@ -0,0 +1,318 @@
+/**
+ * @file native_ultrasound.c
+ * @brief Portable functions to interact with the ultrasound FSM library for the native (host simulator) platform. All portable functions must be implemented in this file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* HW dependent includes */
+#include "port_ultrasound.h"
+#include "port_system.h"
+
+/* Platform dependent includes */
+#include "native_ultrasound.h"
+#include "native_trace.h"
+
+/* Defines ---------------------------------------------------------------------*/
+#define NATIVE_ULTRASOUND_TRIGGER_READY_BIT 0 /*!< Bit of the flags: a new measurement can be started */
+#define NATIVE_ULTRASOUND_TRIGGER_END_BIT 1   /*!< Bit of the flags: the trigger signal has ended */
+#define NATIVE_ULTRASOUND_ECHO_RECEIVED_BIT 2 /*!< Bit of the flags: the echo signal has been received */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the state of an ultrasound sensor shared with the simulated ISRs (same layout as in the STM32F4 platform).
+ *
+ * The fields are `volatile` so that the FSM reads them again on every poll, as on the target.
+ */
+typedef struct
+{
+    /** @brief Tick time when the echo signal was received */
+    volatile uint32_t echo_init_tick;
+    /** @brief Tick time when the echo signal ended */
+    volatile uint32_t echo_end_tick;
+    /** @brief Number of overflows of the echo signal */
+    volatile uint32_t echo_overflows;
+    /** @brief Flags of the sensor (`NATIVE_ULTRASOUND_*_BIT`) */
+    volatile uint32_t flags;
+} native_ultrasound_hw_t;
+
+/** @brief Structure to define the simulated peripherals of an ultrasound sensor */
+typedef struct
+{
+    /** @brief Distance to the simulated obstacle in cm */
+    uint32_t distance_cm;
+    /** @brief Flag to indicate that the trigger timer is running */
+    bool trigger_timer_enabled;
+    /** @brief Flag to indicate that the echo timer is running */
+    bool echo_timer_enabled;
+    /** @brief Flag to indicate that the echo of the last trigger has not been captured yet */
+    bool echo_pending;
+} native_ultrasound_sim_t;
+
+/* Global variables ------------------------------------------------------------*/
+/** @brief Array of elements that represents the simulated peripherals of the ultrasound sensors. */
+static native_ultrasound_sim_t ultrasounds_sim_arr[] = {
+    [PORT_REAR_PARKING_SENSOR_ID] = {.distance_cm = NATIVE_ULTRASOUND_DEFAULT_DISTANCE_CM}};
+
+/** @brief Array of elements that represents the state of the simulated ultrasound sensors shared with the ISRs. */
+static native_ultrasound_hw_t ultrasounds_arr[sizeof(ultrasounds_sim_arr) / sizeof(ultrasounds_sim_arr[0])];
+
+static bool measurement_timer_enabled = false; /*!< Flag to indicate that the new measurement timer (shared by all the sensors) is running */
+static uint32_t measurement_timer_ms = 0;      /*!< Milliseconds since the new measurement timer was (re)started */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get the ultrasound struct with the given ID.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ *
+ * @return Pointer to the ultrasound sensor struct.
+ * @return NULL If the ultrasound sensor ID is not valid.
+ */
+static native_ultrasound_hw_t *_native_ultrasound_get(uint32_t ultrasound_id)
+{
+    if (ultrasound_id < sizeof(ultrasounds_arr) / sizeof(ultrasounds_arr[0]))
+    {
+        return &ultrasounds_arr[ultrasound_id];
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+/**
+ * @brief Get the simulated peripherals of the ultrasound sensor with the given ID.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ *
+ * @return Pointer to the simulated peripherals.
+ */
+static native_ultrasound_sim_t *_native_ultrasound_get_sim(uint32_t ultrasound_id)
+{
+    return &ultrasounds_sim_arr[ultrasound_id];
+}
+
+/**
+ * @brief Get a flag of an ultrasound sensor.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ * @param bit Bit of the flag (`NATIVE_ULTRASOUND_*_BIT`).
+ * @return bool Value of the flag.
+ */
+static bool _native_ultrasound_get_flag(uint32_t ultrasound_id, uint32_t bit)
+{
+    return (_native_ultrasound_get(ultrasound_id)->flags >> bit) & 1U;
+}
+
+/**
+ * @brief Set a flag of an ultrasound sensor.
+ *
+ * The simulated ISRs run in the same thread as the FSMs, so a read-modify-write of the flags cannot be interrupted (the STM32F4 platform writes the bit through the bit-band alias instead).
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ * @param bit Bit of the flag (`NATIVE_ULTRASOUND_*_BIT`).
+ * @param value New value of the flag.
+ */
+static void _native_ultrasound_set_flag(uint32_t ultrasound_id, uint32_t bit, bool value)
+{
+    native_ultrasound_hw_t *p_ultrasound = _native_ultrasound_get(ultrasound_id);
+    if (value)
+    {
+        p_ultrasound->flags |= (1U << bit);
+    }
+    else
+    {
+        p_ultrasound->flags &= ~(1U << bit);
+    }
+}
+
+/**
+ * @brief Duration of the echo of an obstacle in ticks of the echo timer (1 MHz, as the TIM2 of the STM32F4 platform).
+ *
+ * The value is rounded up so that the FSM computes back the same distance.
+ *
+ * @param distance_cm Distance to the obstacle in cm.
+ * @return uint32_t Ticks between the rising and the falling edge of the echo.
+ */
+static uint32_t _native_ultrasound_echo_ticks(uint32_t distance_cm)
+{
+    return (distance_cm * 2 * 10000 + SPEED_OF_SOUND_MS - 1) / SPEED_OF_SOUND_MS;
+}
+
+/* Public functions -----------------------------------------------------------*/
+void native_ultrasound_set_distance_cm(uint32_t ultrasound_id, uint32_t distance_cm)
+{
+    _native_ultrasound_get_sim(ultrasound_id)->distance_cm = distance_cm;
+}
+
+void native_ultrasound_tick_ms(void)
+{
+    for (uint32_t id = 0; id < sizeof(ultrasounds_arr) / sizeof(ultrasounds_arr[0]); id++)
+    {
+        native_ultrasound_sim_t *p_ultrasound = &ultrasounds_sim_arr[id];
+        if (p_ultrasound->trigger_timer_enabled)
+        {
+            /* Trigger timer ISR */
+            NATIVE_TRACE_ISR("TIM3_IRQHandler", id);
+            p_ultrasound->trigger_timer_enabled = false;
+            port_ultrasound_set_trigger_end(id, true);
+            p_ultrasound->echo_pending = true;
+        }
+        else if (p_ultrasound->echo_pending && p_ultrasound->echo_timer_enabled)
+        {
+            /* Echo timer ISR: both edges of the echo are captured in the same millisecond */
+            NATIVE_TRACE_ISR("TIM2_IRQHandler", id);
+            p_ultrasound->echo_pending = false;
+            port_system_systick_resume();
+            port_ultrasound_set_echo_init_tick(id, NATIVE_ULTRASOUND_ECHO_INIT_TICK);
+            port_ultrasound_set_echo_end_tick(id, NATIVE_ULTRASOUND_ECHO_INIT_TICK + _native_ultrasound_echo_ticks(p_ultrasound->distance_cm));
+            port_ultrasound_set_echo_received(id, true);
+        }
+    }
+
+    if (measurement_timer_enabled && ++measurement_timer_ms >= PORT_PARKING_SENSOR_TIMEOUT_MS)
+    {
+        /* New measurement timer ISR */
+        NATIVE_TRACE_ISR("TIM5_IRQHandler", PORT_REAR_PARKING_SENSOR_ID);
+        measurement_timer_ms = 0;
+        port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    }
+}
+
+void port_ultrasound_init(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_init", ultrasound_id);
+    native_ultrasound_hw_t *p_ultrasound = _native_ultrasound_get(ultrasound_id);
+    native_ultrasound_sim_t *p_sim = _native_ultrasound_get_sim(ultrasound_id);
+
+    p_ultrasound->flags = 1U << NATIVE_ULTRASOUND_TRIGGER_READY_BIT;
+    p_ultrasound->echo_overflows = 0;
+    p_ultrasound->echo_end_tick = 0;
+    p_ultrasound->echo_init_tick = 0;
+    p_sim->trigger_timer_enabled = false;
+    p_sim->echo_timer_enabled = false;
+    p_sim->echo_pending = false;
+    measurement_timer_enabled = false;
+    measurement_timer_ms = 0;
+}
+
+void port_ultrasound_start_measurement(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_start_measurement", ultrasound_id);
+    native_ultrasound_sim_t *p_ultrasound = _native_ultrasound_get_sim(ultrasound_id);
+    _native_ultrasound_set_flag(ultrasound_id, NATIVE_ULTRASOUND_TRIGGER_READY_BIT, false);
+    p_ultrasound->echo_pending = false;
+    p_ultrasound->trigger_timer_enabled = true;
+    p_ultrasound->echo_timer_enabled = true;
+    measurement_timer_ms = 0;
+    measurement_timer_enabled = true;
+}
+
+void port_ultrasound_stop_trigger_timer(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_stop_trigger_timer", ultrasound_id);
+    _native_ultrasound_get_sim(ultrasound_id)->trigger_timer_enabled = false;
+}
+
+void port_ultrasound_stop_echo_timer(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_stop_echo_timer", ultrasound_id);
+    _native_ultrasound_get_sim(ultrasound_id)->echo_timer_enabled = false;
+}
+
+void port_ultrasound_start_new_measurement_timer(void)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_start_new_measurement_timer", 0);
+    measurement_timer_enabled = true;
+}
+
+void port_ultrasound_stop_new_measurement_timer(void)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_stop_new_measurement_timer", 0);
+    measurement_timer_enabled = false;
+}
+
+void port_ultrasound_reset_echo_ticks(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_reset_echo_ticks", ultrasound_id);
+    native_ultrasound_hw_t *p_ultrasound = _native_ultrasound_get(ultrasound_id);
+    p_ultrasound->echo_init_tick = 0;
+    p_ultrasound->echo_end_tick = 0;
+    p_ultrasound->echo_overflows = 0;
+    _native_ultrasound_set_flag(ultrasound_id, NATIVE_ULTRASOUND_ECHO_RECEIVED_BIT, false);
+}
+
+void port_ultrasound_stop_ultrasound(uint32_t ultrasound_id)
+{
+    NATIVE_TRACE_PORT_CALL("port_ultrasound_stop_ultrasound", ultrasound_id);
+    port_ultrasound_stop_trigger_timer(ultrasound_id);
+    port_ultrasound_stop_echo_timer(ultrasound_id);
+    port_ultrasound_stop_new_measurement_timer();
+    port_ultrasound_reset_echo_ticks(ultrasound_id);
+}
+
+// Getters and setters functions
+bool port_ultrasound_get_trigger_ready(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get_flag(ultrasound_id, NATIVE_ULTRASOUND_TRIGGER_READY_BIT);
+}
+
+void port_ultrasound_set_trigger_ready(uint32_t ultrasound_id, bool trigger_ready)
+{
+    _native_ultrasound_set_flag(ultrasound_id, NATIVE_ULTRASOUND_TRIGGER_READY_BIT, trigger_ready);
+}
+
+bool port_ultrasound_get_trigger_end(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get_flag(ultrasound_id, NATIVE_ULTRASOUND_TRIGGER_END_BIT);
+}
+
+void port_ultrasound_set_trigger_end(uint32_t ultrasound_id, bool trigger_end)
+{
+    _native_ultrasound_set_flag(ultrasound_id, NATIVE_ULTRASOUND_TRIGGER_END_BIT, trigger_end);
+}
+
+uint32_t port_ultrasound_get_echo_init_tick(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get(ultrasound_id)->echo_init_tick;
+}
+
+void port_ultrasound_set_echo_init_tick(uint32_t ultrasound_id, uint32_t echo_init_tick)
+{
+    _native_ultrasound_get(ultrasound_id)->echo_init_tick = echo_init_tick;
+}
+
+uint32_t port_ultrasound_get_echo_end_tick(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get(ultrasound_id)->echo_end_tick;
+}
+
+void port_ultrasound_set_echo_end_tick(uint32_t ultrasound_id, uint32_t echo_end_tick)
+{
+    _native_ultrasound_get(ultrasound_id)->echo_end_tick = echo_end_tick;
+}
+
+bool port_ultrasound_get_echo_received(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get_flag(ultrasound_id, NATIVE_ULTRASOUND_ECHO_RECEIVED_BIT);
+}
+
+void port_ultrasound_set_echo_received(uint32_t ultrasound_id, bool echo_received)
+{
+    _native_ultrasound_set_flag(ultrasound_id, NATIVE_ULTRASOUND_ECHO_RECEIVED_BIT, echo_received);
+}
+
+uint32_t port_ultrasound_get_echo_overflows(uint32_t ultrasound_id)
+{
+    return _native_ultrasound_get(ultrasound_id)->echo_overflows;
+}
+
+void port_ultrasound_set_echo_overflows(uint32_t ultrasound_id, uint32_t echo_overflows)
+{
+    _native_ultrasound_get(ultrasound_id)->echo_overflows = echo_overflows;
+}
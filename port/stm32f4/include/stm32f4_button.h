@@ -10,17 +10,167 @@
 /* Includes ------------------------------------------------------------------*/
 /* Standard C includes */
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 /* HW dependent includes */
 #include "stm32f4xx.h"
+#include "stm32f4_system.h"
+#include "port_system.h"
 
 /* Defines and enums ----------------------------------------------------------*/
 /* Defines */
+#define STM32F4_NUM_BUTTONS 1 /*!< Number of buttons connected to the STM32F4 platform (one entry of `buttons_arr[]` each, on different EXTI lines) */
 
 #define STM32F4_PARKING_BUTTON_GPIO GPIOC /*!<Button GPIO port*/
 #define STM32F4_PARKING_BUTTON_PIN 13   /*!<Button GPIO pin*/
 
+#define STM32F4_BUTTON_DEBOUNCE_TIMER TIM7      /*!< One-shot timer of the debounce of the buttons (only with `USE_HW_DEBOUNCE`) */
+#define STM32F4_BUTTON_DEBOUNCE_TICK_US 100     /*!< Step of the debounce timer in µs: the debounce time can be set up to 6.5 s */
+
+/* EXTI lines of every EXTI interrupt */
+#define STM32F4_EXTI_NUM_LINES 16U             /*!< Number of EXTI lines connected to the GPIOs */
+#define STM32F4_EXTI_LINES_9_5 0x03E0U         /*!< EXTI lines of the `EXTI9_5_IRQn` interrupt */
+#define STM32F4_EXTI_LINES_15_10 0xFC00U       /*!< EXTI lines of the `EXTI15_10_IRQn` interrupt */
+
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief Structure to define the HW dependencies of a button */
+typedef struct
+{
+    /** @brief GPIO where the button is connected */
+    GPIO_TypeDef *p_port;
+    /** @brief Pin/line where the button is connected */
+    uint8_t pin;
+    /** @brief Pull-up/pull-down mode of the button */
+    uint8_t pupd_mode;
+    /** @brief Flag to indicate that the button is pressed. Written by the EXTI ISR and polled by the FSM, hence `volatile` */
+    volatile bool flag_pressed;
+    /** @brief Tick of the latest change (`port_button_get_tick()`). Written by the EXTI ISR, or by the timer ISR with `USE_HW_DEBOUNCE`, and read by the FSM, hence `volatile` */
+    volatile uint32_t tick;
+#ifdef USE_HW_DEBOUNCE
+    /** @brief Tick of the first edge of the press or release being debounced. Written by the EXTI ISR, read by the timer ISR */
+    uint32_t edge_tick;
+#endif
+} stm32f4_button_hw_t;
+
+/* Global variables ------------------------------------------------------------*/
+extern stm32f4_button_hw_t buttons_arr[STM32F4_NUM_BUTTONS];        /*!< HW characteristics of the buttons (defined in stm32f4_button.c) */
+extern uint8_t stm32f4_button_line_ids[STM32F4_EXTI_NUM_LINES];     /*!< Button ID of every EXTI line of `stm32f4_button_lines` (defined in stm32f4_button.c) */
+extern uint32_t stm32f4_button_lines;                               /*!< Mask of the EXTI lines of the initialized buttons (defined in stm32f4_button.c) */
+#ifdef USE_HW_DEBOUNCE
+extern uint32_t stm32f4_button_debounce_lines;                      /*!< Mask of the EXTI lines masked until the debounce timer expires (defined in stm32f4_button.c) */
+#endif
+
 /* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Never defined: a call that is left after optimization stops the build (GCC `error` attribute). See `stm32f4_button_get_hw()`.
+ */
+void stm32f4_button_invalid_id(void) __attribute__((error("button ID out of range (STM32F4_NUM_BUTTONS)")));
+
+/**
+ * @brief Get the button struct with the given ID.
+ *
+ * Inlined like `stm32f4_ultrasound_get_hw()`: with a constant ID the bounds check is resolved at compile time, and an invalid ID is a build error.
+ *
+ * @param button_id Button ID.
+ *
+ * @return Pointer to the button struct.
+ * @return NULL If the button ID is not valid.
+ */
+static inline stm32f4_button_hw_t *stm32f4_button_get_hw(uint32_t button_id)
+{
+    if (__builtin_constant_p(button_id))
+    {
+        if (button_id >= STM32F4_NUM_BUTTONS)
+        {
+            stm32f4_button_invalid_id();
+        }
+        return &buttons_arr[button_id];
+    }
+    return (button_id < STM32F4_NUM_BUTTONS) ? &buttons_arr[button_id] : NULL;
+}
+
+#ifdef USE_HW_DEBOUNCE
+/**
+ * @brief Start the debounce of a button: mask its EXTI line and (re)start the debounce timer.
+ *
+ * The timer is shared by all the buttons: an edge of another button restarts it, so every button is sampled at least the debounce time after its first edge.
+ *
+ * @param p_button Button struct.
+ * @param line_mask Mask of the EXTI line of the button.
+ * @param tick System tick of the edge.
+ */
+static inline void stm32f4_button_debounce_start(stm32f4_button_hw_t *p_button, uint32_t line_mask, uint32_t tick)
+{
+    EXTI->IMR &= ~line_mask;
+    p_button->edge_tick = tick;
+    stm32f4_button_debounce_lines |= line_mask;
+    STM32F4_BUTTON_DEBOUNCE_TIMER->CNT = 0;
+    STM32F4_BUTTON_DEBOUNCE_TIMER->CR1 |= TIM_CR1_CEN;
+}
+#endif
+
+/**
+ * @brief Service the pending EXTI lines of the buttons among the lines of an EXTI interrupt.
+ *
+ * Called by the EXTI ISRs. The pending lines are walked with count-trailing-zeros, lowest line first, and `stm32f4_button_line_ids[]` gives the button of every line, so the cost depends on the number of pending lines, not on the number of buttons.
+ *
+ * Without `USE_HW_DEBOUNCE` the pressed flag of the button follows the pin (active low) and the tick of the edge is stored before the flag. With it, the line is masked and the debounce timer is started (see `stm32f4_button_debounce_isr()`).
+ *
+ * @param irq_lines Mask of the EXTI lines of the interrupt.
+ */
+static inline void stm32f4_button_exti_isr(uint32_t irq_lines)
+{
+    uint32_t pending = EXTI->PR & irq_lines & stm32f4_button_lines;
+    uint32_t tick = port_system_get_millis(); // one read for all the pending lines: their edges were latched before the ISR
+    EXTI->PR = pending;
+    while (pending != 0)
+    {
+        uint32_t line = (uint32_t)__builtin_ctz(pending);
+        uint32_t line_mask = pending & (0U - pending);
+        pending &= pending - 1U;
+        stm32f4_button_hw_t *p_button = &buttons_arr[stm32f4_button_line_ids[line]];
+#ifdef USE_HW_DEBOUNCE
+        stm32f4_button_debounce_start(p_button, line_mask, tick);
+#else
+        p_button->tick = tick; // time of the edge, not of the fire of the FSM
+        p_button->flag_pressed = (p_button->p_port->IDR & line_mask) == 0; // active low
+#endif
+    }
+}
+
+#ifdef USE_HW_DEBOUNCE
+/**
+ * @brief Sample the buttons being debounced when the debounce timer expires.
+ *
+ * Called by the ISR of the debounce timer. For every line of `stm32f4_button_debounce_lines`, if the level of the pin is not the last one reported, the change is posted with the tick of its first edge. Then the line is unmasked. An edge between the sample and the unmask is not seen by the EXTI, so it is debounced as a new one.
+ */
+static inline void stm32f4_button_debounce_isr(void)
+{
+    uint32_t lines = stm32f4_button_debounce_lines;
+    stm32f4_button_debounce_lines = 0;
+    EXTI->PR = lines; // drop the edges of the bounces
+    while (lines != 0)
+    {
+        uint32_t line = (uint32_t)__builtin_ctz(lines);
+        uint32_t line_mask = lines & (0U - lines);
+        lines &= lines - 1U;
+        stm32f4_button_hw_t *p_button = &buttons_arr[stm32f4_button_line_ids[line]];
+        bool pressed = (p_button->p_port->IDR & line_mask) == 0; // active low
+        if (pressed != p_button->flag_pressed)
+        {
+            p_button->tick = p_button->edge_tick;
+            p_button->flag_pressed = pressed;
+        }
+        EXTI->IMR |= line_mask;
+        if (((p_button->p_port->IDR & line_mask) == 0) != pressed)
+        {
+            stm32f4_button_debounce_start(p_button, line_mask, port_system_get_millis());
+        }
+    }
+}
+#endif
+
 /**
  * @brief Auxiliary function to change the GPIO and pin of a button. This function is used for testing purposes mainly although it can be used in the final implementation if needed.
  *
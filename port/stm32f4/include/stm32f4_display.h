@@ -23,5 +23,6 @@
 #define STM32F4_REAR_PARKING_DISPLAY_RGB_G_PIN 8        /*!< Green LED GPIO pin*/
 #define STM32F4_REAR_PARKING_DISPLAY_RGB_B_GPIO GPIOB   /*!< Blue LED GPIO port*/
 #define STM32F4_REAR_PARKING_DISPLAY_RGB_B_PIN 9        /*!< Blue LED GPIO pin*/
+#define STM32F4_REAR_PARKING_DISPLAY_RGB_PWM_PERIOD_MS 20 /*!< Period in ms of the PWM of the RGB LEDs (TIM4) */
 
 #endif /* STM32F4_DISPLAY_SYSTEM_H_ */
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+ * @file stm32f4_memory.h
+ * @brief Header for stm32f4_memory.c file.
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+#ifndef STM32F4_MEMORY_H_
+#define STM32F4_MEMORY_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define STM32F4_MEMORY_ISR_STACK_SIZE 1024        /*!< Bytes reserved for the stack of the interrupt service routines when the memory monitor is enabled */
+#define STM32F4_MEMORY_PAINT_PATTERN 0xC5C5C5C5U  /*!< Pattern used to paint the unused part of the stacks */
+#define STM32F4_MEMORY_PAINT_MARGIN 64            /*!< Bytes below the current stack pointer that are not painted at boot */
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Update the heap peak with the memory currently handed out by `_sbrk()`.
+ *
+ * @param heap_used Bytes between the end of the static data and the current end of the heap.
+ */
+void stm32f4_memory_heap_update(uint32_t heap_used);
+
+#endif /* STM32F4_MEMORY_H_ */
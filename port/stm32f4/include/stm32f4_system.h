@@ -20,6 +20,7 @@
  #define BIT_POS_TO_MASK(x) (0x01 << (x))                                                                      /*!< Convert the index of a bit into a mask by left shifting */
  #define BASE_MASK_TO_POS(m, p) ((m) << (p))                                                                   /*!< Move a mask defined in the LSBs to upper positions by shifting left p bits */
  #define GET_PIN_IRQN(pin) ((pin) >= 10 ? EXTI15_10_IRQn : ((pin) >= 5 ? EXTI9_5_IRQn : (EXTI0_IRQn + (pin)))) /*!< Compute the IRQ number associated to a GPIO pin */
+ #define STM32F4_SRAM_BITBAND(p_word, bit) (*(volatile uint32_t *)(SRAM1_BB_BASE + (((uint32_t)(p_word) - SRAM1_BASE) << 5) + ((uint32_t)(bit) << 2))) /*!< Bit-band alias of a bit of a word in SRAM: writing 0 or 1 changes only that bit in a single store, so it cannot undo the write of an ISR */
  
  /* GPIOs */
  #define STM32F4_GPIO_MODE_IN 0x00U  /*!< Input mode */
@@ -42,6 +43,87 @@
  #define STM32F4_AF1 0x01U /*!< Alternate function 1 */
  #define STM32F4_AF2 0x02U /*!< Alternate function 2 */
  
+ /* Clocks */
+ #ifndef HSI_VALUE
+ #define HSI_VALUE ((uint32_t)16000000) /*!< Value of the Internal oscillator in Hz */
+ #endif
+ #define STM32F4_TIMER_CLOCK_HZ HSI_VALUE /*!< Clock of the timers: the system runs from the HSI with the AHB and APB prescalers at 1 (see `SystemClock_Config()`) */
+ 
+ /* Timers: prescaler (PSC) and auto-reload (ARR) of a period, computed at compile time from `STM32F4_TIMER_CLOCK_HZ` */
+ #define STM32F4_TIMER_MAX_COUNT 65536U                                                             /*!< Number of values of the 16-bit PSC and ARR registers */
+ #define STM32F4_TIMER_MAX_ERROR_PPM 1000U                                                          /*!< Maximum error of a period obtained with `STM32F4_TIMER_PSC()` and `STM32F4_TIMER_ARR()`, in parts per million */
+ #define STM32F4_TIMER_TICKS_US(us) ((uint64_t)STM32F4_TIMER_CLOCK_HZ * (us) / 1000000U)             /*!< Timer clock ticks in a period given in µs */
+ #define STM32F4_TIMER_TICKS_MS(ms) ((uint64_t)STM32F4_TIMER_CLOCK_HZ * (ms) / 1000U)                /*!< Timer clock ticks in a period given in ms */
+ #define STM32F4_TIMER_PSC(ticks) (((ticks) - 1U) / STM32F4_TIMER_MAX_COUNT)                         /*!< Smallest prescaler for a period of `ticks` clock ticks, which gives the finest resolution */
+ #define STM32F4_TIMER_ARR(ticks) (((ticks) + (STM32F4_TIMER_PSC(ticks) + 1U) / 2U) / (STM32F4_TIMER_PSC(ticks) + 1U) - 1U) /*!< Auto-reload for a period of `ticks` clock ticks with `STM32F4_TIMER_PSC(ticks)`, rounded to the nearest value */
+ #define STM32F4_TIMER_ACTUAL_TICKS(ticks) ((STM32F4_TIMER_PSC(ticks) + 1U) * (STM32F4_TIMER_ARR(ticks) + 1U)) /*!< Clock ticks of the period actually obtained with `STM32F4_TIMER_PSC()` and `STM32F4_TIMER_ARR()` */
+ #define STM32F4_TIMER_ERROR_TICKS(ticks) (STM32F4_TIMER_ACTUAL_TICKS(ticks) > (ticks) ? STM32F4_TIMER_ACTUAL_TICKS(ticks) - (ticks) : (ticks) - STM32F4_TIMER_ACTUAL_TICKS(ticks)) /*!< Error of the period in clock ticks */
+ 
+ /**
+  * @brief Check at compile time that a timer period can be obtained from `STM32F4_TIMER_CLOCK_HZ`: it must be at least 2 ticks, fit the 16-bit prescaler and have an error below `STM32F4_TIMER_MAX_ERROR_PPM`.
+  *
+  * A change of the clock that breaks the period of a timer stops the build instead of changing its timing.
+  *
+  * @param ticks Period in clock ticks (`STM32F4_TIMER_TICKS_US()` or `STM32F4_TIMER_TICKS_MS()`).
+  * @param name Name of the period, for the error messages.
+  */
+ #define STM32F4_TIMER_STATIC_ASSERT(ticks, name)                                                                                 \
+     _Static_assert((ticks) >= 2U, name ": period shorter than 2 ticks of the timer clock");                                      \
+     _Static_assert(STM32F4_TIMER_PSC(ticks) < STM32F4_TIMER_MAX_COUNT, name ": period too long for a 16-bit prescaler");          \
+     _Static_assert(STM32F4_TIMER_ERROR_TICKS(ticks) * 1000000U <= (uint64_t)(ticks) * STM32F4_TIMER_MAX_ERROR_PPM, name ": period not accurate enough with this timer clock")
+ 
+ /**
+  * @brief Prescaler for a timer that counts in steps of `us` µs (e.g. input capture with the ARR at its maximum).
+  *
+  * Check it with `STM32F4_TIMER_TICK_STATIC_ASSERT()`.
+  */
+ #define STM32F4_TIMER_PSC_TICK_US(us) (STM32F4_TIMER_TICKS_US(us) - 1U)
+ 
+ /**
+  * @brief Check at compile time that the timer clock is a multiple of the step of a timer and that the prescaler fits in 16 bits.
+  *
+  * @param us Step of the timer in µs.
+  * @param name Name of the timer, for the error messages.
+  */
+ #define STM32F4_TIMER_TICK_STATIC_ASSERT(us, name)                                                                          \
+     _Static_assert(STM32F4_TIMER_TICKS_US(us) * 1000000U == (uint64_t)STM32F4_TIMER_CLOCK_HZ * (us), name ": the timer clock is not a multiple of the step"); \
+     _Static_assert(STM32F4_TIMER_TICKS_US(us) >= 1U && STM32F4_TIMER_PSC_TICK_US(us) < STM32F4_TIMER_MAX_COUNT, name ": step out of the range of a 16-bit prescaler")
+ 
+ /* Microsecond time base */
+ #define STM32F4_SYSTEM_MICROS_TIMER TIM6 /*!< Free-running 16-bit timer at 1 MHz of the µs time base, extended with its overflows. The 32-bit timers are taken by the ultrasound (TIM2 and TIM5) */
+ 
+ /* Alarm of the system */
+ #define STM32F4_SYSTEM_ALARM_TIMER TIM14     /*!< One-pulse 16-bit timer at 1 MHz of the alarm (`port_system_alarm_start()`). An alarm further than its range is reached in several pulses */
+ #define STM32F4_SYSTEM_ALARM_MIN_US 2U       /*!< Shortest pulse of the alarm in µs: an alarm in the past fires after it */
+ 
+ /* Global variables ------------------------------------------------------------*/
+ #ifdef USE_MICROS_TIME_BASE
+ extern volatile uint32_t stm32f4_system_micros_overflows; /*!< Overflows of `STM32F4_SYSTEM_MICROS_TIMER`: bits 16 and up of the µs time. Written by its ISR, hence `volatile` (defined in stm32f4_system.c) */
+ #endif
+ 
+ /* Function prototypes and explanation -------------------------------------------------*/
+ #ifdef USE_MICROS_TIME_BASE
+ /**
+  * @brief Count an overflow of the µs time base.
+  *
+  * Called by the ISR of `STM32F4_SYSTEM_MICROS_TIMER`, every 65.536 ms (only with `USE_MICROS_TIME_BASE`).
+  */
+ static inline void stm32f4_system_micros_isr(void)
+ {
+     STM32F4_SYSTEM_MICROS_TIMER->SR = ~TIM_SR_UIF;
+     stm32f4_system_micros_overflows++;
+ }
+ 
+ /**
+  * @brief Handle the end of a pulse of the alarm.
+  *
+  * Called by the ISR of `STM32F4_SYSTEM_ALARM_TIMER`. If the time of the alarm has not been reached yet (it was further than a pulse), it starts the next pulse.
+  *
+  * @return true If the time of the alarm has been reached: the alarm is disarmed.
+  */
+ bool stm32f4_system_alarm_isr(void);
+ #endif
+ 
  /** @verbatim
        ==============================================================================
                                ##### How to use GPIOs #####
@@ -11,12 +11,21 @@
 /* Includes ------------------------------------------------------------------*/
 /* Standard C includes */
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include "stm32f4xx.h"
 
 /* HW dependent includes */
+#include "stm32f4_system.h"
 
 /* Defines and enums ----------------------------------------------------------*/
 /* Defines */
+#define STM32F4_NUM_ULTRASOUNDS 1 /*!< Number of ultrasound sensors connected to the STM32F4 platform */
+#define STM32F4_ULTRASOUND_ECHO_TICK_US 1 /*!< Resolution in µs of the timer that measures the echo signal (TIM2) */
+
+#define STM32F4_ULTRASOUND_TRIGGER_READY_BIT 0 /*!< Bit of the flags: a new measurement can be started */
+#define STM32F4_ULTRASOUND_TRIGGER_END_BIT 1   /*!< Bit of the flags: the trigger signal has ended */
+#define STM32F4_ULTRASOUND_ECHO_RECEIVED_BIT 2 /*!< Bit of the flags: the echo signal has been received */
 
 // SI ALGO FALLA MIRAR AQUÍ
 #define STM32F4_REAR_PARKING_SENSOR_TRIGGER_GPIO GPIOB /*!< Ultrasound trigger signal GPIO port */
@@ -24,7 +33,80 @@
 #define STM32F4_REAR_PARKING_SENSOR_ECHO_GPIO GPIOA   /*!< Ultrasound echo signal GPIO port */
 #define STM32F4_REAR_PARKING_SENSOR_ECHO_PIN 1      /*!< Ultrasound echo signal GPIO pin */
 
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the state of an ultrasound sensor shared with its ISRs.
+ *
+ * Every field is written by an ISR and read by the FSM in a polling loop, so every field is `volatile`. The flags are packed in one word and every flag is written through the bit-band alias of its bit (`STM32F4_SRAM_BITBAND`), so that the FSM clearing one flag never overwrites another flag that an ISR has just set.
+ */
+typedef struct
+{
+    /** @brief Tick time when the echo signal was received */
+    volatile uint32_t echo_init_tick;
+    /** @brief Tick time when the echo signal ended */
+    volatile uint32_t echo_end_tick;
+    /** @brief Number of overflows of the echo signal */
+    volatile uint32_t echo_overflows;
+    /** @brief Flags of the sensor (`STM32F4_ULTRASOUND_*_BIT`) */
+    volatile uint32_t flags;
+} stm32f4_ultrasound_hw_t;
+
+/* Global variables ------------------------------------------------------------*/
+extern stm32f4_ultrasound_hw_t ultrasounds_arr[STM32F4_NUM_ULTRASOUNDS]; /*!< State of the ultrasounds shared with their ISRs (defined in stm32f4_ultrasound.c) */
+
 /* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Never defined: a call that is left after optimization stops the build (GCC `error` attribute). See `stm32f4_ultrasound_get_hw()`.
+ */
+void stm32f4_ultrasound_invalid_id(void) __attribute__((error("ultrasound ID out of range (STM32F4_NUM_ULTRASOUNDS)")));
+
+/**
+ * @brief Get the state shared with the ISRs of the ultrasound sensor with the given ID.
+ *
+ * The accessor is inlined so that the ISRs and the port functions reach the fields without a call. With a constant ID (as in the ISRs) the bounds check is resolved at compile time: a valid ID becomes the address of the element, and an invalid one is a build error (from `-O1` on). Other IDs are checked at run time.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ *
+ * @return Pointer to the state of the ultrasound sensor.
+ * @return NULL If the ultrasound sensor ID is not valid.
+ */
+static inline stm32f4_ultrasound_hw_t *stm32f4_ultrasound_get_hw(uint32_t ultrasound_id)
+{
+    if (__builtin_constant_p(ultrasound_id))
+    {
+        if (ultrasound_id >= STM32F4_NUM_ULTRASOUNDS)
+        {
+            stm32f4_ultrasound_invalid_id();
+        }
+        return &ultrasounds_arr[ultrasound_id];
+    }
+    return (ultrasound_id < STM32F4_NUM_ULTRASOUNDS) ? &ultrasounds_arr[ultrasound_id] : NULL;
+}
+
+/**
+ * @brief Get a flag of an ultrasound sensor.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ * @param bit Bit of the flag (`STM32F4_ULTRASOUND_*_BIT`).
+ * @return bool Value of the flag.
+ */
+static inline bool stm32f4_ultrasound_get_flag(uint32_t ultrasound_id, uint32_t bit)
+{
+    return (stm32f4_ultrasound_get_hw(ultrasound_id)->flags >> bit) & 1U;
+}
+
+/**
+ * @brief Set a flag of an ultrasound sensor with a single store to its bit-band alias.
+ *
+ * @param ultrasound_id Ultrasound sensor ID.
+ * @param bit Bit of the flag (`STM32F4_ULTRASOUND_*_BIT`).
+ * @param value New value of the flag.
+ */
+static inline void stm32f4_ultrasound_set_flag(uint32_t ultrasound_id, uint32_t bit, bool value)
+{
+    STM32F4_SRAM_BITBAND(&stm32f4_ultrasound_get_hw(ultrasound_id)->flags, bit) = value;
+}
+
 /**
  * @brief Auxiliary function to change the GPIO and pin of the trigger pin of an ultrasound transceiver. This function is used for testing purposes mainly although it can be used in the final implementation if needed.
  *
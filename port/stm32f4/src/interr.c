@@ -18,6 +18,9 @@
 //------------------------------------------------------
 // INTERRUPT SERVICE ROUTINES
 //------------------------------------------------------
+// The ISRs reach the state of the buttons and of the ultrasound through the inline functions of their
+// stm32f4_*.h headers: every access is a direct load or store, with no call. The buttons are found from
+// their EXTI lines with a table; the ultrasound has a constant ID.
 /**
  * @brief Interrupt service routine for the System tick timer (SysTick).
  *
@@ -39,6 +42,63 @@ void SysTick_Handler(void)
     port_system_set_millis(milli + 1);
 }
 
+/**
+ * @brief This function handles Px0 global interrupts.
+ *
+ The EXTI ISRs service every pending line of the buttons of their interrupt with `stm32f4_button_exti_isr()`: a table gives the button of every line, so one pass handles all the buttons, whatever their number.
+ *
+ */
+void EXTI0_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(BIT_POS_TO_MASK(0));
+}
+
+/**
+ * @brief This function handles Px1 global interrupts.
+ */
+void EXTI1_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(BIT_POS_TO_MASK(1));
+}
+
+/**
+ * @brief This function handles Px2 global interrupts.
+ */
+void EXTI2_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(BIT_POS_TO_MASK(2));
+}
+
+/**
+ * @brief This function handles Px3 global interrupts.
+ */
+void EXTI3_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(BIT_POS_TO_MASK(3));
+}
+
+/**
+ * @brief This function handles Px4 global interrupts.
+ */
+void EXTI4_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(BIT_POS_TO_MASK(4));
+}
+
+/**
+ * @brief This function handles Px5-Px9 global interrupts.
+ */
+void EXTI9_5_IRQHandler(void)
+{
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_exti_isr(STM32F4_EXTI_LINES_9_5);
+}
+
 /**
  * @brief This function handles Px10-Px15 global interrupts.
  *
@@ -48,21 +108,50 @@ void SysTick_Handler(void)
 void EXTI15_10_IRQHandler(void)
 {
     port_system_systick_resume(); // Resume SysTick interrupt
-    // ISR parking button
-    if (port_button_get_pending_interrupt(PORT_PARKING_BUTTON_ID))
+    stm32f4_button_exti_isr(STM32F4_EXTI_LINES_15_10); // ISR of the parking button (PC13) and of any other button on these lines
+}
+
+#ifdef USE_MICROS_TIME_BASE
+/**
+ * @brief Interrupt service routine for the TIM6 timer (only with `USE_MICROS_TIME_BASE`).
+ *
+ This free-running timer is the µs time base of the system (`port_system_get_micros()`). It overflows every 65.536 ms, and the ISR counts the overflow to extend its 16 bits. It does not resume the SysTick: an overflow during the sleep is not an activity of the system.
+ *
+ */
+void TIM6_DAC_IRQHandler(void)
+{
+    stm32f4_system_micros_isr();
+}
+
+/**
+ * @brief Interrupt service routine for the TIM14 timer (only with `USE_MICROS_TIME_BASE`).
+ *
+ This one-pulse timer is the alarm of the system (`port_system_alarm_start()`), which wakes the CPU for the software timers. When the time of the alarm is reached the main loop must run: the SysTick is resumed. The pulses of an alarm further than the range of the timer only start the next pulse.
+ *
+ */
+void TIM8_TRG_COM_TIM14_IRQHandler(void)
+{
+    if (stm32f4_system_alarm_isr())
     {
-        bool gpio_user = port_button_get_value(PORT_PARKING_BUTTON_ID);
-        if (gpio_user)
-        {
-            port_button_set_pressed(PORT_PARKING_BUTTON_ID, false); // no presionado
-        }
-        else
-        {
-            port_button_set_pressed(PORT_PARKING_BUTTON_ID, true); // presionado
-        }
-        port_button_clear_pending_interrupt(PORT_PARKING_BUTTON_ID);
+        port_system_systick_resume(); // Resume SysTick interrupt
     }
 }
+#endif
+
+#ifdef USE_HW_DEBOUNCE
+/**
+ * @brief Interrupt service routine for the TIM7 timer (only with `USE_HW_DEBOUNCE`).
+ *
+ This one-shot timer is started by the first edge of a press or a release of a button. When it expires the contacts are stable: `stm32f4_button_debounce_isr()` samples the pins of the buttons being debounced, posts their changes with the tick of their first edge and unmasks their EXTI lines.
+ *
+ */
+void TIM7_IRQHandler(void)
+{
+    STM32F4_BUTTON_DEBOUNCE_TIMER->SR = ~TIM_SR_UIF;
+    port_system_systick_resume(); // Resume SysTick interrupt
+    stm32f4_button_debounce_isr();
+}
+#endif
 
 /**
  * @brief Interrupt service routine for the TIM3 timer.
@@ -73,7 +162,7 @@ This timer controls the duration of the trigger signal of the ultrasound sensor.
 void TIM3_IRQHandler(void)
 {
     TIM3->SR &= ~TIM_SR_UIF;
-    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    stm32f4_ultrasound_set_flag(PORT_REAR_PARKING_SENSOR_ID, STM32F4_ULTRASOUND_TRIGGER_END_BIT, true);
 }
 
 /**
@@ -85,28 +174,27 @@ This timer controls the duration of the echo signal of the ultrasound sensor by
 void TIM2_IRQHandler(void)
 {
     port_system_systick_resume(); // Resume SysTick interrupt
-    
-    uint32_t overflows = port_ultrasound_get_echo_overflows(PORT_REAR_PARKING_SENSOR_ID);
-    uint32_t echo_init_tick = port_ultrasound_get_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID);
-    uint32_t echo_end_tick = port_ultrasound_get_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID);
+
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(PORT_REAR_PARKING_SENSOR_ID);
+    uint32_t echo_init_tick = p_ultrasound->echo_init_tick;
+    uint32_t echo_end_tick = p_ultrasound->echo_end_tick;
 
     if (TIM2->SR & TIM_SR_UIF)
     {
         TIM2->SR &= ~TIM_SR_UIF;
-        overflows++;
-        port_ultrasound_set_echo_overflows(PORT_REAR_PARKING_SENSOR_ID, overflows);
+        p_ultrasound->echo_overflows++;
     }
 
     if ((TIM2->SR & TIM_SR_CC2IF) != 0)
     {
         if (echo_init_tick == 0 && echo_end_tick == 0)
         {
-            port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, TIM2->CCR2);
+            p_ultrasound->echo_init_tick = TIM2->CCR2;
         }
         else
         {
-            port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, TIM2->CCR2);
-            port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+            p_ultrasound->echo_end_tick = TIM2->CCR2;
+            stm32f4_ultrasound_set_flag(PORT_REAR_PARKING_SENSOR_ID, STM32F4_ULTRASOUND_ECHO_RECEIVED_BIT, true);
         }
     }
 }
@@ -120,5 +208,5 @@ void TIM2_IRQHandler(void)
 void TIM5_IRQHandler(void)
 {
     TIM5->SR &= ~TIM_SR_UIF;
-    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    stm32f4_ultrasound_set_flag(PORT_REAR_PARKING_SENSOR_ID, STM32F4_ULTRASOUND_TRIGGER_READY_BIT, true);
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+/**
+ * @file stm32f4_boot.c
+ * @brief Portable functions of the time base of the boot report for the STM32F4 platform. All portable functions must be implemented in this file.
+ *
+ * The time base is the cycle counter of the DWT, which runs at the core clock from reset on, without any interrupt. At 16 MHz it wraps around after 268 s. The ticks are the raw cycles, so the differences are right across the wrap-around; they are only divided into µs afterwards.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* HW dependent includes */
+#include "port_boot.h"
+
+/* Microcontroller dependent includes */
+#include "stm32f4_system.h"
+
+/* Public functions -----------------------------------------------------------*/
+void port_boot_timer_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; /* Enable the DWT */
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; /* Start the cycle counter */
+}
+
+uint32_t port_boot_timer_get_ticks(void)
+{
+    return DWT->CYCCNT;
+}
+
+uint32_t port_boot_timer_ticks_to_us(uint32_t ticks)
+{
+    return ticks / (HSI_VALUE / 1000000U); /* The core runs at the HSI */
+}
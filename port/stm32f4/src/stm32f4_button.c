@@ -19,26 +19,15 @@
 #include "stm32f4_system.h" // Used to interact with the GPIOs
 #include "stm32f4_button.h" // Used to interact with the button FSM library
 
-/* Typedefs --------------------------------------------------------------------*/
-/** @brief Structure to define the HW dependencies of a button */
-typedef struct
-{
-    /** @brief GPIO where the button is connected */
-    GPIO_TypeDef *p_port;
-    /** @brief Pin/line where the button is connected */
-    uint8_t pin;
-    /** @brief Pull-up/pull-down mode of the button */
-    uint8_t pupd_mode;
-    /** @brief Flag to indicate that the button is pressed */
-    bool flag_pressed;
-} stm32f4_button_hw_t;
+/* Defines --------------------------------------------------------------------*/
+STM32F4_TIMER_TICK_STATIC_ASSERT(STM32F4_BUTTON_DEBOUNCE_TICK_US, "TIM7 (button debounce)");
 
 /* Global variables ------------------------------------------------------------*/
 /**
  * @brief Array of elements that represents the HW characteristics of the buttons connected to the STM32F4 platform. 
  * 
  */
-static stm32f4_button_hw_t buttons_arr[] = {
+stm32f4_button_hw_t buttons_arr[STM32F4_NUM_BUTTONS] = {
     [PORT_PARKING_BUTTON_ID] = {
         .p_port = STM32F4_PARKING_BUTTON_GPIO, 
         .pin = STM32F4_PARKING_BUTTON_PIN, 
@@ -46,33 +35,17 @@ static stm32f4_button_hw_t buttons_arr[] = {
     }
 };
 
-/* Private functions ----------------------------------------------------------*/
-/**
- * @brief Get the button status struct with the given ID.
- *
- * @param button_id Button ID.
- *
- * @return Pointer to the button state struct.
- * @return NULL If the button ID is not valid.
- */
-stm32f4_button_hw_t *_stm32f4_button_get(uint32_t button_id)
-{
-    // Return the pointer to the button with the given ID. If the ID is not valid, return NULL.
-    if (button_id < sizeof(buttons_arr) / sizeof(buttons_arr[0]))
-    {
-        return &buttons_arr[button_id];
-    }
-    else
-    {
-        return NULL;
-    }
-}
+uint8_t stm32f4_button_line_ids[STM32F4_EXTI_NUM_LINES]; /* Only the entries of stm32f4_button_lines are valid */
+uint32_t stm32f4_button_lines = 0;
+#ifdef USE_HW_DEBOUNCE
+uint32_t stm32f4_button_debounce_lines = 0;
+#endif
 
 /* Public functions -----------------------------------------------------------*/
 void port_button_init(uint32_t button_id)
 {
-    // Retrieve the button struct using the private function and the button ID
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    // Retrieve the button struct using the inline accessor and the button ID
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
 
 
     /* TO-DO alumnos */
@@ -80,39 +53,63 @@ void port_button_init(uint32_t button_id)
     stm32f4_system_gpio_config(p_button->p_port, p_button->pin, STM32F4_GPIO_MODE_IN, p_button->pupd_mode);
     // 2. Enable the external interruption of the GPIO
     stm32f4_system_gpio_config_exti(p_button->p_port, p_button->pin, STM32F4_TRIGGER_BOTH_EDGE | STM32F4_TRIGGER_ENABLE_INTERR_REQ);
-    // 3. Enable the interruption of the GPIO
+    // 3. Register the EXTI line of the button for the dispatch of the EXTI ISRs and enable the interruption of the GPIO
+    stm32f4_button_line_ids[p_button->pin] = (uint8_t)button_id;
+    stm32f4_button_lines |= BIT_POS_TO_MASK(p_button->pin);
     stm32f4_system_gpio_exti_enable(p_button->pin, 1, 0);
+#ifdef USE_HW_DEBOUNCE
+    // 4. Configure the one-shot debounce timer: it counts once up to the auto-reload and stops
+    RCC->APB1ENR |= RCC_APB1ENR_TIM7EN;
+    STM32F4_BUTTON_DEBOUNCE_TIMER->CR1 = TIM_CR1_OPM | TIM_CR1_URS; // one pulse; only the overflow raises the interrupt
+    STM32F4_BUTTON_DEBOUNCE_TIMER->PSC = (uint32_t)STM32F4_TIMER_PSC_TICK_US(STM32F4_BUTTON_DEBOUNCE_TICK_US);
+    STM32F4_BUTTON_DEBOUNCE_TIMER->ARR = (uint32_t)(PORT_PARKING_BUTTON_DEBOUNCE_TIME_MS * 1000U / STM32F4_BUTTON_DEBOUNCE_TICK_US - 1U);
+    STM32F4_BUTTON_DEBOUNCE_TIMER->EGR = TIM_EGR_UG; // load the prescaler
+    STM32F4_BUTTON_DEBOUNCE_TIMER->SR = ~TIM_SR_UIF;
+    STM32F4_BUTTON_DEBOUNCE_TIMER->DIER |= TIM_DIER_UIE;
+    NVIC_SetPriority(TIM7_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 1, 1)); // same preemption priority as the EXTI of the buttons: they do not preempt each other
+    NVIC_EnableIRQ(TIM7_IRQn);
+    p_button->flag_pressed = false;
+#endif
+    p_button->tick = 0;
 }
 
 
 void stm32f4_button_set_new_gpio(uint32_t button_id, GPIO_TypeDef *p_port, uint8_t pin)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
+    uint32_t old_mask = BIT_POS_TO_MASK(p_button->pin);
+    if ((stm32f4_button_lines & old_mask) && stm32f4_button_line_ids[p_button->pin] == button_id)
+    {
+        // Move the registered line of the button to the new pin
+        stm32f4_button_lines &= ~old_mask;
+        stm32f4_button_line_ids[pin] = (uint8_t)button_id;
+        stm32f4_button_lines |= BIT_POS_TO_MASK(pin);
+    }
     p_button->p_port = p_port;
     p_button->pin = pin;
 }
 
 bool port_button_get_pressed(uint32_t button_id)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
     return p_button->flag_pressed;
 }
 
 bool port_button_get_value(uint32_t button_id)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
     return stm32f4_system_gpio_read(p_button->p_port, p_button->pin);
 }
 
 void port_button_set_pressed(uint32_t button_id, bool pressed)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
     p_button->flag_pressed = pressed;
 }
 
 bool port_button_get_pending_interrupt(uint32_t button_id)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
     uint8_t mipin = p_button->pin;
     return (EXTI->PR & (1 << mipin));
     //return stm32f4_system_gpio_read(p_button->p_port, p_button->pin);
@@ -120,12 +117,46 @@ bool port_button_get_pending_interrupt(uint32_t button_id)
 
 void port_button_clear_pending_interrupt(uint32_t button_id)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
     EXTI->PR = BIT_POS_TO_MASK(p_button->pin);
 }
 
 void port_button_disable_interrupts(uint32_t button_id)
 {
-    stm32f4_button_hw_t *p_button = _stm32f4_button_get(button_id);
-    stm32f4_system_gpio_exti_disable(p_button->pin);
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
+    uint32_t line_mask = BIT_POS_TO_MASK(p_button->pin);
+    // Mask only the line of the button: the other buttons may share its EXTI interrupt
+    EXTI->IMR &= ~line_mask;
+    stm32f4_button_lines &= ~line_mask;
+#ifdef USE_HW_DEBOUNCE
+    stm32f4_button_debounce_lines &= ~line_mask;
+#endif
+}
+
+#ifdef USE_HW_DEBOUNCE
+void port_button_set_debounce_time_ms(uint32_t button_id, uint32_t debounce_time_ms)
+{
+    uint32_t ticks = debounce_time_ms * 1000U / STM32F4_BUTTON_DEBOUNCE_TICK_US;
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+    else if (ticks > STM32F4_TIMER_MAX_COUNT)
+    {
+        ticks = STM32F4_TIMER_MAX_COUNT;
+    }
+    STM32F4_BUTTON_DEBOUNCE_TIMER->ARR = ticks - 1U; // one timer for all the buttons: the last time set is used
+}
+#endif
+
+uint32_t port_button_get_tick(uint32_t button_id)
+{
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
+    return p_button->tick;
+}
+
+void port_button_set_tick(uint32_t button_id, uint32_t tick)
+{
+    stm32f4_button_hw_t *p_button = stm32f4_button_get_hw(button_id);
+    p_button->tick = tick;
 }
@@ -8,7 +8,6 @@
 
 /* Standard C includes */
 #include <stdio.h>
-#include <math.h>
 
 /* HW dependent includes */
 #include "port_display.h"
@@ -19,6 +18,9 @@
 #include "stm32f4_system.h"
 
 /* Defines --------------------------------------------------------------------*/
+#define STM32F4_DISPLAY_PWM_TICKS STM32F4_TIMER_TICKS_MS(STM32F4_REAR_PARKING_DISPLAY_RGB_PWM_PERIOD_MS) /*!< Timer clock ticks of the PWM period (TIM4) */
+
+STM32F4_TIMER_STATIC_ASSERT(STM32F4_DISPLAY_PWM_TICKS, "TIM4 (display PWM)");
 
 /* Typedefs --------------------------------------------------------------------*/
 /** @brief Structure to define the HW dependencies of a display 
@@ -28,21 +30,21 @@ typedef struct
 {
     /** @brief GPIO where the RED LED is connected*/
     GPIO_TypeDef *p_port_red;  
-    /** @brief Pin where the RED LED is connected*/
-    uint8_t pin_red;         
     /** @brief GPIO where the GREEN LED is connected*/
     GPIO_TypeDef *p_port_green; 
-    /** @brief Pin where the GREEN LED is connected*/
-    uint8_t pin_green;      
     /** @brief GPIO where the BLUE LED is connected*/
     GPIO_TypeDef *p_port_blue; 
+    /** @brief Pin where the RED LED is connected*/
+    uint8_t pin_red;         
+    /** @brief Pin where the GREEN LED is connected*/
+    uint8_t pin_green;      
     /** @brief Pin where the BLUE LED is connected*/
     uint8_t pin_blue;       
 } stm32f4_display_hw_t;
 
 /* Global variables */
-/** @brief Array of elements that represents the HW characteristics of the RGB LED of the display systems connected to the STM32F4 platform */
-static stm32f4_display_hw_t displays_arr[] = {
+/** @brief Array of elements that represents the HW characteristics of the RGB LED of the display systems connected to the STM32F4 platform. It never changes, so it is kept in flash. */
+static const stm32f4_display_hw_t displays_arr[] = {
     [PORT_REAR_PARKING_DISPLAY_ID] = {
         .p_port_red = STM32F4_REAR_PARKING_DISPLAY_RGB_R_GPIO, 
         .pin_red = STM32F4_REAR_PARKING_DISPLAY_RGB_R_PIN,
@@ -56,9 +58,9 @@ static stm32f4_display_hw_t displays_arr[] = {
  * @brief Get the display struct with the given ID. 
  * 
  * @param display_id Button ID.
- * @return stm32f4_display_hw_t* NULL If the display ID is not valid. 
+ * @return const stm32f4_display_hw_t* NULL If the display ID is not valid. 
  */
-stm32f4_display_hw_t *_stm32f4_display_get(uint32_t display_id)
+const stm32f4_display_hw_t *_stm32f4_display_get(uint32_t display_id)
 {
     // Return the pointer to the display with the given ID. If the ID is not valid, return NULL.
     // TO-DO alumnos
@@ -89,8 +91,8 @@ void _timer_pwm_config(uint32_t display_id)
         TIM4->CR1 &= ~TIM_CR1_CEN;          // Disable the TIM4 counter
         TIM4->CR1 |= TIM_CR1_ARPE;          // Enable auto-reload preload
         TIM4->CNT = 0;                      // Reset the counter
-        TIM4->ARR = 0xFFFF;                 // Set the auto-reload value to maximum
-        TIM4->PSC = 4;                      // Set the prescaler to 4
+        TIM4->ARR = (uint32_t)STM32F4_TIMER_ARR(STM32F4_DISPLAY_PWM_TICKS); // Set the auto-reload value of the PWM period (computed at compile time)
+        TIM4->PSC = (uint32_t)STM32F4_TIMER_PSC(STM32F4_DISPLAY_PWM_TICKS); // Set the prescaler of the PWM period
 
         TIM4->CCER &= ~TIM_CCER_CC1E; // Disable the output compare for channel 1
         //(TIM4->CCER &= ~TIM_CCER_CC2E; // Disable the output compare for channel 2 no es necesario
@@ -148,8 +150,7 @@ void port_display_set_rgb(uint32_t display_id, rgb_color_t color)
                 else
                 {
                     TIM4->CCER |= TIM_CCER_CC1E;      // Enable the output compare for channel 1
-                    double r = color.r * TIM4->ARR / 255;   
-                    TIM4->CCR1 = round(r); // Set the duty cycle for channel 1
+                    TIM4->CCR1 = color.r * TIM4->ARR / PORT_DISPLAY_RGB_MAX_VALUE; // Set the duty cycle for channel 1
                 }
 
                 if (color.g == 0)
@@ -159,8 +160,7 @@ void port_display_set_rgb(uint32_t display_id, rgb_color_t color)
                 else
                 {
                     TIM4->CCER |= TIM_CCER_CC3E;      // Enable the output compare for channel 3
-                    double g = color.g * TIM4->ARR / 255;
-                    TIM4->CCR3 = round(g); // Set the duty cycle for channel 3
+                    TIM4->CCR3 = color.g * TIM4->ARR / PORT_DISPLAY_RGB_MAX_VALUE; // Set the duty cycle for channel 3
                 }
 
                 if (color.b == 0)
@@ -170,8 +170,7 @@ void port_display_set_rgb(uint32_t display_id, rgb_color_t color)
                 else
                 {
                     TIM4->CCER |= TIM_CCER_CC4E;      // Enable the output compare for channel 4
-                    double b = color.b * TIM4->ARR / 255;
-                    TIM4->CCR4 = round(b); // Set the duty cycle for channel 4
+                    TIM4->CCR4 = color.b * TIM4->ARR / PORT_DISPLAY_RGB_MAX_VALUE; // Set the duty cycle for channel 4
                 }
 
                 TIM4->EGR |= TIM_EGR_UG;  // Generate an update event to load the new values
@@ -189,7 +188,7 @@ void port_display_set_rgb(uint32_t display_id, rgb_color_t color)
 void port_display_init(uint32_t display_id)
 {
     // Retrieve the display struct using the private function and the display ID
-    stm32f4_display_hw_t *p_display = _stm32f4_display_get(display_id);
+    const stm32f4_display_hw_t *p_display = _stm32f4_display_get(display_id);
 
     stm32f4_system_gpio_config(p_display->p_port_red, p_display->pin_red, STM32F4_GPIO_MODE_AF, STM32F4_GPIO_PUPDR_NOPULL);
     stm32f4_system_gpio_config(p_display->p_port_green, p_display->pin_green, STM32F4_GPIO_MODE_AF, STM32F4_GPIO_PUPDR_NOPULL);
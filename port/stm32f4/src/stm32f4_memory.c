@@ -0,0 +1,254 @@
+/**
+ * @file stm32f4_memory.c
+ * @brief Portable functions to monitor the RAM usage of the STM32F4 platform. All portable functions must be implemented in this file.
+ *
+ * When `USE_MEMORY_MONITOR` is defined, `port_memory_init()` moves the thread mode to the process stack (PSP) and gives the interrupt service routines their own main stack (MSP), so that the high-water mark of each context can be measured separately by stack painting.
+ *
+ * When `USE_NO_HEAP` is defined, the executable is linked with `--wrap` for every function of the allocator of the C library (see the root `CMakeLists.txt`), and this file provides the `__wrap_` stubs: they never hand out memory, so the allocator is not linked at all. The C library copes with it: `stdout` falls back to unbuffered output when it cannot allocate its buffer.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdbool.h>
+#if defined(USE_SEMIHOSTING) && !defined(USE_NO_HEAP)
+#include <malloc.h>
+#endif
+#ifdef USE_NO_HEAP
+#include <stddef.h>
+#include <errno.h>
+#include <reent.h>
+#endif
+
+/* HW dependent includes */
+#include "port_memory.h"
+#include "port_system.h"
+
+/* Microcontroller dependent includes */
+#include "stm32f4xx.h"
+#include "stm32f4_memory.h"
+
+/* Linker symbols -------------------------------------------------------------*/
+extern uint32_t _estack;        /*!< Top of the main stack (defined in the linker script) */
+extern uint32_t _Min_Stack_Size; /*!< Size of the main stack reservation (defined in the linker script) */
+extern char end;                /*!< End of the static data, start of the heap (defined in the linker script) */
+
+/* Global variables -----------------------------------------------------------*/
+static uint32_t heap_peak = 0; /*!< Maximum number of bytes handed out by `_sbrk()` */
+
+#ifdef USE_MEMORY_MONITOR
+/** @brief Stack used by the interrupt service routines (MSP) once the memory monitor is started. */
+static uint32_t isr_stack[STM32F4_MEMORY_ISR_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+#endif
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Get the bottom (lowest address) of the main stack reservation.
+ *
+ * @return uint32_t* Pointer to the lowest word of the main stack.
+ */
+static uint32_t *_stm32f4_memory_main_stack_bottom(void)
+{
+    return (uint32_t *)((uint32_t)&_estack - (uint32_t)&_Min_Stack_Size);
+}
+
+/**
+ * @brief Fill a memory region with the paint pattern.
+ *
+ * @param p_from First word of the region.
+ * @param p_to Word after the last one of the region.
+ */
+static void _stm32f4_memory_paint(uint32_t *p_from, uint32_t *p_to)
+{
+    while (p_from < p_to)
+    {
+        *p_from++ = STM32F4_MEMORY_PAINT_PATTERN;
+    }
+}
+
+/**
+ * @brief Compute the number of bytes of a painted stack that have been used.
+ *
+ * The stack grows downwards, so the region is scanned from its bottom until the first word that does not hold the paint pattern.
+ *
+ * @param p_bottom Lowest word of the stack.
+ * @param p_top Word after the highest one of the stack.
+ * @return uint32_t Maximum depth of the stack in bytes.
+ */
+static uint32_t _stm32f4_memory_high_water(uint32_t *p_bottom, uint32_t *p_top)
+{
+    uint32_t *p_word = p_bottom;
+    while (p_word < p_top && *p_word == STM32F4_MEMORY_PAINT_PATTERN)
+    {
+        p_word++;
+    }
+    return (uint32_t)p_top - (uint32_t)p_word;
+}
+
+/* Public functions -----------------------------------------------------------*/
+void stm32f4_memory_heap_update(uint32_t heap_used)
+{
+    if (heap_used > heap_peak)
+    {
+        heap_peak = heap_used;
+    }
+}
+
+void port_memory_init(void)
+{
+#ifdef USE_MEMORY_MONITOR
+    __disable_irq();
+
+    /* Thread mode keeps running on the same stack, now through the PSP */
+    __set_PSP(__get_MSP());
+    __set_CONTROL(__get_CONTROL() | CONTROL_SPSEL_Msk);
+    __ISB();
+
+    /* The MSP is only used by the ISRs from now on */
+    _stm32f4_memory_paint(isr_stack, &isr_stack[sizeof(isr_stack) / sizeof(isr_stack[0])]);
+    __set_MSP((uint32_t)&isr_stack[sizeof(isr_stack) / sizeof(isr_stack[0])]);
+
+    /* Paint the free part of the main stack leaving a margin for the current frame */
+    _stm32f4_memory_paint(_stm32f4_memory_main_stack_bottom(), (uint32_t *)(__get_PSP() - STM32F4_MEMORY_PAINT_MARGIN));
+
+    __enable_irq();
+#endif
+}
+
+void port_memory_get_report(port_memory_report_t *p_report)
+{
+    uint32_t *p_main_bottom = _stm32f4_memory_main_stack_bottom();
+
+    p_report->main_stack_size = (uint32_t)&_Min_Stack_Size;
+    p_report->heap_size = (uint32_t)p_main_bottom - (uint32_t)&end;
+
+#if defined(USE_SEMIHOSTING) && !defined(USE_NO_HEAP)
+    /* The semihosting library provides its own _sbrk(), ask the allocator instead. It never trims the heap, so the arena is the peak */
+    stm32f4_memory_heap_update(mallinfo().arena);
+#endif
+    p_report->heap_peak = heap_peak;
+
+#ifdef USE_MEMORY_MONITOR
+    p_report->main_stack_max_used = _stm32f4_memory_high_water(p_main_bottom, &_estack);
+    p_report->isr_stack_size = sizeof(isr_stack);
+    p_report->isr_stack_max_used = _stm32f4_memory_high_water(isr_stack, &isr_stack[sizeof(isr_stack) / sizeof(isr_stack[0])]);
+#else
+    p_report->main_stack_max_used = 0;
+    p_report->isr_stack_size = 0;
+    p_report->isr_stack_max_used = 0;
+#endif
+}
+
+void port_memory_print_report(void)
+{
+    port_memory_report_t report;
+    port_memory_get_report(&report);
+
+    printf("[MEMORY][%ld] Main stack: %ld/%ld bytes\n", port_system_get_millis(), report.main_stack_max_used, report.main_stack_size);
+    printf("[MEMORY][%ld] ISR stack: %ld/%ld bytes\n", port_system_get_millis(), report.isr_stack_max_used, report.isr_stack_size);
+    printf("[MEMORY][%ld] Heap peak: %ld/%ld bytes\n", port_system_get_millis(), report.heap_peak, report.heap_size);
+}
+
+#ifdef USE_NO_HEAP
+/* Allocator stubs (no-heap build) --------------------------------------------*/
+/**
+ * @brief Stub of `malloc()` in the no-heap build: no memory is ever handed out.
+ *
+ * @param size Requested bytes.
+ * @return void* Always `NULL`.
+ */
+void *__wrap_malloc(size_t size)
+{
+    errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of `calloc()` in the no-heap build: no memory is ever handed out.
+ *
+ * @param count Number of elements.
+ * @param size Bytes of each element.
+ * @return void* Always `NULL`.
+ */
+void *__wrap_calloc(size_t count, size_t size)
+{
+    errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of `realloc()` in the no-heap build: no memory is ever handed out.
+ *
+ * @param p_memory Memory to resize (always `NULL`, as nothing is ever handed out).
+ * @param size Requested bytes.
+ * @return void* Always `NULL`.
+ */
+void *__wrap_realloc(void *p_memory, size_t size)
+{
+    errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of `free()` in the no-heap build.
+ *
+ * @param p_memory Memory to release (always `NULL`, as nothing is ever handed out).
+ */
+void __wrap_free(void *p_memory)
+{
+}
+
+/**
+ * @brief Stub of the reentrant `_malloc_r()` used inside the C library (e.g. by `stdio` for its buffers).
+ *
+ * @param p_reent Reentrancy structure of the caller.
+ * @param size Requested bytes.
+ * @return void* Always `NULL`.
+ */
+void *__wrap__malloc_r(struct _reent *p_reent, size_t size)
+{
+    p_reent->_errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of the reentrant `_calloc_r()` used inside the C library.
+ *
+ * @param p_reent Reentrancy structure of the caller.
+ * @param count Number of elements.
+ * @param size Bytes of each element.
+ * @return void* Always `NULL`.
+ */
+void *__wrap__calloc_r(struct _reent *p_reent, size_t count, size_t size)
+{
+    p_reent->_errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of the reentrant `_realloc_r()` used inside the C library.
+ *
+ * @param p_reent Reentrancy structure of the caller.
+ * @param p_memory Memory to resize (always `NULL`, as nothing is ever handed out).
+ * @param size Requested bytes.
+ * @return void* Always `NULL`.
+ */
+void *__wrap__realloc_r(struct _reent *p_reent, void *p_memory, size_t size)
+{
+    p_reent->_errno = ENOMEM;
+    return NULL;
+}
+
+/**
+ * @brief Stub of the reentrant `_free_r()` used inside the C library.
+ *
+ * @param p_reent Reentrancy structure of the caller.
+ * @param p_memory Memory to release (always `NULL`, as nothing is ever handed out).
+ */
+void __wrap__free_r(struct _reent *p_reent, void *p_memory)
+{
+}
+#endif
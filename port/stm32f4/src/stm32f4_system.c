@@ -7,6 +7,7 @@
 
 /* HW dependent includes */
 #include "port_system.h"
+#include "port_memory.h"
 #include "stm32f4_system.h"
 
 #ifdef USE_SEMIHOSTING
@@ -16,7 +17,6 @@ extern void initialise_monitor_handles(void);
 //------------------------------------------------------
 // FILE-SPECIFIC DEFINITIONS
 //------------------------------------------------------
-#define HSI_VALUE ((uint32_t)16000000) /*!< Value of the Internal oscillator in Hz */
 /* Timer configuration */
 #define RCC_HSI_CALIBRATION_DEFAULT 0x10U            /*!< Default HSI calibration trimming value */
 #define TICK_FREQ_1KHZ 1U                            /*!< Frequency in kHz of the System tick */
@@ -31,10 +31,23 @@ extern void initialise_monitor_handles(void);
 // PRIVATE (STATIC) VARIABLES
 //------------------------------------------------------
 static volatile uint32_t msTicks = 0; /*!< Variable to store millisecond ticks. @warning **It must be declared volatile!** Just because it is modified in an ISR. **Add it to the definition** after *static*. */
+static volatile uint32_t msTicksHigh = 0; /*!< High word of the 64-bit millisecond ticks: number of wrap-arounds of `msTicks`. Written by the SysTick ISR, hence `volatile` */
+
+#ifdef USE_MICROS_TIME_BASE
+static volatile uint64_t alarm_us = 0;     /*!< Time of the alarm of the system in µs. Read by the ISR of the alarm, hence `volatile` */
+static uint32_t tickless_rem_us = 0;       /*!< Fraction of a millisecond slept by `port_system_sleep_tickless()` and not added yet to the millisecond time */
+static volatile bool alarm_armed = false;  /*!< Flag to indicate that the alarm of the system is armed */
+#endif
+
+STM32F4_TIMER_TICK_STATIC_ASSERT(1, "TIM6 (µs time base)");
+STM32F4_TIMER_TICK_STATIC_ASSERT(1, "TIM14 (alarm)");
 
 //------------------------------------------------------
 // PUBLIC (GLOBAL) VARIABLES
 //------------------------------------------------------
+#ifdef USE_MICROS_TIME_BASE
+volatile uint32_t stm32f4_system_micros_overflows = 0;
+#endif
 
 /* These variables are declared extern in CMSIS (system_stm32f4xx.h) */
 uint32_t SystemCoreClock = HSI_VALUE;                                               /*!< Frequency of the System clock */
@@ -103,9 +116,11 @@ static void system_clock_config(void)
 void SystemInit(void)
 {
 /* FPU settings ------------------------------------------------------------*/
-#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1) && !defined(USE_NO_FLOAT)
   SCB->CPACR |= ((3UL << 10 * 2) | (3UL << 11 * 2)); /* set CP10 and CP11 Full Access */
 #endif
+  /* With USE_NO_FLOAT the FPU stays disabled: the link check proves that main has no floating-point instruction, so the
+     exception frames never include the FPU registers (no lazy stacking) and a stray one raises a UsageFault */
 
 #if defined(DATA_IN_ExtSRAM) || defined(DATA_IN_ExtSDRAM)
   SystemInit_ExtMemCtl();
@@ -119,6 +134,10 @@ void SystemInit(void)
 
 uint32_t port_system_init()
 {
+#ifdef USE_MEMORY_MONITOR
+  /* Paint the stacks before they grow to measure their high-water marks */
+  port_memory_init();
+#endif
 
 #ifdef USE_SEMIHOSTING
   initialise_monitor_handles();
@@ -142,6 +161,33 @@ uint32_t port_system_init()
   /* Configure the SysTick IRQ priority. It must be the highest (lower number: 0)*/
   NVIC_SetPriority(SysTick_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0U, 0U)); /* Tick interrupt priority */
 
+#ifdef USE_MICROS_TIME_BASE
+  /* Microsecond time base: free-running at 1 MHz. Unlike the SysTick it is not suspended by port_system_sleep(), and the
+     timers keep their clock in Sleep mode (RCC_APB1LPENR at its reset value); it stops in Stop mode. Its overflow
+     interrupt wakes the CPU every 65.536 ms, so it is only enabled in the builds that use it */
+  RCC->APB1ENR |= RCC_APB1ENR_TIM6EN;
+  STM32F4_SYSTEM_MICROS_TIMER->CR1 = TIM_CR1_URS; /* Only the overflow raises the interrupt */
+  STM32F4_SYSTEM_MICROS_TIMER->PSC = (uint32_t)STM32F4_TIMER_PSC_TICK_US(1);
+  STM32F4_SYSTEM_MICROS_TIMER->ARR = 0xFFFFU;
+  STM32F4_SYSTEM_MICROS_TIMER->EGR = TIM_EGR_UG; /* Load the prescaler */
+  STM32F4_SYSTEM_MICROS_TIMER->SR = ~TIM_SR_UIF;
+  STM32F4_SYSTEM_MICROS_TIMER->DIER |= TIM_DIER_UIE;
+  stm32f4_system_micros_overflows = 0;
+  NVIC_SetPriority(TIM6_DAC_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0U, 0U)); /* Same priority as the SysTick */
+  NVIC_EnableIRQ(TIM6_DAC_IRQn);
+  STM32F4_SYSTEM_MICROS_TIMER->CR1 |= TIM_CR1_CEN;
+
+  /* Alarm: one pulse at 1 MHz per arming, started by port_system_alarm_start() */
+  RCC->APB1ENR |= RCC_APB1ENR_TIM14EN;
+  STM32F4_SYSTEM_ALARM_TIMER->CR1 = TIM_CR1_OPM | TIM_CR1_URS; /* The counter stops at the end of the pulse */
+  STM32F4_SYSTEM_ALARM_TIMER->PSC = (uint32_t)STM32F4_TIMER_PSC_TICK_US(1);
+  STM32F4_SYSTEM_ALARM_TIMER->EGR = TIM_EGR_UG; /* Load the prescaler */
+  STM32F4_SYSTEM_ALARM_TIMER->SR = ~TIM_SR_UIF;
+  alarm_armed = false;
+  NVIC_SetPriority(TIM8_TRG_COM_TIM14_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 1U, 0U));
+  NVIC_EnableIRQ(TIM8_TRG_COM_TIM14_IRQn);
+#endif
+
   /* Init the low level hardware */
   /* Reset and clock control (RCC) */
   RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN; /* Syscfg clock enabling */
@@ -171,7 +217,7 @@ void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms)
 {
   uint32_t until = *p_t + ms;
   uint32_t now = port_system_get_millis();
-  if (until > now)
+  if (!port_system_time_reached(now, until))
   {
     port_system_delay_ms(until - now);
   }
@@ -183,8 +229,106 @@ uint32_t port_system_get_millis()
   return msTicks;
 }
 
+uint64_t port_system_get_millis64(void)
+{
+  uint32_t high;
+  uint32_t low;
+  do
+  {
+    high = msTicksHigh;
+    low = msTicks;
+  } while (high != msTicksHigh); // the SysTick ISR wrapped msTicks between both reads
+  return ((uint64_t)high << 32) | low;
+}
+
+#ifdef USE_MICROS_TIME_BASE
+uint32_t port_system_get_micros(void)
+{
+  return (uint32_t)port_system_get_micros64();
+}
+
+uint64_t port_system_get_micros64(void)
+{
+  uint32_t overflows;
+  uint32_t count;
+  bool pending;
+  do
+  {
+    overflows = stm32f4_system_micros_overflows;
+    count = STM32F4_SYSTEM_MICROS_TIMER->CNT;
+    pending = (STM32F4_SYSTEM_MICROS_TIMER->SR & TIM_SR_UIF) != 0;
+  } while (overflows != stm32f4_system_micros_overflows); // the ISR counted an overflow between the reads
+  if (pending && count < 0x8000U)
+  {
+    overflows++; // the counter has overflowed but the ISR has not run yet (interrupts masked or called from an ISR of the same priority)
+  }
+  return ((uint64_t)overflows << 16) | count;
+}
+
+/**
+ * @brief Start a pulse of the alarm timer towards the time of the alarm: the whole remaining time, or the range of the timer if it is further.
+ *
+ * @param now_us Current time in µs.
+ */
+static void _stm32f4_system_alarm_pulse(uint64_t now_us)
+{
+  uint64_t delay_us = (alarm_us > now_us) ? alarm_us - now_us : 0;
+  if (delay_us < STM32F4_SYSTEM_ALARM_MIN_US)
+  {
+    delay_us = STM32F4_SYSTEM_ALARM_MIN_US;
+  }
+  else if (delay_us > STM32F4_TIMER_MAX_COUNT)
+  {
+    delay_us = STM32F4_TIMER_MAX_COUNT;
+  }
+  STM32F4_SYSTEM_ALARM_TIMER->CR1 &= ~TIM_CR1_CEN;
+  STM32F4_SYSTEM_ALARM_TIMER->ARR = (uint32_t)delay_us - 1U;
+  STM32F4_SYSTEM_ALARM_TIMER->CNT = 0;
+  STM32F4_SYSTEM_ALARM_TIMER->SR = ~TIM_SR_UIF;
+  STM32F4_SYSTEM_ALARM_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
+void port_system_alarm_start(uint64_t deadline_us)
+{
+  STM32F4_SYSTEM_ALARM_TIMER->DIER &= ~TIM_DIER_UIE; // the ISR must not see the alarm half written
+  alarm_us = deadline_us;
+  alarm_armed = true;
+  _stm32f4_system_alarm_pulse(port_system_get_micros64());
+  STM32F4_SYSTEM_ALARM_TIMER->DIER |= TIM_DIER_UIE;
+}
+
+void port_system_alarm_stop(void)
+{
+  STM32F4_SYSTEM_ALARM_TIMER->DIER &= ~TIM_DIER_UIE;
+  STM32F4_SYSTEM_ALARM_TIMER->CR1 &= ~TIM_CR1_CEN;
+  STM32F4_SYSTEM_ALARM_TIMER->SR = ~TIM_SR_UIF;
+  alarm_armed = false;
+}
+
+bool stm32f4_system_alarm_isr(void)
+{
+  STM32F4_SYSTEM_ALARM_TIMER->SR = ~TIM_SR_UIF;
+  if (!alarm_armed)
+  {
+    return false;
+  }
+  uint64_t now_us = port_system_get_micros64();
+  if (now_us >= alarm_us)
+  {
+    alarm_armed = false;
+    return true;
+  }
+  _stm32f4_system_alarm_pulse(now_us); // further than a pulse, or early by the phase of the prescalers
+  return false;
+}
+#endif
+
 void port_system_set_millis(uint32_t ms)
 {
+  if (ms == 0 && msTicks == UINT32_MAX)
+  {
+    msTicksHigh++; // wrap-around: carry into the high word before the low word wraps, so that a reader preempted by the ISR sees both or none
+  }
   msTicks = ms;
 }
 
@@ -372,4 +516,27 @@ void port_system_power_sleep()
   void port_system_sleep (void) {
   port_system_systick_suspend(); // Suspend SysTick interrupt
   port_system_power_sleep(); // Enter Sleep mode
-}
\ No newline at end of file
+}
+
+#ifdef USE_MICROS_TIME_BASE
+void port_system_sleep_tickless(void)
+{
+  uint64_t start_us = port_system_get_micros64();
+  uint64_t start_ms = port_system_get_millis64();
+  port_system_systick_suspend();
+  port_system_power_sleep();
+  port_system_systick_suspend(); // the ISR that woke the CPU may have resumed it: no tick while the time is caught up
+  /* The SysTick counter kept running with its interrupt suspended: add the milliseconds it has not counted, and keep the fraction for the next sleep */
+  uint64_t slept_us = port_system_get_micros64() - start_us + tickless_rem_us;
+  uint64_t slept_ms = slept_us / 1000U;
+  uint64_t counted_ms = port_system_get_millis64() - start_ms;
+  tickless_rem_us = (uint32_t)(slept_us % 1000U);
+  if (slept_ms > counted_ms)
+  {
+    uint64_t ms = start_ms + slept_ms;
+    msTicksHigh = (uint32_t)(ms >> 32);
+    msTicks = (uint32_t)ms;
+  }
+  port_system_systick_resume();
+}
+#endif
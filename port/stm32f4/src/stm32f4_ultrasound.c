@@ -8,7 +8,6 @@
 
 /* Standard C includes */
 #include <stdio.h>
-#include <math.h>
 
 /* HW dependent includes */
 #include "port_ultrasound.h"
@@ -18,9 +17,16 @@
 #include "stm32f4_system.h"
 #include "stm32f4_ultrasound.h"
 
-/* Typedefs --------------------------------------------------------------------*/
-/** @brief Structure to define the HW dependencies of aN ultrasound sensor*/
+/* Defines --------------------------------------------------------------------*/
+#define STM32F4_ULTRASOUND_TRIGGER_TICKS STM32F4_TIMER_TICKS_US(PORT_PARKING_SENSOR_TRIGGER_UP_US)   /*!< Timer clock ticks of the trigger signal (TIM3) */
+#define STM32F4_ULTRASOUND_MEASUREMENT_TICKS STM32F4_TIMER_TICKS_MS(PORT_PARKING_SENSOR_TIMEOUT_MS) /*!< Timer clock ticks between measurements (TIM5) */
+
+STM32F4_TIMER_STATIC_ASSERT(STM32F4_ULTRASOUND_TRIGGER_TICKS, "TIM3 (ultrasound trigger)");
+STM32F4_TIMER_STATIC_ASSERT(STM32F4_ULTRASOUND_MEASUREMENT_TICKS, "TIM5 (ultrasound new measurement)");
+STM32F4_TIMER_TICK_STATIC_ASSERT(STM32F4_ULTRASOUND_ECHO_TICK_US, "TIM2 (ultrasound echo)");
 
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief Structure to define the GPIOs of an ultrasound sensor. It is only changed by the tests (`stm32f4_ultrasound_set_new_*_gpio()`), never by an ISR. */
 typedef struct
 {
     /** @brief GPIO where the trigger signal is connected. */
@@ -31,25 +37,11 @@ typedef struct
     uint8_t trigger_pin;
     /** @brief Pin/line where the echo signal is connected */
     uint8_t echo_pin;
-    /** @brief Alternate function for the echo signal*/
-    uint8_t echo_alt_fun;
-    /** @brief Flag to indicate that a new measurement can be started */
-    bool trigger_ready;
-    /** @brief Flag to indicate that the trigger signal has ended */
-    bool trigger_end;
-    /** @brief Flag to indicate that the echo signal has been received */
-    bool echo_received;
-    /** @brief Tick time when the echo signal was received */
-    uint32_t echo_init_tick;
-    /** @brief Tick time when the echo signal ended */
-    uint32_t echo_end_tick;
-    /** @brief Number of overflows of the echo signal */
-    uint32_t echo_overflows;
-} stm32f4_ultrasound_hw_t;
+} stm32f4_ultrasound_gpio_t;
 
 /* Global variables */
-/** @brief Array of elements that represents the HW characteristics of the ultrasounds connected to the STM32F4 platform.s */
-static stm32f4_ultrasound_hw_t ultrasounds_arr[] = {
+/** @brief Array of elements that represents the GPIOs of the ultrasounds connected to the STM32F4 platform. */
+static stm32f4_ultrasound_gpio_t ultrasounds_gpio_arr[] = {
     [PORT_REAR_PARKING_SENSOR_ID] = {
         .p_trigger_port = STM32F4_REAR_PARKING_SENSOR_TRIGGER_GPIO,
         .p_echo_port = STM32F4_REAR_PARKING_SENSOR_ECHO_GPIO,
@@ -57,20 +49,25 @@ static stm32f4_ultrasound_hw_t ultrasounds_arr[] = {
         .echo_pin = STM32F4_REAR_PARKING_SENSOR_ECHO_PIN,
     }};
 
+/** @brief Array of elements that represents the state of the ultrasounds connected to the STM32F4 platform, shared with their ISRs. */
+stm32f4_ultrasound_hw_t ultrasounds_arr[STM32F4_NUM_ULTRASOUNDS];
+
+_Static_assert(sizeof(ultrasounds_gpio_arr) / sizeof(ultrasounds_gpio_arr[0]) == STM32F4_NUM_ULTRASOUNDS, "STM32F4_NUM_ULTRASOUNDS must match the GPIOs of the ultrasounds");
+
 /* Private functions ----------------------------------------------------------*/
 /**
- * @brief Get the ultrasound struct with the given ID.
+ * @brief Get the GPIOs of the ultrasound sensor with the given ID.
  *
  * @param ultrasound_id Ultrasound sensor ID.
  *
- * @return Pointer to the ultrasound sensor struct.
+ * @return Pointer to the GPIOs of the ultrasound sensor.
  * @return NULL If the ultrasound sensor ID is not valid.
  */
-stm32f4_ultrasound_hw_t *_stm32f4_ultrasound_get(uint32_t ultrasound_id)
+static stm32f4_ultrasound_gpio_t *_stm32f4_ultrasound_get_gpio(uint32_t ultrasound_id)
 {
-    if (ultrasound_id < sizeof(ultrasounds_arr) / sizeof(ultrasounds_arr[0]))
+    if (ultrasound_id < sizeof(ultrasounds_gpio_arr) / sizeof(ultrasounds_gpio_arr[0]))
     {
-        return &ultrasounds_arr[ultrasound_id];
+        return &ultrasounds_gpio_arr[ultrasound_id];
     }
     else
     {
@@ -88,21 +85,8 @@ static void _timer_trigger_setup()
     TIM3->CR1 |= TIM_CR1_ARPE;
     TIM3->CNT = 0;
 
-    double f = 16.0;
-    double arr = 65535.0;
-    double psc = f * PORT_PARKING_SENSOR_TRIGGER_UP_US / (arr + 1.0) - 1.0;
-    psc = round(psc);
-    arr = f * PORT_PARKING_SENSOR_TRIGGER_UP_US / (psc + 1.0) - 1.0;
-    arr = round(arr);
-    if (arr > 65535.0)
-    {
-        psc = psc + 1.0;
-        arr = f * PORT_PARKING_SENSOR_TRIGGER_UP_US / (psc + 1.0) - 1.0;
-        arr = round(arr);
-    }
-
-    TIM3->PSC = (uint32_t)psc;
-    TIM3->ARR = (uint32_t)arr;
+    TIM3->PSC = (uint32_t)STM32F4_TIMER_PSC(STM32F4_ULTRASOUND_TRIGGER_TICKS); // computed at compile time
+    TIM3->ARR = (uint32_t)STM32F4_TIMER_ARR(STM32F4_ULTRASOUND_TRIGGER_TICKS);
     TIM3->EGR = TIM_EGR_UG;
     TIM3->SR = ~TIM_SR_UIF;
     TIM3->DIER |= TIM_DIER_UIE;
@@ -117,8 +101,8 @@ static void _timer_echo_setup()
     // RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN; // enable clock for GPIOA
     RCC->APB1ENR |= RCC_APB1ENR_TIM2EN; // enable clock for TIM2
 
-    TIM2->PSC = 15;     // prescaler
-    TIM2->ARR = 0xFFFF; // auto reload
+    TIM2->PSC = STM32F4_TIMER_PSC_TICK_US(STM32F4_ULTRASOUND_ECHO_TICK_US); // prescaler: one count every STM32F4_ULTRASOUND_ECHO_TICK_US
+    TIM2->ARR = PORT_ULTRASOUND_ECHO_TIMER_PERIOD_TICKS - 1U;               // auto reload: one overflow every PORT_ULTRASOUND_ECHO_TIMER_PERIOD_TICKS
 
     TIM2->CR1 |= TIM_CR1_ARPE;                                        // enable auto reload preload
     TIM2->EGR |= TIM_EGR_UG;                                          // update generation
@@ -145,21 +129,8 @@ static void _timer_new_measurement_setup() // SI ALGO SALE MAL REVISAR
     TIM5->CR1 |= TIM_CR1_ARPE;
     TIM5->CNT = 0;
 
-    double f = 16000.0;
-    double arr = 65535.0;
-    double psc = f * PORT_PARKING_SENSOR_TIMEOUT_MS / (arr + 1.0) - 1.0;
-    psc = round(psc);
-    arr = f * PORT_PARKING_SENSOR_TIMEOUT_MS / (psc + 1.0) - 1.0;
-    arr = round(arr);
-    if (arr > 65535.0)
-    {
-        psc = psc + 1.0;
-        arr = f * PORT_PARKING_SENSOR_TIMEOUT_MS / (psc + 1.0) - 1.0;
-        arr = round(arr);
-    }
-
-    TIM5->PSC = (uint32_t)psc;
-    TIM5->ARR = (uint32_t)arr;
+    TIM5->PSC = (uint32_t)STM32F4_TIMER_PSC(STM32F4_ULTRASOUND_MEASUREMENT_TICKS); // computed at compile time
+    TIM5->ARR = (uint32_t)STM32F4_TIMER_ARR(STM32F4_ULTRASOUND_MEASUREMENT_TICKS);
 
     TIM5->EGR = TIM_EGR_UG;
     TIM5->SR = ~TIM_SR_UIF;
@@ -171,27 +142,25 @@ static void _timer_new_measurement_setup() // SI ALGO SALE MAL REVISAR
 void port_ultrasound_init(uint32_t ultrasound_id)
 {
     /* Get the ultrasound sensor */
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
+    stm32f4_ultrasound_gpio_t *p_gpio = _stm32f4_ultrasound_get_gpio(ultrasound_id);
 
     /* TO-DO alumnos: */
 
     /* Trigger pin configuration */
-    p_ultrasound->trigger_end = false;
-    p_ultrasound->trigger_ready = true;
+    p_ultrasound->flags = BIT_POS_TO_MASK(STM32F4_ULTRASOUND_TRIGGER_READY_BIT);
 
     /* Echo pin configuration */
-    p_ultrasound->echo_received = false;
-    p_ultrasound->echo_alt_fun = 0;
     p_ultrasound->echo_overflows = 0;
     p_ultrasound->echo_end_tick = 0;
     p_ultrasound->echo_init_tick = 0;
 
     /* Configure timers */
-    stm32f4_system_gpio_config(p_ultrasound->p_trigger_port, p_ultrasound->trigger_pin, STM32F4_GPIO_MODE_OUT, STM32F4_GPIO_PUPDR_NOPULL);
+    stm32f4_system_gpio_config(p_gpio->p_trigger_port, p_gpio->trigger_pin, STM32F4_GPIO_MODE_OUT, STM32F4_GPIO_PUPDR_NOPULL);
     _timer_trigger_setup();
 
-    stm32f4_system_gpio_config(p_ultrasound->p_echo_port, p_ultrasound->echo_pin, STM32F4_GPIO_MODE_AF, STM32F4_GPIO_PUPDR_NOPULL);
-    stm32f4_system_gpio_config_alternate(p_ultrasound->p_echo_port, p_ultrasound->echo_pin, STM32F4_AF1);
+    stm32f4_system_gpio_config(p_gpio->p_echo_port, p_gpio->echo_pin, STM32F4_GPIO_MODE_AF, STM32F4_GPIO_PUPDR_NOPULL);
+    stm32f4_system_gpio_config_alternate(p_gpio->p_echo_port, p_gpio->echo_pin, STM32F4_AF1);
     _timer_echo_setup();
 
     _timer_new_measurement_setup();
@@ -199,8 +168,8 @@ void port_ultrasound_init(uint32_t ultrasound_id)
 
 void port_ultrasound_stop_trigger_timer(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    stm32f4_system_gpio_write(p_ultrasound->p_trigger_port, p_ultrasound->trigger_pin, 0);
+    stm32f4_ultrasound_gpio_t *p_gpio = _stm32f4_ultrasound_get_gpio(ultrasound_id);
+    stm32f4_system_gpio_write(p_gpio->p_trigger_port, p_gpio->trigger_pin, 0);
     TIM3->CR1 &= ~TIM_CR1_CEN;
     // TIM3->SR = ~TIM_SR_UIF; // clear update interrupt flag
     // NVIC_DisableIRQ(TIM3_IRQn); // disable timer
@@ -221,105 +190,99 @@ void port_ultrasound_stop_echo_timer(uint32_t ultrasound_id)
 
 void port_ultrasound_reset_echo_ticks(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     p_ultrasound->echo_init_tick = 0;
     p_ultrasound->echo_end_tick = 0;
     p_ultrasound->echo_overflows = 0;
-    p_ultrasound->echo_received = false;
+    stm32f4_ultrasound_set_flag(ultrasound_id, STM32F4_ULTRASOUND_ECHO_RECEIVED_BIT, false);
 }
 
 // Getters and setters functions
 bool port_ultrasound_get_trigger_ready(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    return p_ultrasound->trigger_ready;
+    return stm32f4_ultrasound_get_flag(ultrasound_id, STM32F4_ULTRASOUND_TRIGGER_READY_BIT);
 }
 
 void port_ultrasound_set_trigger_ready(uint32_t ultrasound_id, bool trigger_ready)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->trigger_ready = trigger_ready;
+    stm32f4_ultrasound_set_flag(ultrasound_id, STM32F4_ULTRASOUND_TRIGGER_READY_BIT, trigger_ready);
 }
 
 bool port_ultrasound_get_trigger_end(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    return p_ultrasound->trigger_end;
+    return stm32f4_ultrasound_get_flag(ultrasound_id, STM32F4_ULTRASOUND_TRIGGER_END_BIT);
 }
 
 void port_ultrasound_set_trigger_end(uint32_t ultrasound_id, bool trigger_end)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->trigger_end = trigger_end;
+    stm32f4_ultrasound_set_flag(ultrasound_id, STM32F4_ULTRASOUND_TRIGGER_END_BIT, trigger_end);
 }
 
 uint32_t port_ultrasound_get_echo_init_tick(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     return p_ultrasound->echo_init_tick;
 }
 
 void port_ultrasound_set_echo_init_tick(uint32_t ultrasound_id, uint32_t echo_init_tick)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     p_ultrasound->echo_init_tick = echo_init_tick;
 }
 
 uint32_t port_ultrasound_get_echo_end_tick(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     return p_ultrasound->echo_end_tick;
 }
 
 void port_ultrasound_set_echo_end_tick(uint32_t ultrasound_id, uint32_t echo_end_tick)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     p_ultrasound->echo_end_tick = echo_end_tick;
 }
 
 bool port_ultrasound_get_echo_received(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    return p_ultrasound->echo_received;
+    return stm32f4_ultrasound_get_flag(ultrasound_id, STM32F4_ULTRASOUND_ECHO_RECEIVED_BIT);
 }
 
 void port_ultrasound_set_echo_received(uint32_t ultrasound_id, bool echo_received)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->echo_received = echo_received;
+    stm32f4_ultrasound_set_flag(ultrasound_id, STM32F4_ULTRASOUND_ECHO_RECEIVED_BIT, echo_received);
 }
 
 uint32_t port_ultrasound_get_echo_overflows(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     return p_ultrasound->echo_overflows;
 }
 
 void port_ultrasound_set_echo_overflows(uint32_t ultrasound_id, uint32_t echo_overflows)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
+    stm32f4_ultrasound_hw_t *p_ultrasound = stm32f4_ultrasound_get_hw(ultrasound_id);
     p_ultrasound->echo_overflows = echo_overflows;
 }
 
 // Util
 void stm32f4_ultrasound_set_new_trigger_gpio(uint32_t ultrasound_id, GPIO_TypeDef *p_port, uint8_t pin)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->p_trigger_port = p_port;
-    p_ultrasound->trigger_pin = pin;
+    stm32f4_ultrasound_gpio_t *p_gpio = _stm32f4_ultrasound_get_gpio(ultrasound_id);
+    p_gpio->p_trigger_port = p_port;
+    p_gpio->trigger_pin = pin;
 }
 
 void stm32f4_ultrasound_set_new_echo_gpio(uint32_t ultrasound_id, GPIO_TypeDef *p_port, uint8_t pin)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->p_echo_port = p_port;
-    p_ultrasound->echo_pin = pin;
+    stm32f4_ultrasound_gpio_t *p_gpio = _stm32f4_ultrasound_get_gpio(ultrasound_id);
+    p_gpio->p_echo_port = p_port;
+    p_gpio->echo_pin = pin;
 }
 
 void port_ultrasound_start_measurement(uint32_t ultrasound_id)
 {
-    stm32f4_ultrasound_hw_t *p_ultrasound = _stm32f4_ultrasound_get(ultrasound_id);
-    p_ultrasound->trigger_ready = false; // SI ALGO FALLA CAMBIAR
+    stm32f4_ultrasound_gpio_t *p_gpio = _stm32f4_ultrasound_get_gpio(ultrasound_id);
+    stm32f4_ultrasound_set_flag(ultrasound_id, STM32F4_ULTRASOUND_TRIGGER_READY_BIT, false); // SI ALGO FALLA CAMBIAR
 
     TIM5->CNT = 0;
 
@@ -330,7 +293,7 @@ void port_ultrasound_start_measurement(uint32_t ultrasound_id)
        
     }
 
-    stm32f4_system_gpio_write(p_ultrasound->p_trigger_port, p_ultrasound->trigger_pin, 1);
+    stm32f4_system_gpio_write(p_gpio->p_trigger_port, p_gpio->trigger_pin, 1);
 
     NVIC_EnableIRQ(TIM3_IRQn);
     NVIC_EnableIRQ(TIM2_IRQn);
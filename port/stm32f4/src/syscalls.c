@@ -36,6 +36,7 @@
 #include <sys/times.h>
 
 #include "stm32f4xx.h"
+#include "stm32f4_memory.h"
 
 /* Variables */
 #undef errno
@@ -106,6 +107,7 @@ caddr_t _sbrk(int incr)
 	}
 
 	heap_end += incr;
+	stm32f4_memory_heap_update((uint32_t)(heap_end - &end));
 
 	return (caddr_t) prev_heap_end;
 }
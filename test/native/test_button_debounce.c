@@ -0,0 +1,115 @@
+/**
+ * @file test_button_debounce.c
+ * @brief Test of the debounce of the buttons done by the port with a one-shot timer (`USE_HW_DEBOUNCE`).
+ *
+ * The port of the native platform is compiled into the test with `USE_HW_DEBOUNCE`, whatever the options of the build. The tests press and release the simulated button with bursts of bounces and check that only the first edge raises an interrupt, that the change is posted when the debounce time expires, with the tick of the first edge, and that a glitch shorter than the debounce time is not posted.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "native_button.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_DEBOUNCE_TIME_MS 150 /*!< Debounce time of the button */
+#define TEST_DEBOUNCE_BOUNCES 10  /*!< Edges of a burst of bounces, one per ms */
+#define TEST_DEBOUNCE_HOLD_MS 1000 /*!< Time the button is held */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Change the level of the button with a burst of bounces: the contact toggles every ms and ends at the new level.
+ *
+ * @param pressed New state of the button.
+ */
+static void _test_debounce_bounce_to(bool pressed)
+{
+    for (uint32_t i = 0; i < TEST_DEBOUNCE_BOUNCES; i++)
+    {
+        native_button_set_value(PORT_PARKING_BUTTON_ID, (i % 2 == 0) ? !pressed : pressed);
+        native_system_advance_ms(1);
+    }
+    native_button_set_value(PORT_PARKING_BUTTON_ID, !pressed); /* active low */
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    native_system_advance_ms(1); /* the first tick is not 0 */
+    port_button_init(PORT_PARKING_BUTTON_ID);
+    port_button_set_debounce_time_ms(PORT_PARKING_BUTTON_ID, TEST_DEBOUNCE_TIME_MS);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_bounces_raise_one_interrupt(void)
+{
+    uint32_t edge_tick = port_system_get_millis();
+    _test_debounce_bounce_to(true);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, native_button_get_interrupt_count(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the bounces of the press raised interrupts");
+    UNITY_TEST_ASSERT(!port_button_get_pressed(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the press was posted before the end of the debounce time");
+
+    native_system_advance_ms(edge_tick + TEST_DEBOUNCE_TIME_MS - port_system_get_millis());
+    UNITY_TEST_ASSERT(port_button_get_pressed(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the press was not posted at the end of the debounce time");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(edge_tick, port_button_get_tick(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the tick of the press is not the tick of its first edge");
+}
+
+void test_release_keeps_the_tick_of_its_first_edge(void)
+{
+    uint32_t press_tick = port_system_get_millis();
+    _test_debounce_bounce_to(true);
+    native_system_advance_ms(TEST_DEBOUNCE_HOLD_MS - TEST_DEBOUNCE_BOUNCES);
+
+    uint32_t release_tick = port_system_get_millis();
+    _test_debounce_bounce_to(false);
+    native_system_advance_ms(TEST_DEBOUNCE_TIME_MS);
+
+    UNITY_TEST_ASSERT(!port_button_get_pressed(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the release was not posted");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, native_button_get_interrupt_count(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: a press and a release with bounces did not raise one interrupt each");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_DEBOUNCE_HOLD_MS, port_button_get_tick(PORT_PARKING_BUTTON_ID) - press_tick, __LINE__, "ERROR: wrong duration between the first edges of the press and the release");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(release_tick, port_button_get_tick(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the tick of the release is not the tick of its first edge");
+}
+
+void test_glitch_is_not_posted(void)
+{
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false);
+    native_system_advance_ms(5);
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    native_system_advance_ms(TEST_DEBOUNCE_TIME_MS);
+
+    UNITY_TEST_ASSERT(!port_button_get_pressed(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: a glitch shorter than the debounce time was posted as a press");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, port_button_get_tick(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: a glitch changed the tick of the button");
+
+    /* The line is unmasked again: the next press is seen */
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false);
+    native_system_advance_ms(TEST_DEBOUNCE_TIME_MS);
+    UNITY_TEST_ASSERT(port_button_get_pressed(PORT_PARKING_BUTTON_ID), __LINE__, "ERROR: the press after a glitch was not posted");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bounces_raise_one_interrupt);
+    RUN_TEST(test_release_keeps_the_tick_of_its_first_edge);
+    RUN_TEST(test_glitch_is_not_posted);
+    return UNITY_END();
+}
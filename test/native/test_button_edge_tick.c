@@ -0,0 +1,136 @@
+/**
+ * @file test_button_edge_tick.c
+ * @brief Test of the durations of the button FSM under loop jitter: the ticks of the press and the release are captured by the EXTI ISR, so the durations do not depend on when the FSM fires.
+ *
+ * The test runs a simulated main loop whose iterations take a pseudo-random time between 1 and `TEST_EDGE_MAX_LOOP_MS` ms, as a loop busy with prints and sensors would. The button is pressed and released at exact times, between two fires of the FSM, and the duration read from the FSM must be the exact time the button was held, also for presses at both sides of the pause and ON/OFF thresholds of the Urbanite.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "fsm_button.h"
+#include "native_button.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_EDGE_DEBOUNCE_MS 150 /*!< Debounce time of the button FSM */
+#define TEST_EDGE_MAX_LOOP_MS 40  /*!< Longest iteration of the simulated main loop */
+#define TEST_EDGE_PRESSES 200     /*!< Presses of random duration */
+#define TEST_EDGE_PAUSE_MS 500    /*!< Pause time of the Urbanite (`URBANITE_PAUSE_DISPLAY_TIME_MS` in main.c) */
+#define TEST_EDGE_ON_OFF_MS 1000  /*!< ON/OFF time of the Urbanite (`URBANITE_ON_OFF_PRESS_TIME_MS` in main.c) */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t button_storage; /*!< Storage of the button FSM under test */
+static fsm_button_t *p_fsm_button = NULL;   /*!< Button FSM under test */
+static uint32_t test_seed = 1;              /*!< State of the pseudo-random generator */
+static char msg[100];                       /*!< Buffer for the error messages */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Pseudo-random number between 1 and `max` (linear congruential generator, reproducible).
+ *
+ * @param max Largest number.
+ */
+static uint32_t _test_edge_random(uint32_t max)
+{
+    test_seed = test_seed * 1103515245U + 12345U;
+    return (test_seed >> 16) % max + 1U;
+}
+
+/**
+ * @brief Run the simulated main loop for a time: the iterations take a random time and fire the FSM at their end.
+ *
+ * @param ms Time to run. The edge that follows happens at the end of this time, which is usually in the middle of an iteration.
+ */
+static void _test_edge_run_ms(uint32_t ms)
+{
+    static uint32_t remaining_loop_ms = 0; /* Time to the end of the iteration in progress */
+    while (ms > 0)
+    {
+        if (remaining_loop_ms == 0)
+        {
+            fsm_button_fire(p_fsm_button);
+            remaining_loop_ms = _test_edge_random(TEST_EDGE_MAX_LOOP_MS);
+        }
+        native_system_advance_ms(1);
+        remaining_loop_ms--;
+        ms--;
+    }
+}
+
+/**
+ * @brief Press the button for an exact time under loop jitter and return the duration seen by the FSM.
+ *
+ * @param held_ms Time the button is held.
+ */
+static uint32_t _test_edge_press_ms(uint32_t held_ms)
+{
+    fsm_button_reset_duration(p_fsm_button);
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false); /* active low */
+    _test_edge_run_ms(held_ms);
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    _test_edge_run_ms(TEST_EDGE_DEBOUNCE_MS + 2 * TEST_EDGE_MAX_LOOP_MS);
+    return fsm_button_get_duration(p_fsm_button);
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    native_system_advance_ms(1); /* the first tick is not 0 */
+    p_fsm_button = fsm_button_init(&button_storage, TEST_EDGE_DEBOUNCE_MS, PORT_PARKING_BUTTON_ID);
+    test_seed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_durations_are_exact_under_jitter(void)
+{
+    for (uint32_t i = 0; i < TEST_EDGE_PRESSES; i++)
+    {
+        uint32_t held_ms = TEST_EDGE_DEBOUNCE_MS + _test_edge_random(2000);
+        snprintf(msg, sizeof(msg), "ERROR: wrong duration of a press of %u ms", (unsigned)held_ms);
+        UNITY_TEST_ASSERT_EQUAL_UINT32(held_ms, _test_edge_press_ms(held_ms), __LINE__, msg);
+    }
+}
+
+void test_borderline_presses_keep_their_side(void)
+{
+    static const uint32_t thresholds_ms[] = {TEST_EDGE_PAUSE_MS, TEST_EDGE_ON_OFF_MS};
+    for (uint32_t i = 0; i < sizeof(thresholds_ms) / sizeof(thresholds_ms[0]); i++)
+    {
+        for (uint32_t repeat = 0; repeat < 10; repeat++)
+        {
+            snprintf(msg, sizeof(msg), "ERROR: a press just under %u ms was seen longer", (unsigned)thresholds_ms[i]);
+            UNITY_TEST_ASSERT(_test_edge_press_ms(thresholds_ms[i] - 1) < thresholds_ms[i], __LINE__, msg);
+            snprintf(msg, sizeof(msg), "ERROR: a press just over %u ms was seen shorter", (unsigned)thresholds_ms[i]);
+            UNITY_TEST_ASSERT(_test_edge_press_ms(thresholds_ms[i] + 1) > thresholds_ms[i], __LINE__, msg);
+        }
+    }
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_durations_are_exact_under_jitter);
+    RUN_TEST(test_borderline_presses_keep_their_side);
+    return UNITY_END();
+}
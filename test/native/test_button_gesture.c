@@ -0,0 +1,320 @@
+/**
+ * @file test_button_gesture.c
+ * @brief Test of the gesture recognizer of the buttons: thresholds of the click and the long press, double-click window, chords, held thresholds, hold-repeat and overflow of the queue.
+ *
+ * The tests feed the press and release timestamps directly to the recognizer, as the button FSMs do, except the last ones, which press the simulated button and check that the button FSM bound to the recognizer feeds it, and that it emits the held events while the button is still held.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "button_gesture.h"
+#include "fsm_button.h"
+#include "native_button.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_GESTURE_MIN_CLICK_MS 50     /*!< Shortest click */
+#define TEST_GESTURE_LONG_PRESS_MS 1000  /*!< Shortest long press */
+#define TEST_GESTURE_DOUBLE_CLICK_MS 300 /*!< Double-click window */
+#define TEST_GESTURE_REPEAT_MS 200       /*!< Period of the hold-repeat events */
+#define TEST_GESTURE_DEBOUNCE_MS 100     /*!< Debounce time of the button FSM */
+#define TEST_GESTURE_HELD_1_MS 500       /*!< First held threshold */
+#define TEST_GESTURE_HELD_2_MS 2000      /*!< Second held threshold */
+
+/* Global variables ------------------------------------------------------------*/
+static button_gesture_t gesture; /*!< Recognizer under test */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Press and release a button.
+ *
+ * @param slot Slot of the button.
+ * @param tick Timestamp of the press.
+ * @param duration_ms Duration of the press.
+ */
+static void _test_gesture_press_release(uint32_t slot, uint32_t tick, uint32_t duration_ms)
+{
+    button_gesture_press(&gesture, slot, tick);
+    button_gesture_release(&gesture, slot, tick + duration_ms);
+}
+
+/**
+ * @brief Pop an event and return its type, or `BUTTON_GESTURE_NONE` if the queue is empty.
+ *
+ * @param p_event Where the event is copied.
+ */
+static uint8_t _test_gesture_pop_type(button_gesture_event_t *p_event)
+{
+    p_event->type = BUTTON_GESTURE_NONE;
+    button_gesture_pop(&gesture, p_event);
+    return p_event->type;
+}
+
+/**
+ * @brief Initialize the recognizer with the held thresholds and without hold-repeat.
+ */
+static void _test_gesture_init_held(void)
+{
+    button_gesture_config_t config = {
+        .min_click_ms = TEST_GESTURE_MIN_CLICK_MS,
+        .long_press_ms = TEST_GESTURE_LONG_PRESS_MS,
+        .double_click_ms = 0,
+        .repeat_ms = 0,
+        .held_ms = {TEST_GESTURE_HELD_1_MS, TEST_GESTURE_HELD_2_MS}};
+    button_gesture_init(&gesture, &config);
+}
+
+/**
+ * @brief Start the simulated system with a button FSM bound to the recognizer.
+ *
+ * @return fsm_button_t* Button FSM.
+ */
+static fsm_button_t *_test_gesture_init_button(void)
+{
+    static fsm_button_storage_t button_storage;
+
+    port_system_init();
+    native_system_advance_ms(1); /* the first tick is not 0 */
+    fsm_button_t *p_fsm_button = fsm_button_init(&button_storage, TEST_GESTURE_DEBOUNCE_MS, PORT_PARKING_BUTTON_ID);
+    fsm_button_set_gesture(p_fsm_button, &gesture, 0);
+    return p_fsm_button;
+}
+
+/**
+ * @brief Advance the simulated time ms by ms, firing the button FSM every ms.
+ *
+ * @param p_fsm_button Button FSM.
+ * @param ms Time to advance.
+ */
+static void _test_gesture_run_ms(fsm_button_t *p_fsm_button, uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        native_system_advance_ms(1);
+        fsm_button_fire(p_fsm_button);
+    }
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    button_gesture_config_t config = {
+        .min_click_ms = TEST_GESTURE_MIN_CLICK_MS,
+        .long_press_ms = TEST_GESTURE_LONG_PRESS_MS,
+        .double_click_ms = TEST_GESTURE_DOUBLE_CLICK_MS,
+        .repeat_ms = TEST_GESTURE_REPEAT_MS};
+    button_gesture_init(&gesture, &config);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_click_and_long_press_thresholds(void)
+{
+    button_gesture_event_t event;
+
+    _test_gesture_press_release(0, 1000, TEST_GESTURE_MIN_CLICK_MS - 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a press shorter than the shortest click produced an event");
+
+    _test_gesture_press_release(0, 5000, TEST_GESTURE_MIN_CLICK_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a press of the shortest click is not a click");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_GESTURE_MIN_CLICK_MS, event.duration_ms, __LINE__, "ERROR: wrong duration of the click");
+
+    _test_gesture_press_release(0, 10000, TEST_GESTURE_LONG_PRESS_MS - 1);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a press just shorter than the long press is not a click");
+
+    _test_gesture_press_release(0, 15000, TEST_GESTURE_LONG_PRESS_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_LONG_PRESS, _test_gesture_pop_type(&event), __LINE__, "ERROR: a press of the long press time is not a long press");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(15000 + TEST_GESTURE_LONG_PRESS_MS, event.tick, __LINE__, "ERROR: the long press does not carry the tick of the release");
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: unexpected events in the queue");
+}
+
+void test_double_click_window(void)
+{
+    button_gesture_event_t event;
+
+    /* Second press at the end of the window: double click */
+    _test_gesture_press_release(0, 1000, 100);
+    _test_gesture_press_release(0, 1100 + TEST_GESTURE_DOUBLE_CLICK_MS, 100);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: the first click of a double click is not a click");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_DOUBLE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a click inside the window is not a double click");
+
+    /* A third click does not make another double click with the second one */
+    _test_gesture_press_release(0, 1600 + TEST_GESTURE_DOUBLE_CLICK_MS, 100);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: the click after a double click is not a click");
+
+    /* Second press just after the window: two clicks */
+    _test_gesture_press_release(0, 10000, 100);
+    _test_gesture_press_release(0, 10100 + TEST_GESTURE_DOUBLE_CLICK_MS + 1, 100);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: wrong first click");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a click after the window is a double click");
+}
+
+void test_chord_suppresses_clicks(void)
+{
+    button_gesture_event_t event;
+    button_gesture_set_chord(&gesture, 0x03);
+
+    button_gesture_press(&gesture, 0, 1000);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: the first button of the chord produced an event");
+    button_gesture_press(&gesture, 1, 1040);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CHORD, _test_gesture_pop_type(&event), __LINE__, "ERROR: the press that completes the chord did not produce a chord");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(1, event.slot, __LINE__, "ERROR: the chord does not carry the slot of the button that completed it");
+
+    button_gesture_release(&gesture, 0, 1200);
+    button_gesture_release(&gesture, 1, 2500);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: the release of the buttons of a chord produced a click or a long press");
+
+    /* After the chord the buttons click again, and the chord does not count as the first click of a double click */
+    _test_gesture_press_release(0, 2600, 100);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a button does not click after a chord");
+}
+
+void test_hold_repeat_counts(void)
+{
+    button_gesture_event_t event;
+
+    button_gesture_press(&gesture, 0, 1000);
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_LONG_PRESS_MS - 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a hold-repeat before the long press time");
+
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_LONG_PRESS_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HOLD_REPEAT, _test_gesture_pop_type(&event), __LINE__, "ERROR: no hold-repeat at the long press time");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, event.count, __LINE__, "ERROR: the first hold-repeat is not number 1");
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_LONG_PRESS_MS + 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a hold-repeat was emitted twice");
+
+    /* A late tick emits only the last repeat that is due, with its own tick */
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_LONG_PRESS_MS + 3 * TEST_GESTURE_REPEAT_MS + 50);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HOLD_REPEAT, _test_gesture_pop_type(&event), __LINE__, "ERROR: no hold-repeat after three periods");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(4, event.count, __LINE__, "ERROR: wrong number of the hold-repeat");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1000 + TEST_GESTURE_LONG_PRESS_MS + 3 * TEST_GESTURE_REPEAT_MS, event.tick, __LINE__, "ERROR: wrong tick of the hold-repeat");
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: the missed hold-repeats were queued");
+
+    button_gesture_release(&gesture, 0, 3000);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_LONG_PRESS, _test_gesture_pop_type(&event), __LINE__, "ERROR: the release after the hold-repeats is not a long press");
+}
+
+void test_held_thresholds(void)
+{
+    button_gesture_event_t event;
+    _test_gesture_init_held();
+
+    button_gesture_press(&gesture, 0, 1000);
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_HELD_1_MS - 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a held event before its threshold");
+
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_HELD_1_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HELD, _test_gesture_pop_type(&event), __LINE__, "ERROR: no held event at the first threshold");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, event.count, __LINE__, "ERROR: wrong number of the first threshold");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_GESTURE_HELD_1_MS, event.duration_ms, __LINE__, "ERROR: wrong duration of the first held event");
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_HELD_2_MS - 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a held event was emitted twice");
+
+    button_gesture_tick(&gesture, 1000 + TEST_GESTURE_HELD_2_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HELD, _test_gesture_pop_type(&event), __LINE__, "ERROR: no held event at the second threshold");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, event.count, __LINE__, "ERROR: wrong number of the second threshold");
+    button_gesture_release(&gesture, 0, 4000);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_LONG_PRESS, _test_gesture_pop_type(&event), __LINE__, "ERROR: the release after the held events is not a long press");
+
+    /* A late tick emits every threshold passed, in order, with its own tick */
+    button_gesture_press(&gesture, 0, 10000);
+    button_gesture_tick(&gesture, 10000 + TEST_GESTURE_HELD_2_MS + 100);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HELD, _test_gesture_pop_type(&event), __LINE__, "ERROR: the first threshold was missed by a late tick");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10000 + TEST_GESTURE_HELD_1_MS, event.tick, __LINE__, "ERROR: wrong tick of the first threshold");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HELD, _test_gesture_pop_type(&event), __LINE__, "ERROR: the second threshold was missed by a late tick");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10000 + TEST_GESTURE_HELD_2_MS, event.tick, __LINE__, "ERROR: wrong tick of the second threshold");
+
+    /* A click released before the first threshold emits no held event */
+    button_gesture_release(&gesture, 0, 13000);
+    _test_gesture_pop_type(&event);
+    button_gesture_press(&gesture, 0, 20000);
+    button_gesture_tick(&gesture, 20000 + TEST_GESTURE_HELD_1_MS - 1);
+    button_gesture_release(&gesture, 0, 20000 + TEST_GESTURE_HELD_1_MS - 1);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a press shorter than the first threshold is not a click");
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a press shorter than the first threshold emitted a held event");
+}
+
+void test_queue_overflow_drops_events(void)
+{
+    button_gesture_event_t event;
+
+    for (uint32_t i = 0; i < BUTTON_GESTURE_QUEUE_SIZE + 2; i++)
+    {
+        _test_gesture_press_release(0, 1000 + i * 1000, TEST_GESTURE_LONG_PRESS_MS);
+    }
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, button_gesture_get_dropped(&gesture), __LINE__, "ERROR: wrong number of dropped events");
+    for (uint32_t i = 0; i < BUTTON_GESTURE_QUEUE_SIZE; i++)
+    {
+        UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_LONG_PRESS, _test_gesture_pop_type(&event), __LINE__, "ERROR: an event of the full queue was lost");
+        UNITY_TEST_ASSERT_EQUAL_UINT32(1000 + i * 1000 + TEST_GESTURE_LONG_PRESS_MS, event.tick, __LINE__, "ERROR: the queue does not keep the oldest events");
+    }
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: the dropped events were queued");
+}
+
+void test_button_fsm_feeds_the_recognizer(void)
+{
+    button_gesture_event_t event;
+    fsm_button_t *p_fsm_button = _test_gesture_init_button();
+
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false); /* active low */
+    _test_gesture_run_ms(p_fsm_button, 400);
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    _test_gesture_run_ms(p_fsm_button, 2 * TEST_GESTURE_DEBOUNCE_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: a press of the button FSM did not produce a click");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(fsm_button_get_duration(p_fsm_button), event.duration_ms, __LINE__, "ERROR: the click and the button FSM disagree on the duration");
+}
+
+void test_button_fsm_emits_held_while_held(void)
+{
+    button_gesture_event_t event;
+    _test_gesture_init_held();
+    fsm_button_t *p_fsm_button = _test_gesture_init_button();
+
+    uint32_t press_tick = port_system_get_millis();
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false); /* active low */
+    _test_gesture_run_ms(p_fsm_button, TEST_GESTURE_HELD_1_MS - 1);
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a held event before the threshold");
+
+    /* The press is stored at the first fire after the edge: the event comes one ms later, with the button still held */
+    _test_gesture_run_ms(p_fsm_button, 2);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_HELD, _test_gesture_pop_type(&event), __LINE__, "ERROR: no held event while the button is held");
+    UNITY_TEST_ASSERT(port_system_get_millis() - press_tick <= TEST_GESTURE_HELD_1_MS + 1, __LINE__, "ERROR: the held event came late");
+    UNITY_TEST_ASSERT(fsm_button_get_duration(p_fsm_button) == 0, __LINE__, "ERROR: the button FSM saw a release");
+
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    _test_gesture_run_ms(p_fsm_button, 2 * TEST_GESTURE_DEBOUNCE_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(BUTTON_GESTURE_CLICK, _test_gesture_pop_type(&event), __LINE__, "ERROR: the release of the press is not a click");
+    UNITY_TEST_ASSERT(!button_gesture_pending(&gesture), __LINE__, "ERROR: a held event after the release");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_click_and_long_press_thresholds);
+    RUN_TEST(test_double_click_window);
+    RUN_TEST(test_chord_suppresses_clicks);
+    RUN_TEST(test_hold_repeat_counts);
+    RUN_TEST(test_held_thresholds);
+    RUN_TEST(test_queue_overflow_drops_events);
+    RUN_TEST(test_button_fsm_feeds_the_recognizer);
+    RUN_TEST(test_button_fsm_emits_held_while_held);
+    return UNITY_END();
+}
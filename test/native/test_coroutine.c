@@ -0,0 +1,228 @@
+/**
+ * @file test_coroutine.c
+ * @brief Test of the stackless coroutines (`coroutine.h`) and of the measurement sequence of the ultrasound sensor written as a coroutine.
+ *
+ * The first tests resume small coroutines and check their waits on conditions and deadlines, their yields and their end. The last ones run the ultrasound coroutine on the simulated sensor, resumed every millisecond like the FSM in the main loop, and check that it measures the same distances as the FSM, never later (it waits for the end of the echo in one step, the FSM in two), and that it gives up a lost echo.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "coroutine.h"
+#include "ultrasound_coroutine.h"
+#include "fsm_ultrasound.h"
+#include "native_system.h"
+#include "native_ultrasound.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_COROUTINE_DISTANCE_CM 30 /*!< Distance to the simulated obstacle */
+#define TEST_COROUTINE_RUN_MS 1000    /*!< Simulated time of the runs of the ultrasound sequence */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Context of the test coroutine.
+ */
+typedef struct
+{
+    /** @brief State of the coroutine */
+    coroutine_t co;
+    /** @brief Event the coroutine waits for */
+    bool event;
+    /** @brief Deadline the coroutine waits for */
+    uint64_t deadline_us;
+    /** @brief Steps of the sequence run */
+    uint32_t steps;
+} test_coroutine_ctx_t;
+
+/* Global variables ------------------------------------------------------------*/
+static test_coroutine_ctx_t ctx;                     /*!< Context of the test coroutine */
+static ultrasound_coroutine_t uc;                    /*!< Ultrasound coroutine under test */
+static fsm_ultrasound_storage_t fsm_ultrasound_storage; /*!< Storage of the ultrasound FSM of reference */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Test coroutine: wait for the event, yield, wait 250 µs, and end.
+ *
+ * @param p_ctx Context of the coroutine.
+ * @return coroutine_status_t Status of the coroutine.
+ */
+static coroutine_status_t _test_coroutine_run(test_coroutine_ctx_t *p_ctx)
+{
+    COROUTINE_BEGIN(&p_ctx->co);
+    p_ctx->steps = 1;
+    COROUTINE_WAIT_UNTIL(&p_ctx->co, p_ctx->event);
+    p_ctx->steps = 2;
+    COROUTINE_YIELD(&p_ctx->co);
+    p_ctx->steps = 3;
+    p_ctx->deadline_us = port_system_get_micros64() + 250;
+    COROUTINE_WAIT_UNTIL_US(&p_ctx->co, p_ctx->deadline_us);
+    p_ctx->steps = 4;
+    COROUTINE_END(&p_ctx->co);
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    coroutine_init(&ctx.co);
+    ctx.event = false;
+    ctx.deadline_us = 0;
+    ctx.steps = 0;
+    native_ultrasound_set_distance_cm(PORT_REAR_PARKING_SENSOR_ID, TEST_COROUTINE_DISTANCE_CM);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_wait_until_event(void)
+{
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_WAITING, _test_coroutine_run(&ctx), __LINE__, "ERROR: the coroutine did not wait for the event");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, ctx.steps, __LINE__, "ERROR: the coroutine did not run until its first wait");
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_WAITING, _test_coroutine_run(&ctx), __LINE__, "ERROR: the coroutine did not wait for the event");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, ctx.steps, __LINE__, "ERROR: the coroutine did not resume at its wait");
+
+    ctx.event = true;
+    _test_coroutine_run(&ctx);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, ctx.steps, __LINE__, "ERROR: the coroutine did not continue after the event up to the yield");
+}
+
+void test_event_already_true_does_not_return(void)
+{
+    ctx.event = true;
+    _test_coroutine_run(&ctx);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, ctx.steps, __LINE__, "ERROR: the coroutine returned on an event that was already true");
+}
+
+void test_yield_and_deadline(void)
+{
+    ctx.event = true;
+    _test_coroutine_run(&ctx);
+    _test_coroutine_run(&ctx);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(3, ctx.steps, __LINE__, "ERROR: the coroutine did not continue after the yield");
+
+    native_system_advance_us(249);
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_WAITING, _test_coroutine_run(&ctx), __LINE__, "ERROR: the coroutine did not wait for the deadline");
+    native_system_advance_us(1);
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_ENDED, _test_coroutine_run(&ctx), __LINE__, "ERROR: the coroutine did not end at the deadline");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(4, ctx.steps, __LINE__, "ERROR: the coroutine did not run to its end");
+}
+
+void test_end_and_restart(void)
+{
+    ctx.event = true;
+    while (_test_coroutine_run(&ctx) != COROUTINE_ENDED)
+    {
+        native_system_advance_us(100);
+    }
+    UNITY_TEST_ASSERT(coroutine_is_ended(&ctx.co), __LINE__, "ERROR: the coroutine is not ended");
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_ENDED, _test_coroutine_run(&ctx), __LINE__, "ERROR: an ended coroutine ran again");
+
+    coroutine_init(&ctx.co);
+    ctx.event = false;
+    UNITY_TEST_ASSERT_EQUAL_INT(COROUTINE_WAITING, _test_coroutine_run(&ctx), __LINE__, "ERROR: the restarted coroutine did not wait for the event");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, ctx.steps, __LINE__, "ERROR: the coroutine did not restart from the beginning");
+}
+
+void test_ultrasound_same_distances_as_the_fsm(void)
+{
+    uint32_t fsm_times[TEST_COROUTINE_RUN_MS];
+    uint32_t fsm_count = 0;
+    fsm_ultrasound_t *p_fsm = fsm_ultrasound_init(&fsm_ultrasound_storage, PORT_REAR_PARKING_SENSOR_ID);
+    fsm_ultrasound_start(p_fsm);
+    for (uint32_t ms = 0; ms < TEST_COROUTINE_RUN_MS; ms++)
+    {
+        fsm_ultrasound_fire(p_fsm);
+        if (fsm_ultrasound_get_new_measurement_ready(p_fsm))
+        {
+            UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_COROUTINE_DISTANCE_CM, fsm_ultrasound_get_distance(p_fsm), __LINE__, "ERROR: wrong distance of the FSM");
+            fsm_times[fsm_count++] = port_system_get_millis();
+        }
+        native_system_advance_ms(1);
+    }
+    fsm_ultrasound_stop(p_fsm);
+
+    port_system_init();
+    uint32_t count = 0;
+    ultrasound_coroutine_init(&uc, PORT_REAR_PARKING_SENSOR_ID);
+    ultrasound_coroutine_start(&uc);
+    for (uint32_t ms = 0; ms < TEST_COROUTINE_RUN_MS; ms++)
+    {
+        ultrasound_coroutine_run(&uc);
+        if (ultrasound_coroutine_get_new_measurement_ready(&uc))
+        {
+            UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_COROUTINE_DISTANCE_CM, ultrasound_coroutine_get_distance(&uc), __LINE__, "ERROR: wrong distance of the coroutine");
+            UNITY_TEST_ASSERT(count < fsm_count, __LINE__, "ERROR: the coroutine measured more distances than the FSM");
+            UNITY_TEST_ASSERT(port_system_get_millis() <= fsm_times[count], __LINE__, "ERROR: the coroutine measured a distance later than the FSM");
+            count++;
+        }
+        native_system_advance_ms(1);
+    }
+    UNITY_TEST_ASSERT(count > 0, __LINE__, "ERROR: the coroutine measured no distance");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(fsm_count, count, __LINE__, "ERROR: the coroutine and the FSM measured a different number of distances");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, ultrasound_coroutine_get_timeouts(&uc), __LINE__, "ERROR: an echo was given up");
+}
+
+void test_ultrasound_lost_echo(void)
+{
+    ultrasound_coroutine_init(&uc, PORT_REAR_PARKING_SENSOR_ID);
+    ultrasound_coroutine_start(&uc);
+    ultrasound_coroutine_run(&uc);
+    native_system_advance_ms(1);
+    ultrasound_coroutine_run(&uc); /* End of the trigger */
+
+    port_ultrasound_stop_echo_timer(PORT_REAR_PARKING_SENSOR_ID); /* The echo is lost */
+    for (uint32_t ms = 0; ms < PORT_PARKING_SENSOR_TIMEOUT_MS; ms++)
+    {
+        native_system_advance_ms(1);
+        ultrasound_coroutine_run(&uc);
+    }
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, ultrasound_coroutine_get_timeouts(&uc), __LINE__, "ERROR: the lost echo was not given up at the start of the next measurement");
+
+    for (uint32_t ms = 0; ms < FSM_ULTRASOUND_NUM_MEASUREMENTS * PORT_PARKING_SENSOR_TIMEOUT_MS && !ultrasound_coroutine_get_new_measurement_ready(&uc); ms++)
+    {
+        native_system_advance_ms(1);
+        ultrasound_coroutine_run(&uc);
+    }
+    UNITY_TEST_ASSERT(ultrasound_coroutine_get_new_measurement_ready(&uc), __LINE__, "ERROR: the measurements did not go on after the lost echo");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_COROUTINE_DISTANCE_CM, ultrasound_coroutine_get_distance(&uc), __LINE__, "ERROR: wrong distance after the lost echo");
+}
+
+void test_ultrasound_stop(void)
+{
+    ultrasound_coroutine_init(&uc, PORT_REAR_PARKING_SENSOR_ID);
+    ultrasound_coroutine_start(&uc);
+    ultrasound_coroutine_run(&uc);
+    ultrasound_coroutine_stop(&uc);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    ultrasound_coroutine_run(&uc);
+    UNITY_TEST_ASSERT(port_ultrasound_get_trigger_ready(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: a measurement started after the stop");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_wait_until_event);
+    RUN_TEST(test_event_already_true_does_not_return);
+    RUN_TEST(test_yield_and_deadline);
+    RUN_TEST(test_end_and_restart);
+    RUN_TEST(test_ultrasound_same_distances_as_the_fsm);
+    RUN_TEST(test_ultrasound_lost_echo);
+    RUN_TEST(test_ultrasound_stop);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_display_fixed_point.c
+ * @brief Bit-exact test of the fixed-point color levels of the display FSM against the floating-point version they replace.
+ *
+ * The display FSM used to blend the colors with `float` (`(1 - f) * color1 + f * color2`, truncated). The test keeps that version as reference and checks, for every distance of the display range and a few beyond, that the color sent to the port by the FSM is the same to the last bit. Only the test uses floating point: the firmware is built without it.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdio.h>
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_display.h"
+
+/* Project includes */
+#include "fsm_display.h"
+#include "native_display.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_DISPLAY_MAX_CM (OK_MAX_CM + 50) /*!< Last distance checked, beyond the display range */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_display_storage_t display_storage; /*!< Storage of the display FSM under test */
+static fsm_display_t *p_fsm_display = NULL;   /*!< Display FSM under test */
+static char msg[100];                         /*!< Buffer for the error messages */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Floating-point blend of two colors, as in the display FSM before the fixed-point version.
+ */
+static rgb_color_t _reference_changing_color(rgb_color_t color1, rgb_color_t color2, float f)
+{
+    rgb_color_t result;
+    result.r = (uint8_t)((1.0f - f) * color1.r + f * color2.r);
+    result.g = (uint8_t)((1.0f - f) * color1.g + f * color2.g);
+    result.b = (uint8_t)((1.0f - f) * color1.b + f * color2.b);
+    return result;
+}
+
+/**
+ * @brief Floating-point color levels of a distance, as in the display FSM before the fixed-point version.
+ */
+static rgb_color_t _reference_display_levels(int32_t distance_cm)
+{
+    if (distance_cm <= WARNING_MIN_CM && distance_cm >= DANGER_MIN_CM)
+    {
+        float t = (float)(distance_cm - DANGER_MIN_CM) / (WARNING_MIN_CM - DANGER_MIN_CM);
+        return _reference_changing_color(COLOR_RED, COLOR_YELLOW, t);
+    }
+    if (distance_cm <= NO_PROBLEM_MIN_CM)
+    {
+        float t = (float)(distance_cm - WARNING_MIN_CM) / (NO_PROBLEM_MIN_CM - WARNING_MIN_CM);
+        return _reference_changing_color(COLOR_YELLOW, COLOR_GREEN, t);
+    }
+    if (distance_cm <= INFO_MIN_CM)
+    {
+        float t = (float)(distance_cm - NO_PROBLEM_MIN_CM) / (INFO_MIN_CM - NO_PROBLEM_MIN_CM);
+        return _reference_changing_color(COLOR_GREEN, COLOR_TURQUOISE, t);
+    }
+    if (distance_cm <= OK_MIN_CM)
+    {
+        float t = (float)(distance_cm - INFO_MIN_CM) / (OK_MIN_CM - INFO_MIN_CM);
+        return _reference_changing_color(COLOR_TURQUOISE, COLOR_BLUE, t);
+    }
+    if (distance_cm <= OK_MAX_CM)
+    {
+        return COLOR_BLUE;
+    }
+    return COLOR_OFF;
+}
+
+/**
+ * @brief Show a distance with the display FSM and return the color sent to the port.
+ */
+static rgb_color_t _display_distance(uint32_t distance_cm)
+{
+    fsm_display_set_distance(p_fsm_display, distance_cm);
+    fsm_display_fire(p_fsm_display);
+    return native_display_get_rgb(PORT_REAR_PARKING_DISPLAY_ID);
+}
+
+/**
+ * @brief Check that a color is the expected one, channel by channel.
+ */
+static void _assert_color(rgb_color_t expected, rgb_color_t actual, uint32_t distance_cm)
+{
+    snprintf(msg, sizeof(msg), "ERROR: wrong red level for %u cm", (unsigned)distance_cm);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(expected.r, actual.r, __LINE__, msg);
+    snprintf(msg, sizeof(msg), "ERROR: wrong green level for %u cm", (unsigned)distance_cm);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(expected.g, actual.g, __LINE__, msg);
+    snprintf(msg, sizeof(msg), "ERROR: wrong blue level for %u cm", (unsigned)distance_cm);
+    UNITY_TEST_ASSERT_EQUAL_UINT8(expected.b, actual.b, __LINE__, msg);
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    p_fsm_display = fsm_display_init(&display_storage, PORT_REAR_PARKING_DISPLAY_ID);
+    fsm_display_set_status(p_fsm_display, true);
+    fsm_display_fire(p_fsm_display); /* WAIT_DISPLAY -> SET_DISPLAY */
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_levels_match_float_reference(void)
+{
+    for (uint32_t distance_cm = 0; distance_cm <= TEST_DISPLAY_MAX_CM; distance_cm++)
+    {
+        _assert_color(_reference_display_levels((int32_t)distance_cm), _display_distance(distance_cm), distance_cm);
+    }
+}
+
+void test_levels_at_range_limits(void)
+{
+    _assert_color(COLOR_RED, _display_distance(DANGER_MIN_CM), DANGER_MIN_CM);
+    _assert_color(COLOR_YELLOW, _display_distance(WARNING_MIN_CM), WARNING_MIN_CM);
+    _assert_color(COLOR_GREEN, _display_distance(NO_PROBLEM_MIN_CM), NO_PROBLEM_MIN_CM);
+    _assert_color(COLOR_TURQUOISE, _display_distance(INFO_MIN_CM), INFO_MIN_CM);
+    _assert_color(COLOR_BLUE, _display_distance(OK_MIN_CM), OK_MIN_CM);
+    _assert_color(COLOR_BLUE, _display_distance(OK_MAX_CM), OK_MAX_CM);
+    _assert_color(COLOR_OFF, _display_distance(OK_MAX_CM + 1), OK_MAX_CM + 1);
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_levels_match_float_reference);
+    RUN_TEST(test_levels_at_range_limits);
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+/**
+ * @file test_fsm_hierarchical.c
+ * @brief Test of the FSM dispatcher with nested states (`fsm_hierarchical.c`).
+ *
+ * The tests fire a synthetic FSM with two levels of composite states, P{A, Q{B, C}} and D, whose entry and exit actions and transition outputs record their order in a log. They check the descent to the initial state, the exits and entries up to the lowest common state, the priority of the rows of a state over the inherited ones, the "else" rows, the internal self-transitions, the input functions called and the rows of every state built from the table.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <string.h>
+#include <unity.h>
+
+/* Project includes */
+#include "fsm_hierarchical.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_HSM_LOG_SIZE 64 /*!< Size of the log of the actions */
+
+/* Enums */
+/**
+ * @brief States of the test FSM: A, B, C and D are leaves, Q and P composite.
+ */
+enum TEST_HSM
+{
+    A = 0,
+    B,
+    C,
+    D,
+    Q,
+    P
+};
+
+/* Global variables ------------------------------------------------------------*/
+static char log_actions[TEST_HSM_LOG_SIZE]; /*!< Actions run, in order: `+X` entry of X, `-X` exit of X, `!` output of a transition */
+static bool guard_a;                        /*!< Input of the row of A */
+static bool guard_b;                        /*!< Input of the rows of B and C */
+static bool guard_q;                        /*!< Input of the first row of Q */
+static bool guard_p;                        /*!< Input of the row of P */
+static bool guard_d;                        /*!< Input of the row of D */
+static uint32_t guard_calls;                /*!< Input functions called */
+static fsm_t fsm;                           /*!< Test FSM */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Append an action to the log.
+ *
+ * @param p_action Action.
+ */
+static void _test_log(const char *p_action)
+{
+    strncat(log_actions, p_action, sizeof(log_actions) - strlen(log_actions) - 1);
+}
+
+/** @brief Entry and exit actions of a state, that log themselves */
+#define TEST_HSM_STATE_ACTIONS(state)                                       \
+    static void _test_entry_##state(fsm_t *p_this) { _test_log("+" #state); } \
+    static void _test_exit_##state(fsm_t *p_this) { _test_log("-" #state); }
+
+TEST_HSM_STATE_ACTIONS(A)
+TEST_HSM_STATE_ACTIONS(B)
+TEST_HSM_STATE_ACTIONS(C)
+TEST_HSM_STATE_ACTIONS(D)
+TEST_HSM_STATE_ACTIONS(Q)
+TEST_HSM_STATE_ACTIONS(P)
+
+static bool _test_check_a(fsm_t *p_this) { guard_calls++; return guard_a; }
+static bool _test_check_b(fsm_t *p_this) { guard_calls++; return guard_b; }
+static bool _test_check_q(fsm_t *p_this) { guard_calls++; return guard_q; }
+static bool _test_check_p(fsm_t *p_this) { guard_calls++; return guard_p; }
+static bool _test_check_d(fsm_t *p_this) { guard_calls++; return guard_d; }
+static void _test_do_output(fsm_t *p_this) { _test_log("!"); }
+
+/**
+ * @brief Transitions table of the test FSM, with the rows of every state together.
+ */
+static const fsm_trans_t test_hsm_tt[] = {
+    {A, _test_check_a, Q, _test_do_output},
+    {B, _test_check_b, C, _test_do_output},
+    {C, _test_check_b, C, _test_do_output},
+    {D, _test_check_d, P, _test_do_output},
+    {Q, _test_check_q, D, _test_do_output},
+    {Q, NULL, Q, NULL},
+    {P, _test_check_p, D, _test_do_output},
+    {-1, NULL, -1, NULL}};
+
+/**
+ * @brief States of the test FSM: P{A, Q{B, C}} and D.
+ */
+static const fsm_hierarchical_state_t test_hsm_states[] = {
+    [A] = {P, FSM_HIERARCHICAL_NONE, _test_entry_A, _test_exit_A},
+    [B] = {Q, FSM_HIERARCHICAL_NONE, _test_entry_B, _test_exit_B},
+    [C] = {Q, FSM_HIERARCHICAL_NONE, _test_entry_C, _test_exit_C},
+    [D] = {FSM_HIERARCHICAL_NONE, FSM_HIERARCHICAL_NONE, _test_entry_D, _test_exit_D},
+    [Q] = {P, B, _test_entry_Q, _test_exit_Q},
+    [P] = {FSM_HIERARCHICAL_NONE, A, _test_entry_P, _test_exit_P}};
+
+/**
+ * @brief Rows of every state of the test FSM.
+ */
+static fsm_indexed_slot_t test_hsm_slots[FSM_HIERARCHICAL_NUM_STATES(test_hsm_states)];
+
+/**
+ * @brief Test FSM.
+ */
+static const fsm_hierarchical_t test_hsm = {test_hsm_tt, test_hsm_states, test_hsm_slots, FSM_HIERARCHICAL_NUM_STATES(test_hsm_states)};
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    fsm_hierarchical_init(&test_hsm);
+    fsm_init(&fsm, (fsm_trans_t *)test_hsm_tt); /* The FSM library only reads the table */
+    log_actions[0] = '\0';
+    guard_a = false;
+    guard_b = false;
+    guard_q = false;
+    guard_p = false;
+    guard_d = false;
+    guard_calls = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_initial_descent(void)
+{
+    guard_a = true;
+    UNITY_TEST_ASSERT_EQUAL_INT(1, fsm_hierarchical_fire(&fsm, &test_hsm), __LINE__, "ERROR: the transition did not fire");
+    UNITY_TEST_ASSERT_EQUAL_INT(B, fsm_get_state(&fsm), __LINE__, "ERROR: the transition to a composite state did not enter its initial state");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-A!+Q+B", log_actions, __LINE__, "ERROR: wrong exits and entries of the transition to a composite state");
+}
+
+void test_exits_and_entries_up_to_the_common_state(void)
+{
+    fsm_set_state(&fsm, B);
+    guard_q = true;
+    fsm_hierarchical_fire(&fsm, &test_hsm);
+    UNITY_TEST_ASSERT_EQUAL_INT(D, fsm_get_state(&fsm), __LINE__, "ERROR: the inherited transition did not fire");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-B-Q-P!+D", log_actions, __LINE__, "ERROR: the states were not exited from the leaf up");
+
+    log_actions[0] = '\0';
+    guard_d = true;
+    fsm_hierarchical_fire(&fsm, &test_hsm);
+    UNITY_TEST_ASSERT_EQUAL_INT(A, fsm_get_state(&fsm), __LINE__, "ERROR: the transition to a top composite state did not enter its initial state");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-D!+P+A", log_actions, __LINE__, "ERROR: the states were not entered from the top down");
+}
+
+void test_rows_of_the_state_first(void)
+{
+    fsm_set_state(&fsm, B);
+    guard_b = true;
+    guard_q = true;
+    guard_p = true;
+    fsm_hierarchical_fire(&fsm, &test_hsm);
+    UNITY_TEST_ASSERT_EQUAL_INT(C, fsm_get_state(&fsm), __LINE__, "ERROR: an inherited row fired before the row of the state");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-B!+C", log_actions, __LINE__, "ERROR: a transition inside a composite state exited it");
+
+    fsm_set_state(&fsm, A);
+    log_actions[0] = '\0';
+    fsm_hierarchical_fire(&fsm, &test_hsm);
+    UNITY_TEST_ASSERT_EQUAL_INT(D, fsm_get_state(&fsm), __LINE__, "ERROR: the row of the top state was not inherited");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-A-P!+D", log_actions, __LINE__, "ERROR: wrong exits of the inherited transition");
+}
+
+void test_else_row(void)
+{
+    fsm_set_state(&fsm, C);
+    guard_p = true;
+    UNITY_TEST_ASSERT_EQUAL_INT(1, fsm_hierarchical_fire(&fsm, &test_hsm), __LINE__, "ERROR: the row without input function did not fire");
+    UNITY_TEST_ASSERT_EQUAL_INT(B, fsm_get_state(&fsm), __LINE__, "ERROR: the row without input function did not go to the initial state");
+    UNITY_TEST_ASSERT_EQUAL_STRING("-C+B", log_actions, __LINE__, "ERROR: a transition to the containing state exited it");
+}
+
+void test_internal_transition(void)
+{
+    fsm_set_state(&fsm, C);
+    guard_b = true;
+    UNITY_TEST_ASSERT_EQUAL_INT(1, fsm_hierarchical_fire(&fsm, &test_hsm), __LINE__, "ERROR: the self-transition did not fire");
+    UNITY_TEST_ASSERT_EQUAL_INT(C, fsm_get_state(&fsm), __LINE__, "ERROR: the self-transition changed the state");
+    UNITY_TEST_ASSERT_EQUAL_STRING("!", log_actions, __LINE__, "ERROR: the self-transition exited or entered its state");
+}
+
+void test_guard_calls(void)
+{
+    UNITY_TEST_ASSERT_EQUAL_INT(0, fsm_hierarchical_fire(&fsm, &test_hsm), __LINE__, "ERROR: a transition fired with every input false");
+    UNITY_TEST_ASSERT_EQUAL_INT(A, fsm_get_state(&fsm), __LINE__, "ERROR: the state changed with no transition");
+    UNITY_TEST_ASSERT_EQUAL_STRING("", log_actions, __LINE__, "ERROR: an action ran with no transition");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, guard_calls, __LINE__, "ERROR: wrong input functions called from A");
+
+    fsm_set_state(&fsm, B);
+    guard_calls = 0;
+    fsm_hierarchical_fire(&fsm, &test_hsm);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, guard_calls, __LINE__, "ERROR: the rows after the row without input function were checked");
+}
+
+void test_rows_of_every_state(void)
+{
+    UNITY_TEST_ASSERT(fsm_hierarchical_init(&test_hsm), __LINE__, "ERROR: the rows of the test FSM were not built");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(4, test_hsm_slots[Q].first, __LINE__, "ERROR: wrong first row of Q");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(2, test_hsm_slots[Q].count, __LINE__, "ERROR: wrong number of rows of Q");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(6, test_hsm_slots[P].first, __LINE__, "ERROR: wrong first row of P");
+
+    const fsm_trans_t tt_apart[] = {
+        {A, _test_check_a, Q, NULL},
+        {P, _test_check_p, D, NULL},
+        {A, NULL, D, NULL},
+        {-1, NULL, -1, NULL}};
+    fsm_indexed_slot_t slots[FSM_HIERARCHICAL_NUM_STATES(test_hsm_states)];
+    const fsm_hierarchical_t hsm_apart = {tt_apart, test_hsm_states, slots, FSM_HIERARCHICAL_NUM_STATES(test_hsm_states)};
+    UNITY_TEST_ASSERT(!fsm_hierarchical_init(&hsm_apart), __LINE__, "ERROR: the rows of an FSM with the rows of a state apart were built");
+    fsm_set_state(&fsm, A);
+    UNITY_TEST_ASSERT_EQUAL_INT(0, fsm_hierarchical_fire(&fsm, &hsm_apart), __LINE__, "ERROR: an FSM with the rows of a state apart fired");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_initial_descent);
+    RUN_TEST(test_exits_and_entries_up_to_the_common_state);
+    RUN_TEST(test_rows_of_the_state_first);
+    RUN_TEST(test_else_row);
+    RUN_TEST(test_internal_transition);
+    RUN_TEST(test_guard_calls);
+    RUN_TEST(test_rows_of_every_state);
+    return UNITY_END();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_fsm_indexed.c
+ * @brief Test of the index of the transitions tables by state (`fsm_indexed.c`).
+ *
+ * The tests build the index of synthetic tables, with the rows of a state together, apart or out of the index, and fire through it. Then they build the index of the tables of the four FSMs of the Urbanite and check that every slot covers exactly the rows of its state, so that a row added or moved to another place of a table cannot be dispatched from the wrong state.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_display.h"
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm_indexed.h"
+#include "fsm_button.h"
+#include "fsm_display.h"
+#include "fsm_ultrasound.h"
+#include "fsm_urbanite.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_INDEXED_MAX_STATES 8 /*!< Most states of the FSMs under test */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_indexed_slot_t slots[TEST_INDEXED_MAX_STATES]; /*!< Index under test */
+static fsm_button_storage_t button_storage;               /*!< Storage of the button FSM */
+static fsm_ultrasound_storage_t ultrasound_storage;       /*!< Storage of the ultrasound FSM */
+static fsm_display_storage_t display_storage;             /*!< Storage of the display FSM */
+static fsm_urbanite_storage_t urbanite_storage;           /*!< Storage of the Urbanite FSM */
+
+/* Private functions ----------------------------------------------------------*/
+static bool _test_check_never(fsm_t *p_this) { return false; }
+static bool _test_check_always(fsm_t *p_this) { return true; }
+
+/**
+ * @brief Check that the index of a table has been built and that every slot covers exactly the rows of its state.
+ *
+ * @param p_tt Transitions table.
+ * @param num_states Number of states of the FSM.
+ * @param line Line of the caller.
+ */
+static void _test_indexed_check_table(const fsm_trans_t *p_tt, uint32_t num_states, int line)
+{
+    UNITY_TEST_ASSERT(fsm_indexed_init(slots, num_states, p_tt), line, "ERROR: the rows of a state of the table are not together");
+    uint32_t rows = 0;
+    for (uint32_t row = 0; p_tt[row].orig_state >= 0; row++)
+    {
+        const fsm_indexed_slot_t *p_slot = &slots[p_tt[row].orig_state];
+        UNITY_TEST_ASSERT(row >= p_slot->first && row < (uint32_t)p_slot->first + p_slot->count, line, "ERROR: a row of the table is out of the slot of its state");
+        rows++;
+    }
+    uint32_t covered = 0;
+    for (uint32_t state = 0; state < num_states; state++)
+    {
+        covered += slots[state].count;
+    }
+    UNITY_TEST_ASSERT_EQUAL_UINT32(rows, covered, line, "ERROR: the slots cover rows of other states");
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_rows_together(void)
+{
+    const fsm_trans_t tt[] = {
+        {1, _test_check_never, 0, NULL},
+        {0, _test_check_never, 1, NULL},
+        {0, _test_check_always, 2, NULL},
+        {2, _test_check_always, 0, NULL},
+        {-1, NULL, -1, NULL}};
+    UNITY_TEST_ASSERT(fsm_indexed_init(slots, 3, tt), __LINE__, "ERROR: the index of a table with the rows of every state together was not built");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(1, slots[0].first, __LINE__, "ERROR: wrong first row of state 0");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(2, slots[0].count, __LINE__, "ERROR: wrong number of rows of state 0");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(0, slots[1].first, __LINE__, "ERROR: wrong first row of state 1");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(3, slots[2].first, __LINE__, "ERROR: wrong first row of state 2");
+
+    fsm_t fsm;
+    fsm_indexed_t index = {slots, 3};
+    fsm_init(&fsm, (fsm_trans_t *)tt); /* The FSM library only reads the table */
+    fsm_set_state(&fsm, 0);
+    UNITY_TEST_ASSERT_EQUAL_INT(1, fsm_indexed_fire(&fsm, &index), __LINE__, "ERROR: no transition fired");
+    UNITY_TEST_ASSERT_EQUAL_INT(2, fsm_get_state(&fsm), __LINE__, "ERROR: the first row of the state whose input is true did not fire");
+}
+
+void test_state_without_rows(void)
+{
+    const fsm_trans_t tt[] = {
+        {0, _test_check_always, 1, NULL},
+        {-1, NULL, -1, NULL}};
+    UNITY_TEST_ASSERT(fsm_indexed_init(slots, 2, tt), __LINE__, "ERROR: the index of a table with a state without rows was not built");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(0, slots[1].count, __LINE__, "ERROR: a state without rows has rows");
+}
+
+void test_rows_apart(void)
+{
+    const fsm_trans_t tt[] = {
+        {0, _test_check_never, 1, NULL},
+        {1, _test_check_always, 0, NULL},
+        {0, _test_check_always, 1, NULL},
+        {-1, NULL, -1, NULL}};
+    UNITY_TEST_ASSERT(!fsm_indexed_init(slots, 2, tt), __LINE__, "ERROR: the index of a table with the rows of a state apart was built");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(0, slots[0].count, __LINE__, "ERROR: the slots were not left empty");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(0, slots[1].count, __LINE__, "ERROR: the slots were not left empty");
+}
+
+void test_state_out_of_the_index(void)
+{
+    const fsm_trans_t tt[] = {
+        {0, _test_check_always, 1, NULL},
+        {2, _test_check_always, 0, NULL},
+        {-1, NULL, -1, NULL}};
+    UNITY_TEST_ASSERT(!fsm_indexed_init(slots, 2, tt), __LINE__, "ERROR: the index of a table with a state out of the slots was built");
+    UNITY_TEST_ASSERT_EQUAL_UINT8(0, slots[0].count, __LINE__, "ERROR: the slots were not left empty");
+}
+
+void test_tables_of_the_urbanite(void)
+{
+    fsm_button_t *p_fsm_button = fsm_button_init(&button_storage, 150, PORT_PARKING_BUTTON_ID);
+    fsm_ultrasound_t *p_fsm_ultrasound = fsm_ultrasound_init(&ultrasound_storage, PORT_REAR_PARKING_SENSOR_ID);
+    fsm_display_t *p_fsm_display = fsm_display_init(&display_storage, PORT_REAR_PARKING_DISPLAY_ID);
+    fsm_urbanite_t *p_fsm_urbanite = fsm_urbanite_init(&urbanite_storage, p_fsm_button, 1000, 500, p_fsm_ultrasound, p_fsm_display);
+
+    _test_indexed_check_table(fsm_button_get_inner_fsm(p_fsm_button)->p_tt, BUTTON_PRESSED_WAIT + 1, __LINE__);
+    _test_indexed_check_table(fsm_ultrasound_get_inner_fsm(p_fsm_ultrasound)->p_tt, SET_DISTANCE + 1, __LINE__);
+    _test_indexed_check_table(fsm_display_get_inner_fsm(p_fsm_display)->p_tt, SET_DISPLAY + 1, __LINE__);
+    _test_indexed_check_table(((fsm_t *)p_fsm_urbanite)->p_tt, SLEEP_WHILE_ON + 1, __LINE__);
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rows_together);
+    RUN_TEST(test_state_without_rows);
+    RUN_TEST(test_rows_apart);
+    RUN_TEST(test_state_out_of_the_index);
+    RUN_TEST(test_tables_of_the_urbanite);
+    return UNITY_END();
+}
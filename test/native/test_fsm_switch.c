@@ -0,0 +1,191 @@
+/**
+ * @file test_fsm_switch.c
+ * @brief Test of the button and ultrasound FSMs fired with the `switch` generated from their transitions tables (`USE_FSM_SWITCH`).
+ *
+ * The tests replay the transitions of `test/test_fsm_button.c` and `test/test_fsm_ultrasound.c` on the simulated port, without the checks of the STM32F4 registers. The common sources are compiled again into the test with `USE_FSM_SWITCH`, whatever the options of the build.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm.h"
+#include "fsm_button.h"
+#include "fsm_ultrasound.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_SWITCH_DEBOUNCE_MS 150 /*!< Debounce time of the button FSM */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t button_storage;         /*!< Storage of the button FSM */
+static fsm_ultrasound_storage_t ultrasound_storage; /*!< Storage of the ultrasound FSM */
+static fsm_button_t *p_fsm_button;                  /*!< Button FSM under test */
+static fsm_ultrasound_t *p_fsm_ultrasound;          /*!< Ultrasound FSM under test */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Press the button for some time and release it, checking every transition of the button FSM.
+ *
+ * @param press_ms Duration of the press.
+ */
+static void _test_switch_button_press(uint32_t press_ms)
+{
+    port_button_set_pressed(PORT_PARKING_BUTTON_ID, true);
+    fsm_button_fire(p_fsm_button);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_PRESSED_WAIT, fsm_button_get_state(p_fsm_button), __LINE__, "ERROR: the FSM did not change to BUTTON_PRESSED_WAIT after pressing the button");
+
+    port_system_delay_ms(press_ms);
+    fsm_button_fire(p_fsm_button);
+    if (press_ms < TEST_SWITCH_DEBOUNCE_MS)
+    {
+#ifndef USE_HW_DEBOUNCE /* The port debounces the edges with its timer */
+        UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_PRESSED_WAIT, fsm_button_get_state(p_fsm_button), __LINE__, "ERROR: the FSM left BUTTON_PRESSED_WAIT before the debounce time");
+#endif
+        return;
+    }
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_PRESSED, fsm_button_get_state(p_fsm_button), __LINE__, "ERROR: the FSM did not change to BUTTON_PRESSED after the debounce time");
+
+    port_button_set_pressed(PORT_PARKING_BUTTON_ID, false);
+    fsm_button_fire(p_fsm_button);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_RELEASED_WAIT, fsm_button_get_state(p_fsm_button), __LINE__, "ERROR: the FSM did not change to BUTTON_RELEASED_WAIT after releasing the button");
+
+    port_system_delay_ms(TEST_SWITCH_DEBOUNCE_MS + 1);
+    fsm_button_fire(p_fsm_button);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_RELEASED, fsm_button_get_state(p_fsm_button), __LINE__, "ERROR: the FSM did not change to BUTTON_RELEASED after the debounce time");
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    native_system_advance_ms(1); /* the first tick is not 0 */
+    p_fsm_button = fsm_button_init(&button_storage, TEST_SWITCH_DEBOUNCE_MS, PORT_PARKING_BUTTON_ID);
+    p_fsm_ultrasound = fsm_ultrasound_init(&ultrasound_storage, PORT_REAR_PARKING_SENSOR_ID);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_button_initial_config(void)
+{
+    fsm_t *p_inner_fsm = fsm_button_get_inner_fsm(p_fsm_button);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_RELEASED, fsm_get_state(p_inner_fsm), __LINE__, "ERROR: the initial state of the button FSM is not BUTTON_RELEASED");
+    UNITY_TEST_ASSERT_EQUAL_INT(-1, p_inner_fsm->p_tt[4].orig_state, __LINE__, "ERROR: the transitions table of the button FSM does not have 4 rows");
+}
+
+void test_button_short_press(void)
+{
+    _test_switch_button_press(100);
+}
+
+void test_button_long_press(void)
+{
+    _test_switch_button_press(1000);
+}
+
+void test_ultrasound_initial_config(void)
+{
+    fsm_t *p_inner_fsm = fsm_ultrasound_get_inner_fsm(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(WAIT_START, fsm_get_state(p_inner_fsm), __LINE__, "ERROR: the initial state of the ultrasound FSM is not WAIT_START");
+    UNITY_TEST_ASSERT_EQUAL_INT(-1, p_inner_fsm->p_tt[6].orig_state, __LINE__, "ERROR: the transitions table of the ultrasound FSM does not have 6 rows");
+}
+
+void test_ultrasound_start_and_trigger_end(void)
+{
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_set_status(p_fsm_ultrasound, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(TRIGGER_START, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to TRIGGER_START at the start of a measurement");
+
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(WAIT_ECHO_START, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to WAIT_ECHO_START at the end of the trigger");
+    UNITY_TEST_ASSERT(!port_ultrasound_get_trigger_end(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: the end of the trigger was not cleared");
+}
+
+void test_ultrasound_echo_init(void)
+{
+    fsm_ultrasound_set_state(p_fsm_ultrasound, WAIT_ECHO_START);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 0);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(WAIT_ECHO_START, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM left WAIT_ECHO_START without the tick of the echo");
+
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(WAIT_ECHO_END, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to WAIT_ECHO_END with the tick of the echo");
+}
+
+void test_ultrasound_echo_received_and_distance(void)
+{
+    const uint32_t init_ticks[FSM_ULTRASOUND_NUM_MEASUREMENTS] = {1, 64371, 3, 63208, 5};
+    const uint32_t end_ticks[FSM_ULTRASOUND_NUM_MEASUREMENTS] = {584, 3, 1752, 4, 2920};
+    const uint32_t overflows[FSM_ULTRASOUND_NUM_MEASUREMENTS] = {0, 1, 0, 1, 0};
+
+    for (uint32_t i = 0; i < FSM_ULTRASOUND_NUM_MEASUREMENTS; i++)
+    {
+        fsm_ultrasound_set_state(p_fsm_ultrasound, WAIT_ECHO_END);
+        port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+        port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, init_ticks[i]);
+        port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, end_ticks[i]);
+        port_ultrasound_set_echo_overflows(PORT_REAR_PARKING_SENSOR_ID, overflows[i]);
+        fsm_ultrasound_fire(p_fsm_ultrasound);
+        UNITY_TEST_ASSERT_EQUAL_INT(SET_DISTANCE, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to SET_DISTANCE with the echo");
+        UNITY_TEST_ASSERT(!port_ultrasound_get_echo_received(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: the echo was not cleared");
+    }
+    UNITY_TEST_ASSERT(fsm_ultrasound_get_new_measurement_ready(p_fsm_ultrasound), __LINE__, "ERROR: no new measurement with the buffer full");
+    UNITY_TEST_ASSERT_UINT32_WITHIN(1, 30, fsm_ultrasound_get_distance(p_fsm_ultrasound), __LINE__, "ERROR: wrong median of the distances");
+}
+
+void test_ultrasound_new_measurement(void)
+{
+    fsm_ultrasound_set_state(p_fsm_ultrasound, SET_DISTANCE);
+    fsm_ultrasound_set_status(p_fsm_ultrasound, true);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(TRIGGER_START, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to TRIGGER_START from SET_DISTANCE for a new measurement");
+}
+
+void test_ultrasound_stop(void)
+{
+    fsm_ultrasound_set_state(p_fsm_ultrasound, SET_DISTANCE);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, false);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    fsm_ultrasound_set_status(p_fsm_ultrasound, false);
+    fsm_ultrasound_fire(p_fsm_ultrasound);
+    UNITY_TEST_ASSERT_EQUAL_INT(WAIT_START, fsm_ultrasound_get_state(p_fsm_ultrasound), __LINE__, "ERROR: the FSM did not change to WAIT_START from SET_DISTANCE when stopped");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, port_ultrasound_get_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: the tick of the echo was not reset when stopped");
+    UNITY_TEST_ASSERT(!port_ultrasound_get_echo_received(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: the echo was not cleared when stopped");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_button_initial_config);
+    RUN_TEST(test_button_short_press);
+    RUN_TEST(test_button_long_press);
+    RUN_TEST(test_ultrasound_initial_config);
+    RUN_TEST(test_ultrasound_start_and_trigger_end);
+    RUN_TEST(test_ultrasound_echo_init);
+    RUN_TEST(test_ultrasound_echo_received_and_distance);
+    RUN_TEST(test_ultrasound_new_measurement);
+    RUN_TEST(test_ultrasound_stop);
+    return UNITY_END();
+}
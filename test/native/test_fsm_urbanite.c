@@ -0,0 +1,166 @@
+/**
+ * @file test_fsm_urbanite.c
+ * @brief Test of the Urbanite FSM with the simulated button, ultrasound and display: turn on with the ON/OFF press and pause the display with a click that arrives in the same fire as a new measurement.
+ *
+ * The Urbanite FSM takes one gesture event per fire and drops it if no transition uses it, so the rows of the button events of MEASURE must be checked before the row of the new measurement.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_display.h"
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm.h"
+#include "fsm_button.h"
+#include "fsm_display.h"
+#include "fsm_ultrasound.h"
+#include "fsm_urbanite.h"
+#include "native_button.h"
+#include "native_system.h"
+#include "native_ultrasound.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_URBANITE_DEBOUNCE_MS 150           /*!< Debounce time of the button FSM */
+#define TEST_URBANITE_ON_OFF_PRESS_TIME_MS 1000 /*!< Time of the ON/OFF press */
+#define TEST_URBANITE_PAUSE_TIME_MS 500         /*!< Time of the press that pauses the display */
+#define TEST_URBANITE_DISTANCE_CM 100           /*!< Distance of the obstacle */
+#define TEST_URBANITE_TIMEOUT_MS 5000           /*!< Longest wait for a measurement */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t button_storage;         /*!< Storage of the button FSM */
+static fsm_ultrasound_storage_t ultrasound_storage; /*!< Storage of the ultrasound FSM */
+static fsm_display_storage_t display_storage;       /*!< Storage of the display FSM */
+static fsm_urbanite_storage_t urbanite_storage;     /*!< Storage of the Urbanite FSM */
+static fsm_button_t *p_fsm_button;                  /*!< Button FSM */
+static fsm_ultrasound_t *p_fsm_ultrasound;          /*!< Ultrasound FSM */
+static fsm_display_t *p_fsm_display;                /*!< Display FSM */
+static fsm_urbanite_t *p_fsm_urbanite;              /*!< Urbanite FSM under test */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Advance the simulated time ms by ms, firing the FSMs every ms in the order of the main loop.
+ *
+ * @param ms Time to advance.
+ */
+static void _test_urbanite_run_ms(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        native_system_advance_ms(1);
+        fsm_button_fire(p_fsm_button);
+        fsm_ultrasound_fire(p_fsm_ultrasound);
+        fsm_display_fire(p_fsm_display);
+        fsm_urbanite_fire(p_fsm_urbanite);
+    }
+}
+
+/**
+ * @brief Hold the button, firing the FSMs every ms, until the Urbanite FSM turns on, then release it and wait for the debounce.
+ *
+ * The press lasts at least the ON/OFF time: while the Urbanite sleeps in `SLEEP_WHILE_OFF`, the SysTick is suspended and the system tick lags behind the simulated time.
+ *
+ * @return true If the Urbanite FSM turned on while the button was held.
+ */
+static bool _test_urbanite_turn_on(void)
+{
+    uint32_t ms = 0;
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false);
+    while (fsm_get_state((fsm_t *)p_fsm_urbanite) != MEASURE && ms < TEST_URBANITE_TIMEOUT_MS)
+    {
+        _test_urbanite_run_ms(1);
+        ms++;
+    }
+    bool on = fsm_get_state((fsm_t *)p_fsm_urbanite) == MEASURE && ms >= TEST_URBANITE_ON_OFF_PRESS_TIME_MS;
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    _test_urbanite_run_ms(TEST_URBANITE_DEBOUNCE_MS + 1);
+    return on;
+}
+
+/**
+ * @brief Press and release the button, firing only the button FSM, so that the gesture event stays queued in the Urbanite FSM.
+ *
+ * @param press_ms Duration of the press.
+ */
+static void _test_urbanite_click_unfired(uint32_t press_ms)
+{
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false);
+    for (uint32_t i = 0; i < press_ms + TEST_URBANITE_DEBOUNCE_MS + 1; i++)
+    {
+        if (i == press_ms)
+        {
+            native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+        }
+        native_system_advance_ms(1);
+        fsm_button_fire(p_fsm_button);
+    }
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    native_system_advance_ms(1); /* the first tick is not 0 */
+    native_ultrasound_set_distance_cm(PORT_REAR_PARKING_SENSOR_ID, TEST_URBANITE_DISTANCE_CM);
+    p_fsm_button = fsm_button_init(&button_storage, TEST_URBANITE_DEBOUNCE_MS, PORT_PARKING_BUTTON_ID);
+    p_fsm_ultrasound = fsm_ultrasound_init(&ultrasound_storage, PORT_REAR_PARKING_SENSOR_ID);
+    p_fsm_display = fsm_display_init(&display_storage, PORT_REAR_PARKING_DISPLAY_ID);
+    p_fsm_urbanite = fsm_urbanite_init(&urbanite_storage, p_fsm_button, TEST_URBANITE_ON_OFF_PRESS_TIME_MS, TEST_URBANITE_PAUSE_TIME_MS, p_fsm_ultrasound, p_fsm_display);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_turn_on(void)
+{
+    UNITY_TEST_ASSERT(_test_urbanite_turn_on(), __LINE__, "ERROR: the Urbanite did not turn on while the ON/OFF press was held");
+    UNITY_TEST_ASSERT(fsm_display_get_status(p_fsm_display), __LINE__, "ERROR: the display is not active after the Urbanite turned on");
+    int state = fsm_get_state((fsm_t *)p_fsm_urbanite);
+    UNITY_TEST_ASSERT(state == MEASURE || state == SLEEP_WHILE_ON, __LINE__, "ERROR: the release of the ON/OFF press turned the Urbanite off");
+    UNITY_TEST_ASSERT(fsm_ultrasound_get_status(p_fsm_ultrasound), __LINE__, "ERROR: the release of the ON/OFF press stopped the ultrasound sensor");
+}
+
+void test_click_with_new_measurement(void)
+{
+    UNITY_TEST_ASSERT(_test_urbanite_turn_on(), __LINE__, "ERROR: the Urbanite did not turn on");
+
+    _test_urbanite_click_unfired(TEST_URBANITE_PAUSE_TIME_MS + 100);
+    for (uint32_t ms = 0; !fsm_ultrasound_get_new_measurement_ready(p_fsm_ultrasound) && ms < TEST_URBANITE_TIMEOUT_MS; ms++)
+    {
+        native_system_advance_ms(1);
+        fsm_ultrasound_fire(p_fsm_ultrasound);
+    }
+    UNITY_TEST_ASSERT(fsm_ultrasound_get_new_measurement_ready(p_fsm_ultrasound), __LINE__, "ERROR: no new measurement");
+
+    fsm_set_state((fsm_t *)p_fsm_urbanite, MEASURE); /* It may have gone to sleep while it waited for the measurement */
+    fsm_urbanite_fire(p_fsm_urbanite);
+    UNITY_TEST_ASSERT(!fsm_display_get_status(p_fsm_display), __LINE__, "ERROR: the click that arrived with a new measurement did not pause the display");
+    UNITY_TEST_ASSERT(fsm_ultrasound_get_new_measurement_ready(p_fsm_ultrasound), __LINE__, "ERROR: the new measurement was taken before the click");
+
+    fsm_urbanite_fire(p_fsm_urbanite);
+    UNITY_TEST_ASSERT(!fsm_ultrasound_get_new_measurement_ready(p_fsm_ultrasound), __LINE__, "ERROR: the new measurement was not taken in the next fire");
+    UNITY_TEST_ASSERT(!fsm_display_get_status(p_fsm_display), __LINE__, "ERROR: the display resumed with a far obstacle while paused");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_turn_on);
+    RUN_TEST(test_click_with_new_measurement);
+    return UNITY_END();
+}
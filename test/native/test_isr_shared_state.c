@@ -0,0 +1,174 @@
+/**
+ * @file test_isr_shared_state.c
+ * @brief Regression test for the state shared between the ISRs and the FSMs of the native platform.
+ *
+ * The FSMs poll flags that are written by the ISRs (e.g. `port_ultrasound_get_trigger_end()`). If a field of the shared state is not `volatile`, an optimizing compiler may read it once and spin forever on the stale value. The test builds the port with `-O3 -flto`, so that the getters are inlined into the polling loops, and writes every flag from another thread (the "ISR") while the main thread polls it. A watchdog ends the test with an error if a loop never sees the new value.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _DEFAULT_SOURCE /*!< Needed by usleep() */
+
+/* Standard C includes */
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_ultrasound.h"
+#include "port_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_ISR_DELAY_US 20000     /*!< Time the "ISR" thread waits before writing, so that the main thread is already polling */
+#define TEST_ISR_WATCHDOG_S 2       /*!< Time after which a polling loop is considered stuck */
+#define TEST_ISR_ECHO_END_TICK 1234 /*!< Value written to the end tick of the echo */
+
+/* Typedefs --------------------------------------------------------------------*/
+/** @brief Write done by the "ISR" thread */
+typedef void (*test_isr_write_t)(void);
+
+/* Global variables ------------------------------------------------------------*/
+static const char *p_polled_name = "";   /*!< Name of the field being polled, for the watchdog message */
+static test_isr_write_t isr_write = NULL; /*!< Write done by the "ISR" thread */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Watchdog: a polling loop has not seen the value written by the "ISR".
+ */
+static void _test_isr_watchdog(int signum)
+{
+    static const char msg[] = "ERROR: the polling loop never saw the write of the ISR (missing volatile?): ";
+    write(STDERR_FILENO, msg, sizeof(msg) - 1);
+    write(STDERR_FILENO, p_polled_name, strlen(p_polled_name));
+    write(STDERR_FILENO, "\n", 1);
+    _exit(1);
+}
+
+/**
+ * @brief Body of the "ISR" thread: wait, then do the write.
+ */
+static void *_test_isr_thread(void *p_arg)
+{
+    usleep(TEST_ISR_DELAY_US);
+    isr_write();
+    return NULL;
+}
+
+/**
+ * @brief Start the "ISR" thread and the watchdog before a polling loop.
+ */
+static pthread_t _test_isr_start(const char *p_name, test_isr_write_t write_fn)
+{
+    pthread_t thread;
+    p_polled_name = p_name;
+    isr_write = write_fn;
+    alarm(TEST_ISR_WATCHDOG_S);
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, _test_isr_thread, NULL));
+    return thread;
+}
+
+/**
+ * @brief Wait for the "ISR" thread and stop the watchdog after a polling loop.
+ */
+static void _test_isr_end(pthread_t thread)
+{
+    alarm(0);
+    pthread_join(thread, NULL);
+}
+
+static void _isr_set_trigger_end(void) { port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true); }
+static void _isr_set_trigger_ready(void) { port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true); }
+static void _isr_set_echo_received(void) { port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true); }
+static void _isr_set_echo_end_tick(void) { port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, TEST_ISR_ECHO_END_TICK); }
+static void _isr_set_echo_overflows(void) { port_ultrasound_set_echo_overflows(PORT_REAR_PARKING_SENSOR_ID, 1); }
+static void _isr_set_pressed(void) { port_button_set_pressed(PORT_PARKING_BUTTON_ID, true); }
+
+void setUp(void)
+{
+    signal(SIGALRM, _test_isr_watchdog);
+    port_ultrasound_init(PORT_REAR_PARKING_SENSOR_ID);
+    port_button_init(PORT_PARKING_BUTTON_ID);
+}
+
+void tearDown(void)
+{
+    alarm(0);
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_trigger_end(void)
+{
+    pthread_t thread = _test_isr_start("trigger_end", _isr_set_trigger_end);
+    while (!port_ultrasound_get_trigger_end(PORT_REAR_PARKING_SENSOR_ID))
+    {
+    }
+    _test_isr_end(thread);
+}
+
+void test_trigger_ready(void)
+{
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, false);
+    pthread_t thread = _test_isr_start("trigger_ready", _isr_set_trigger_ready);
+    while (!port_ultrasound_get_trigger_ready(PORT_REAR_PARKING_SENSOR_ID))
+    {
+    }
+    _test_isr_end(thread);
+}
+
+void test_echo_received(void)
+{
+    pthread_t thread = _test_isr_start("echo_received", _isr_set_echo_received);
+    while (!port_ultrasound_get_echo_received(PORT_REAR_PARKING_SENSOR_ID))
+    {
+    }
+    _test_isr_end(thread);
+}
+
+void test_echo_end_tick(void)
+{
+    pthread_t thread = _test_isr_start("echo_end_tick", _isr_set_echo_end_tick);
+    while (port_ultrasound_get_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID) != TEST_ISR_ECHO_END_TICK)
+    {
+    }
+    _test_isr_end(thread);
+}
+
+void test_echo_overflows(void)
+{
+    pthread_t thread = _test_isr_start("echo_overflows", _isr_set_echo_overflows);
+    while (port_ultrasound_get_echo_overflows(PORT_REAR_PARKING_SENSOR_ID) == 0)
+    {
+    }
+    _test_isr_end(thread);
+}
+
+void test_button_pressed(void)
+{
+    pthread_t thread = _test_isr_start("flag_pressed", _isr_set_pressed);
+    while (!port_button_get_pressed(PORT_PARKING_BUTTON_ID))
+    {
+    }
+    _test_isr_end(thread);
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_trigger_end);
+    RUN_TEST(test_trigger_ready);
+    RUN_TEST(test_echo_received);
+    RUN_TEST(test_echo_end_tick);
+    RUN_TEST(test_echo_overflows);
+    RUN_TEST(test_button_pressed);
+    return UNITY_END();
+}
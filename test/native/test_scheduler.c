@@ -0,0 +1,254 @@
+/**
+ * @file test_scheduler.c
+ * @brief Test of the cooperative scheduler of the FSMs.
+ *
+ * The tests run synthetic tasks, whose jobs record their order and can take simulated time, in a loop like the main loop of the firmware: a step of the scheduler, and a sleep without the SysTick when no job ran. They check the rates, the priority order (also for a task released during a job of lower priority), the checks of the periodic and event tasks, the parking of a periodic task with nothing to do, the deadline misses and that the sleep lasts until the next release.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "scheduler.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_SCHEDULER_NUM_TASKS 3  /*!< Tasks of the scheduler under test */
+#define TEST_SCHEDULER_MAX_JOBS 64  /*!< Jobs recorded in `order` */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Context of a synthetic task.
+ */
+typedef struct
+{
+    /** @brief Identifier recorded in `order` */
+    uint32_t id;
+    /** @brief Simulated time in µs taken by every job */
+    uint32_t job_us;
+    /** @brief Value returned by the check of the task */
+    bool has_work;
+} test_scheduler_ctx_t;
+
+/* Global variables ------------------------------------------------------------*/
+static soft_timer_service_t timers;                                 /*!< Software timers of the scheduler under test */
+static soft_timer_t *timers_heap[TEST_SCHEDULER_NUM_TASKS];          /*!< Array of the heap of the software timers */
+static scheduler_t scheduler;                                        /*!< Scheduler under test */
+static scheduler_task_t *tasks_array[TEST_SCHEDULER_NUM_TASKS];      /*!< Array of the tasks of the scheduler */
+static scheduler_task_t tasks[TEST_SCHEDULER_NUM_TASKS];             /*!< Tasks under test */
+static test_scheduler_ctx_t ctxs[TEST_SCHEDULER_NUM_TASKS];          /*!< Contexts of the tasks under test */
+static uint32_t order[TEST_SCHEDULER_MAX_JOBS];                      /*!< Identifiers of the tasks in the order of their jobs */
+static uint32_t order_count;                                         /*!< Jobs recorded in `order` */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Job of a synthetic task: record its order and take its simulated time.
+ *
+ * @param p_ctx Context of the task.
+ */
+static void _test_scheduler_fire(void *p_ctx)
+{
+    test_scheduler_ctx_t *p_test = (test_scheduler_ctx_t *)p_ctx;
+    if (order_count < TEST_SCHEDULER_MAX_JOBS)
+    {
+        order[order_count++] = p_test->id;
+    }
+    native_system_advance_us(p_test->job_us);
+}
+
+/**
+ * @brief Check of a synthetic task.
+ *
+ * @param p_ctx Context of the task.
+ * @return true If the task has work to do.
+ */
+static bool _test_scheduler_check(void *p_ctx)
+{
+    return ((test_scheduler_ctx_t *)p_ctx)->has_work;
+}
+
+/**
+ * @brief Add a synthetic task to the scheduler.
+ *
+ * @param i Index of the task (its identifier).
+ * @param period_us Period in µs (0: event task).
+ * @param deadline_us Deadline in µs.
+ * @param priority Priority.
+ * @param with_check Flag to give the task a check function.
+ * @param first_release_us Time of the first periodic release.
+ */
+static void _test_scheduler_add(uint32_t i, uint32_t period_us, uint32_t deadline_us, uint8_t priority, bool with_check, uint64_t first_release_us)
+{
+    scheduler_task_config_t config = {_test_scheduler_fire, with_check ? _test_scheduler_check : NULL, &ctxs[i], period_us, deadline_us, priority};
+    scheduler_task_init(&tasks[i], &config);
+    UNITY_TEST_ASSERT(scheduler_add_task(&scheduler, &tasks[i], first_release_us), __LINE__, "ERROR: a task was not added");
+}
+
+/**
+ * @brief Run the loop of the firmware until a simulated time: a step, and a sleep when no job ran.
+ *
+ * @param until_us Time in µs.
+ * @return uint32_t Number of sleeps.
+ */
+static uint32_t _test_scheduler_run_until(uint64_t until_us)
+{
+    uint32_t sleeps = 0;
+    while (port_system_get_micros64() < until_us)
+    {
+        if (scheduler_step(&scheduler) == 0)
+        {
+            port_system_sleep_tickless();
+            sleeps++;
+        }
+    }
+    return sleeps;
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    soft_timer_service_init(&timers, timers_heap, TEST_SCHEDULER_NUM_TASKS);
+    scheduler_init(&scheduler, tasks_array, TEST_SCHEDULER_NUM_TASKS, &timers);
+    for (uint32_t i = 0; i < TEST_SCHEDULER_NUM_TASKS; i++)
+    {
+        ctxs[i].id = i;
+        ctxs[i].job_us = 0;
+        ctxs[i].has_work = false;
+    }
+    order_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_tasks_run_at_their_rates(void)
+{
+    _test_scheduler_add(0, 1000, 1000, 0, false, 0);
+    _test_scheduler_add(1, 20000, 20000, 1, false, 0);
+
+    uint32_t sleeps = _test_scheduler_run_until(100000);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(100, scheduler_task_get_runs(&tasks[0]), __LINE__, "ERROR: the 1 ms task did not run once per period");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(5, scheduler_task_get_runs(&tasks[1]), __LINE__, "ERROR: the 20 ms task did not run once per period");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(100, sleeps, __LINE__, "ERROR: the loop did not sleep between the releases");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_task_get_misses(&tasks[0]) + scheduler_task_get_misses(&tasks[1]), __LINE__, "ERROR: deadline misses without load");
+}
+
+void test_released_tasks_run_in_priority_order(void)
+{
+    /* Added in the reverse order of their priorities, all released at once */
+    _test_scheduler_add(2, 1000, 1000, 2, false, 0);
+    _test_scheduler_add(0, 1000, 1000, 0, false, 0);
+    _test_scheduler_add(1, 1000, 1000, 1, false, 0);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(3, scheduler_step(&scheduler), __LINE__, "ERROR: not every released task ran");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, order[0], __LINE__, "ERROR: the task of highest priority did not run first");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, order[1], __LINE__, "ERROR: the tasks did not run in priority order");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, order[2], __LINE__, "ERROR: the task of lowest priority did not run last");
+}
+
+void test_task_released_during_a_job_runs_first(void)
+{
+    /* The long job of task 1 lets task 0 be released before task 2 runs */
+    ctxs[1].job_us = 1500;
+    _test_scheduler_add(0, 1000, 1000, 0, false, 1000);
+    _test_scheduler_add(1, 10000, 10000, 1, false, 0);
+    _test_scheduler_add(2, 10000, 10000, 2, false, 0);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(3, scheduler_step(&scheduler), __LINE__, "ERROR: not every released task ran");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, order[0], __LINE__, "ERROR: wrong first job");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, order[1], __LINE__, "ERROR: the task of higher priority released during a job did not run before the waiting task");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, order[2], __LINE__, "ERROR: wrong last job");
+}
+
+void test_periodic_task_with_check(void)
+{
+    _test_scheduler_add(0, 1000, 1000, 0, true, 0);
+
+    _test_scheduler_run_until(10000);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_task_get_runs(&tasks[0]), __LINE__, "ERROR: a task with nothing to do ran");
+
+    ctxs[0].has_work = true;
+    _test_scheduler_run_until(20000);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10, scheduler_task_get_runs(&tasks[0]), __LINE__, "ERROR: a task with work to do did not run once per period");
+}
+
+void test_parked_task(void)
+{
+    _test_scheduler_add(0, 1000, 1000, 0, true, 0);
+
+    _test_scheduler_run_until(100000);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_task_get_runs(&tasks[0]), __LINE__, "ERROR: a task with nothing to do ran");
+    UNITY_TEST_ASSERT(native_system_get_alarm_count() <= 1, __LINE__, "ERROR: the alarm of a task with nothing to do kept firing");
+    UNITY_TEST_ASSERT(native_system_get_wakeups() <= 1, __LINE__, "ERROR: the CPU woke up with no task to run");
+
+    /* Released in the first step after its check becomes true, not at the next period */
+    native_system_advance_us(300);
+    ctxs[0].has_work = true;
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, scheduler_step(&scheduler), __LINE__, "ERROR: the parked task was not released when its check became true");
+    uint64_t released_us = port_system_get_micros64();
+    _test_scheduler_run_until(released_us + 9500);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10, scheduler_task_get_runs(&tasks[0]), __LINE__, "ERROR: the period did not restart at the release of the parked task");
+}
+
+void test_event_task(void)
+{
+    _test_scheduler_add(0, 0, 100, 0, true, 0);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_step(&scheduler), __LINE__, "ERROR: an event task ran with no event");
+    ctxs[0].has_work = true;
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, scheduler_step(&scheduler), __LINE__, "ERROR: an event task did not run once per step with its event");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, scheduler_step(&scheduler), __LINE__, "ERROR: an event task did not run once per step with its event");
+    ctxs[0].has_work = false;
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_step(&scheduler), __LINE__, "ERROR: an event task ran after its event");
+}
+
+void test_deadline_misses(void)
+{
+    /* Every job takes 1.5 periods: it completes after its deadline, and the next release comes while it runs */
+    ctxs[0].job_us = 1500;
+    _test_scheduler_add(0, 1000, 1000, 0, false, 0);
+
+    _test_scheduler_run_until(10000);
+    UNITY_TEST_ASSERT(scheduler_task_get_misses(&tasks[0]) > 0, __LINE__, "ERROR: the late jobs were not counted as deadline misses");
+    UNITY_TEST_ASSERT(scheduler_task_get_max_response_us(&tasks[0]) >= 1500, __LINE__, "ERROR: the response time does not include the job");
+}
+
+void test_sleep_lasts_until_the_next_release(void)
+{
+    _test_scheduler_add(0, 250, 250, 0, false, 250);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_step(&scheduler), __LINE__, "ERROR: a task ran before its release");
+    port_system_power_sleep();
+    UNITY_TEST_ASSERT(port_system_get_micros64() == 250, __LINE__, "ERROR: the sleep did not end at the release");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, scheduler_step(&scheduler), __LINE__, "ERROR: the task did not run at its release");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, scheduler_task_get_max_response_us(&tasks[0]), __LINE__, "ERROR: the task did not run as soon as it was released");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_tasks_run_at_their_rates);
+    RUN_TEST(test_released_tasks_run_in_priority_order);
+    RUN_TEST(test_task_released_during_a_job_runs_first);
+    RUN_TEST(test_periodic_task_with_check);
+    RUN_TEST(test_parked_task);
+    RUN_TEST(test_event_task);
+    RUN_TEST(test_deadline_misses);
+    RUN_TEST(test_sleep_lasts_until_the_next_release);
+    return UNITY_END();
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_soft_timer.c
+ * @brief Test of the software timers multiplexed onto the alarm of the system.
+ *
+ * The tests start one-shot and periodic timers, advance the simulated time in µs and dispatch the service, and check the order and the times of the callbacks, the periods without drift, the timers stopped from the callbacks, and that the simulated alarm is armed for the earliest deadline and wakes the SysTick.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "soft_timer.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_SOFT_TIMER_NUM_TIMERS 64   /*!< Timers of the service under test */
+#define TEST_SOFT_TIMER_PERIOD_US 2500U /*!< Period of the periodic timers */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Timer under test, with the record of its callbacks.
+ */
+typedef struct
+{
+    /** @brief Timer */
+    soft_timer_t timer;
+    /** @brief Number of callbacks */
+    uint32_t count;
+    /** @brief Time in µs of the last callback */
+    uint64_t last_us;
+    /** @brief Timer to stop from the callback (NULL: none) */
+    soft_timer_t *p_stop;
+} test_soft_timer_t;
+
+/* Global variables ------------------------------------------------------------*/
+static soft_timer_service_t service;                                /*!< Service under test */
+static soft_timer_t *heap[TEST_SOFT_TIMER_NUM_TIMERS];               /*!< Array of the heap of the service */
+static test_soft_timer_t timers[TEST_SOFT_TIMER_NUM_TIMERS];         /*!< Timers under test */
+static uint32_t order[TEST_SOFT_TIMER_NUM_TIMERS];                   /*!< Indexes of the timers in the order of their callbacks */
+static uint32_t order_count;                                         /*!< Callbacks recorded in `order` */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Callback of the timers under test: record the time and the order, and stop a timer if requested.
+ *
+ * @param p_arg Pointer to the `test_soft_timer_t`.
+ */
+static void _test_soft_timer_callback(void *p_arg)
+{
+    test_soft_timer_t *p_test = (test_soft_timer_t *)p_arg;
+    p_test->count++;
+    p_test->last_us = port_system_get_micros64();
+    if (order_count < TEST_SOFT_TIMER_NUM_TIMERS)
+    {
+        order[order_count++] = (uint32_t)(p_test - timers);
+    }
+    if (p_test->p_stop != NULL)
+    {
+        soft_timer_stop(&service, p_test->p_stop);
+    }
+}
+
+/**
+ * @brief Advance the simulated time µs by µs, dispatching the service every µs.
+ *
+ * @param us Time to advance.
+ */
+static void _test_soft_timer_run_us(uint32_t us)
+{
+    for (uint32_t i = 0; i < us; i++)
+    {
+        native_system_advance_us(1);
+        soft_timer_dispatch(&service, port_system_get_micros64());
+    }
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    soft_timer_service_init(&service, heap, TEST_SOFT_TIMER_NUM_TIMERS);
+    for (uint32_t i = 0; i < TEST_SOFT_TIMER_NUM_TIMERS; i++)
+    {
+        soft_timer_init(&timers[i].timer, _test_soft_timer_callback, &timers[i]);
+        timers[i].count = 0;
+        timers[i].last_us = 0;
+        timers[i].p_stop = NULL;
+    }
+    order_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_one_shot_timers_fire_in_deadline_order(void)
+{
+    /* Deadlines in a scrambled order: 37 is coprime with the number of timers */
+    for (uint32_t i = 0; i < TEST_SOFT_TIMER_NUM_TIMERS; i++)
+    {
+        uint32_t slot = (i * 37U) % TEST_SOFT_TIMER_NUM_TIMERS;
+        UNITY_TEST_ASSERT(soft_timer_start(&service, &timers[slot].timer, 100U + 10U * slot, 0), __LINE__, "ERROR: a timer did not start");
+    }
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == 100U, __LINE__, "ERROR: wrong earliest deadline");
+
+    /* Restart the last timer before the others and back */
+    soft_timer_start(&service, &timers[TEST_SOFT_TIMER_NUM_TIMERS - 1].timer, 50U, 0);
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == 50U, __LINE__, "ERROR: a restarted timer did not move up the heap");
+    soft_timer_start(&service, &timers[TEST_SOFT_TIMER_NUM_TIMERS - 1].timer, 100U + 10U * (TEST_SOFT_TIMER_NUM_TIMERS - 1), 0);
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == 100U, __LINE__, "ERROR: a restarted timer did not move down the heap");
+
+    _test_soft_timer_run_us(100U + 10U * TEST_SOFT_TIMER_NUM_TIMERS);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_SOFT_TIMER_NUM_TIMERS, order_count, __LINE__, "ERROR: not every timer fired");
+    for (uint32_t i = 0; i < TEST_SOFT_TIMER_NUM_TIMERS; i++)
+    {
+        UNITY_TEST_ASSERT_EQUAL_UINT32(i, order[i], __LINE__, "ERROR: the timers did not fire in the order of their deadlines");
+        UNITY_TEST_ASSERT_EQUAL_UINT32(1, timers[i].count, __LINE__, "ERROR: a one-shot timer did not fire exactly once");
+        UNITY_TEST_ASSERT(timers[i].last_us == 100U + 10U * i, __LINE__, "ERROR: a timer did not fire at its deadline");
+        UNITY_TEST_ASSERT(!soft_timer_is_running(&timers[i].timer), __LINE__, "ERROR: a one-shot timer is still running after it fired");
+    }
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == SOFT_TIMER_NEVER, __LINE__, "ERROR: the service is not empty");
+}
+
+void test_periodic_timer_does_not_drift(void)
+{
+    soft_timer_start(&service, &timers[0].timer, TEST_SOFT_TIMER_PERIOD_US, TEST_SOFT_TIMER_PERIOD_US);
+
+    /* Dispatched late every time: the period is kept from the deadlines */
+    for (uint32_t n = 1; n <= 10; n++)
+    {
+        native_system_advance_us(TEST_SOFT_TIMER_PERIOD_US - (n == 1 ? 0U : 7U));
+        native_system_advance_us(7U);
+        soft_timer_dispatch(&service, port_system_get_micros64());
+        UNITY_TEST_ASSERT_EQUAL_UINT32(n, timers[0].count, __LINE__, "ERROR: the periodic timer did not fire once per period");
+        UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == (uint64_t)(n + 1U) * TEST_SOFT_TIMER_PERIOD_US, __LINE__, "ERROR: the period drifted with the late dispatches");
+    }
+}
+
+void test_periodic_timer_skips_missed_periods(void)
+{
+    soft_timer_start(&service, &timers[0].timer, TEST_SOFT_TIMER_PERIOD_US, TEST_SOFT_TIMER_PERIOD_US);
+    native_system_advance_us(3U * TEST_SOFT_TIMER_PERIOD_US + 100U);
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, soft_timer_dispatch(&service, port_system_get_micros64()), __LINE__, "ERROR: the missed periods were run");
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == 4U * TEST_SOFT_TIMER_PERIOD_US, __LINE__, "ERROR: the next deadline is not the next one of the period");
+}
+
+void test_timers_stopped_from_callbacks(void)
+{
+    /* The first timer stops the second one, which is also due; the third one is periodic and stops itself */
+    timers[0].p_stop = &timers[1].timer;
+    timers[2].p_stop = &timers[2].timer;
+    soft_timer_start(&service, &timers[0].timer, 100U, 0);
+    soft_timer_start(&service, &timers[1].timer, 101U, 0);
+    soft_timer_start(&service, &timers[2].timer, 50U, 10U);
+
+    native_system_advance_us(200U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, soft_timer_dispatch(&service, port_system_get_micros64()), __LINE__, "ERROR: wrong number of callbacks");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, timers[1].count, __LINE__, "ERROR: a timer stopped by a callback fired");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, timers[2].count, __LINE__, "ERROR: a periodic timer that stopped itself fired again");
+    UNITY_TEST_ASSERT(!soft_timer_is_running(&timers[2].timer), __LINE__, "ERROR: a periodic timer that stopped itself is still running");
+
+    soft_timer_stop(&service, &timers[2].timer); /* Stopping a stopped timer does nothing */
+    UNITY_TEST_ASSERT(soft_timer_get_next_deadline(&service) == SOFT_TIMER_NEVER, __LINE__, "ERROR: the service is not empty");
+}
+
+void test_heap_full(void)
+{
+    soft_timer_service_init(&service, heap, 2);
+    UNITY_TEST_ASSERT(soft_timer_start(&service, &timers[0].timer, 100U, 0), __LINE__, "ERROR: a timer did not start");
+    UNITY_TEST_ASSERT(soft_timer_start(&service, &timers[1].timer, 100U, 0), __LINE__, "ERROR: a timer did not start");
+    UNITY_TEST_ASSERT(!soft_timer_start(&service, &timers[2].timer, 50U, 0), __LINE__, "ERROR: a timer started in a full heap");
+    UNITY_TEST_ASSERT(!soft_timer_is_running(&timers[2].timer), __LINE__, "ERROR: a timer that did not start is running");
+    UNITY_TEST_ASSERT(soft_timer_start(&service, &timers[1].timer, 200U, 0), __LINE__, "ERROR: a running timer did not restart in a full heap");
+}
+
+void test_alarm_wakes_at_the_earliest_deadline(void)
+{
+    soft_timer_start(&service, &timers[0].timer, 5000U, 0);
+    soft_timer_start(&service, &timers[1].timer, 1250U, 0);
+    port_system_systick_suspend();
+
+    native_system_advance_us(1249U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, native_system_get_alarm_count(), __LINE__, "ERROR: the alarm fired before the earliest deadline");
+    native_system_advance_us(1U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, native_system_get_alarm_count(), __LINE__, "ERROR: the alarm did not fire at the earliest deadline");
+
+    /* The alarm resumed the SysTick: the ms time advances again */
+    uint32_t millis = port_system_get_millis();
+    native_system_advance_us(1000U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(millis + 1U, port_system_get_millis(), __LINE__, "ERROR: the alarm did not resume the SysTick");
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, soft_timer_dispatch(&service, port_system_get_micros64()), __LINE__, "ERROR: the due timer did not fire");
+    native_system_advance_us(5000U - 2250U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, native_system_get_alarm_count(), __LINE__, "ERROR: the alarm was not armed for the next deadline");
+
+    soft_timer_dispatch(&service, port_system_get_micros64());
+    native_system_advance_us(10000U);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, native_system_get_alarm_count(), __LINE__, "ERROR: the alarm fired with no running timer");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_one_shot_timers_fire_in_deadline_order);
+    RUN_TEST(test_periodic_timer_does_not_drift);
+    RUN_TEST(test_periodic_timer_skips_missed_periods);
+    RUN_TEST(test_timers_stopped_from_callbacks);
+    RUN_TEST(test_heap_full);
+    RUN_TEST(test_alarm_wakes_at_the_earliest_deadline);
+    return UNITY_END();
+}
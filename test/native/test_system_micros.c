@@ -0,0 +1,87 @@
+/**
+ * @file test_system_micros.c
+ * @brief Test of the free-running microsecond time base of the system (`port_system_get_micros()`).
+ *
+ * The tests advance the simulated time in µs and check the resolution of the time base, that it keeps counting while the SysTick interrupt is suspended by the sleep, and that the 64-bit time carries the wrap-around of the 32-bit one.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "native_system.h"
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_micros_starts_at_init(void)
+{
+    native_system_advance_ms(5);
+    port_system_init();
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, port_system_get_micros(), __LINE__, "ERROR: the µs time base does not start at the initialization of the system");
+}
+
+void test_micros_resolution(void)
+{
+    native_system_advance_us(1);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, port_system_get_micros(), __LINE__, "ERROR: the µs time base did not advance by 1 µs");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0, port_system_get_millis(), __LINE__, "ERROR: the ms time advanced before the end of the millisecond");
+
+    native_system_advance_us(1500);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1501, port_system_get_micros(), __LINE__, "ERROR: wrong µs time in the middle of a millisecond");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(1, port_system_get_millis(), __LINE__, "ERROR: the ms time did not advance at the end of the millisecond");
+
+    native_system_advance_us(499);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2000, port_system_get_micros(), __LINE__, "ERROR: wrong µs time at the end of a millisecond");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(2, port_system_get_millis(), __LINE__, "ERROR: the ms time and the µs time base drifted apart");
+}
+
+void test_micros_counts_while_the_systick_is_suspended(void)
+{
+    native_system_advance_ms(10);
+    port_system_systick_suspend();
+    native_system_advance_ms(100);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10, port_system_get_millis(), __LINE__, "ERROR: the ms time advanced while the SysTick was suspended");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(110000, port_system_get_micros(), __LINE__, "ERROR: the µs time base stopped while the SysTick was suspended");
+    port_system_systick_resume();
+}
+
+void test_micros_wrap_around(void)
+{
+    native_system_set_micros64(UINT32_MAX - 99);
+    uint32_t start_us = port_system_get_micros();
+
+    native_system_advance_us(300);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(200, port_system_get_micros(), __LINE__, "ERROR: the 32-bit µs time did not wrap around");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(300, port_system_get_micros() - start_us, __LINE__, "ERROR: wrong difference of µs times across the wrap-around");
+    UNITY_TEST_ASSERT(port_system_get_micros64() == (1ULL << 32) + 200, __LINE__, "ERROR: the 64-bit µs time did not carry the wrap-around");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_micros_starts_at_init);
+    RUN_TEST(test_micros_resolution);
+    RUN_TEST(test_micros_counts_while_the_systick_is_suspended);
+    RUN_TEST(test_micros_wrap_around);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_system_wrap.c
+ * @brief Test of the system time across the wrap-around of the 32-bit millisecond counter (49.7 days of uptime).
+ *
+ * The tests set the counter a few ms before the wrap-around with `port_system_set_millis()` and advance the simulated time across it. The 64-bit times must keep counting, and the timeouts of the button FSM and `port_system_delay_until_ms()` must behave as far from the wrap-around.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_button.h"
+#include "port_system.h"
+
+/* Project includes */
+#include "fsm_button.h"
+#include "native_button.h"
+#include "native_system.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define TEST_WRAP_DEBOUNCE_MS 150 /*!< Debounce time of the button FSM */
+#define TEST_WRAP_HELD_MS 700     /*!< Time the button is held */
+
+/* Global variables ------------------------------------------------------------*/
+static fsm_button_storage_t button_storage; /*!< Storage of the button FSM under test */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Advance the simulated time ms by ms, firing a button FSM every ms.
+ *
+ * @param p_fsm_button Button FSM.
+ * @param ms Time to advance.
+ */
+static void _test_wrap_run_ms(fsm_button_t *p_fsm_button, uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        native_system_advance_ms(1);
+        fsm_button_fire(p_fsm_button);
+    }
+}
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_64_bit_time_counts_across_the_wrap(void)
+{
+    uint64_t start_us = port_system_get_micros64();
+    port_system_set_millis(UINT32_MAX - 9);
+    UNITY_TEST_ASSERT(port_system_get_millis64() == UINT32_MAX - 9, __LINE__, "ERROR: wrong 64-bit time before the wrap-around");
+
+    native_system_advance_ms(20);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(10, port_system_get_millis(), __LINE__, "ERROR: the 32-bit time did not wrap around");
+    UNITY_TEST_ASSERT(port_system_get_millis64() == (1ULL << 32) + 10, __LINE__, "ERROR: the 64-bit time did not carry the wrap-around");
+    UNITY_TEST_ASSERT(port_system_get_micros64() - start_us == 20000U, __LINE__, "ERROR: the µs time base depends on the ms counter");
+}
+
+void test_64_bit_time_is_monotonic(void)
+{
+    port_system_set_millis(UINT32_MAX - 1000);
+    uint64_t last_ms = port_system_get_millis64();
+    uint64_t last_us = port_system_get_micros64();
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        native_system_advance_ms(1);
+        uint64_t now_ms = port_system_get_millis64();
+        uint64_t now_us = port_system_get_micros64();
+        UNITY_TEST_ASSERT(now_ms == last_ms + 1, __LINE__, "ERROR: the 64-bit time did not advance by 1 ms");
+        UNITY_TEST_ASSERT(now_us > last_us, __LINE__, "ERROR: the 64-bit µs time went back");
+        last_ms = now_ms;
+        last_us = now_us;
+    }
+}
+
+void test_time_reached_across_the_wrap(void)
+{
+    uint32_t deadline_ms = UINT32_MAX - 4 + 10; /* 10 ms after UINT32_MAX - 4: wraps around to 5 */
+    UNITY_TEST_ASSERT(!port_system_time_reached(UINT32_MAX - 4, deadline_ms), __LINE__, "ERROR: a deadline after the wrap-around is reached before it");
+    UNITY_TEST_ASSERT(!port_system_time_reached(4, deadline_ms), __LINE__, "ERROR: a deadline is reached 1 ms early");
+    UNITY_TEST_ASSERT(port_system_time_reached(5, deadline_ms), __LINE__, "ERROR: a deadline is not reached on time");
+    UNITY_TEST_ASSERT(port_system_time_reached(100, deadline_ms), __LINE__, "ERROR: a past deadline is not reached");
+}
+
+void test_button_debounce_and_duration_across_the_wrap(void)
+{
+    fsm_button_t *p_fsm_button = fsm_button_init(&button_storage, TEST_WRAP_DEBOUNCE_MS, PORT_PARKING_BUTTON_ID);
+    port_system_set_millis(UINT32_MAX - TEST_WRAP_DEBOUNCE_MS / 2); /* The debounce of the press ends after the wrap-around */
+    _test_wrap_run_ms(p_fsm_button, 1);
+
+    native_button_set_value(PORT_PARKING_BUTTON_ID, false); /* active low */
+#ifndef USE_HW_DEBOUNCE
+    /* The software debounce compares the time with its timeout (with USE_HW_DEBOUNCE the port times it) */
+    _test_wrap_run_ms(p_fsm_button, 1);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_PRESSED_WAIT, fsm_get_state(fsm_button_get_inner_fsm(p_fsm_button)), __LINE__, "ERROR: the press was not seen");
+    _test_wrap_run_ms(p_fsm_button, 2);
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_PRESSED_WAIT, fsm_get_state(fsm_button_get_inner_fsm(p_fsm_button)), __LINE__, "ERROR: the debounce ended at once: its timeout is after the wrap-around");
+    _test_wrap_run_ms(p_fsm_button, TEST_WRAP_HELD_MS - 3);
+#else
+    _test_wrap_run_ms(p_fsm_button, TEST_WRAP_HELD_MS);
+#endif
+
+    native_button_set_value(PORT_PARKING_BUTTON_ID, true);
+    _test_wrap_run_ms(p_fsm_button, 2 * TEST_WRAP_DEBOUNCE_MS);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(TEST_WRAP_HELD_MS, fsm_button_get_duration(p_fsm_button), __LINE__, "ERROR: wrong duration of a press across the wrap-around");
+    UNITY_TEST_ASSERT_EQUAL_INT(BUTTON_RELEASED, fsm_get_state(fsm_button_get_inner_fsm(p_fsm_button)), __LINE__, "ERROR: the button FSM did not go back to released");
+}
+
+void test_delay_until_across_the_wrap(void)
+{
+    uint32_t t = UINT32_MAX - 4;
+    port_system_set_millis(t);
+    port_system_delay_until_ms(&t, 10);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(5, port_system_get_millis(), __LINE__, "ERROR: the delay did not wait across the wrap-around");
+    UNITY_TEST_ASSERT_EQUAL_UINT32(5, t, __LINE__, "ERROR: wrong next reference of the delay");
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_64_bit_time_counts_across_the_wrap);
+    RUN_TEST(test_64_bit_time_is_monotonic);
+    RUN_TEST(test_time_reached_across_the_wrap);
+    RUN_TEST(test_button_debounce_and_duration_across_the_wrap);
+    RUN_TEST(test_delay_until_across_the_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_ultrasound_distance.c
+ * @brief Test of the distance of an echo and of the median of the distances, shared by the ultrasound FSM and coroutine (`ultrasound_distance.c`).
+ *
+ * The tests check the median of odd and even numbers of distances given in any order, the distance of echoes with and without an overflow of the timer of the echo signal, with the ticks of the course test of the ultrasound FSM, and the distances published after each echo, with and without `USE_FAST_START`.
+ *
+ * @author Mateo Pansard
+ * @author Lucia Petit
+ * @date 2026-10-19
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <unity.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_ultrasound.h"
+
+/* Project includes */
+#include "fsm_ultrasound.h"
+#include "ultrasound_distance.h"
+
+/* Unity functions ------------------------------------------------------------*/
+void setUp(void)
+{
+    port_system_init();
+    port_ultrasound_init(PORT_REAR_PARKING_SENSOR_ID);
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ----------------------------------------------------------------------*/
+void test_median_of_an_odd_number(void)
+{
+    uint32_t distances[5] = {50, 10, 40, 30, 20};
+    UNITY_TEST_ASSERT_EQUAL_UINT32(30, ultrasound_distance_median(distances, 5), __LINE__, "ERROR: the median of 5 distances is not the middle one");
+
+    uint32_t three[3] = {7, 3, 5};
+    UNITY_TEST_ASSERT_EQUAL_UINT32(5, ultrasound_distance_median(three, 3), __LINE__, "ERROR: the median of 3 distances is not the middle one");
+
+    uint32_t one[1] = {42};
+    UNITY_TEST_ASSERT_EQUAL_UINT32(42, ultrasound_distance_median(one, 1), __LINE__, "ERROR: the median of 1 distance is not that distance");
+}
+
+void test_median_of_an_even_number(void)
+{
+    uint32_t distances[4] = {40, 10, 30, 20};
+    UNITY_TEST_ASSERT_EQUAL_UINT32(25, ultrasound_distance_median(distances, 4), __LINE__, "ERROR: the median of 4 distances is not the mean of the two middle ones");
+}
+
+void test_median_of_far_distances(void)
+{
+    /* A comparison by subtraction orders these distances wrong */
+    uint32_t distances[3] = {UINT32_MAX, 0, 0x80000000U};
+    UNITY_TEST_ASSERT_EQUAL_UINT32(0x80000000U, ultrasound_distance_median(distances, 3), __LINE__, "ERROR: the distances were not sorted");
+}
+
+void test_echo_distance(void)
+{
+    const uint32_t init_ticks[] = {1, 64371, 3, 63208, 5};
+    const uint32_t end_ticks[] = {584, 3, 1752, 4, 2920};
+    const uint32_t overflows[] = {0, 1, 0, 1, 0};
+    const uint32_t expected_cm[] = {10, 20, 30, 40, 50};
+
+    for (uint32_t i = 0; i < sizeof(expected_cm) / sizeof(expected_cm[0]); i++)
+    {
+        port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, init_ticks[i]);
+        port_ultrasound_set_echo_end_tick(PORT_REAR_PARKING_SENSOR_ID, end_ticks[i]);
+        port_ultrasound_set_echo_overflows(PORT_REAR_PARKING_SENSOR_ID, overflows[i]);
+        UNITY_TEST_ASSERT_UINT32_WITHIN(1, expected_cm[i], ultrasound_distance_get_echo_cm(PORT_REAR_PARKING_SENSOR_ID), __LINE__, "ERROR: wrong distance of the echo");
+    }
+}
+
+void test_distances_to_publish(void)
+{
+    uint32_t distances[FSM_ULTRASOUND_NUM_MEASUREMENTS] = {0};
+    uint8_t idx = 0;
+    bool provisional_pending = true; /* As after a start */
+    uint32_t distance_cm = 0;
+
+    for (uint32_t round = 0; round < 2; round++)
+    {
+        for (uint32_t i = 0; i < FSM_ULTRASOUND_NUM_MEASUREMENTS; i++)
+        {
+            bool publish = ultrasound_distance_add(distances, &idx, &provisional_pending, 10 * (i + 1), &distance_cm);
+            if (i == FSM_ULTRASOUND_NUM_MEASUREMENTS - 1)
+            {
+                UNITY_TEST_ASSERT(publish, __LINE__, "ERROR: the median was not published with the array full");
+                UNITY_TEST_ASSERT_EQUAL_UINT32(10 * (FSM_ULTRASOUND_NUM_MEASUREMENTS / 2 + 1), distance_cm, __LINE__, "ERROR: wrong median published");
+            }
+#ifdef USE_FAST_START
+            else if (round == 0 && i == 0)
+            {
+                UNITY_TEST_ASSERT(publish, __LINE__, "ERROR: the first echo after the start was not published");
+                UNITY_TEST_ASSERT_EQUAL_UINT32(10, distance_cm, __LINE__, "ERROR: wrong provisional distance");
+            }
+#endif
+            else
+            {
+                UNITY_TEST_ASSERT(!publish, __LINE__, "ERROR: a distance was published before the array was full");
+            }
+        }
+        UNITY_TEST_ASSERT_EQUAL_UINT32(0, idx, __LINE__, "ERROR: the index did not go back to the start of the array");
+    }
+}
+
+/**
+ * @brief Main function of the test.
+ */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_median_of_an_odd_number);
+    RUN_TEST(test_median_of_an_even_number);
+    RUN_TEST(test_median_of_far_distances);
+    RUN_TEST(test_echo_distance);
+    RUN_TEST(test_distances_to_publish);
+    return UNITY_END();
+}
@@ -215,6 +215,36 @@ void test_check_off(void)
     UNITY_TEST_ASSERT_EQUAL_INT(false, is_active & !idle_and_active, __LINE__, "The FSM should not be active and not idle if the display is not active");    
 }
 
+/**
+ * @brief Check that the display FSM is active only when a transition of its current state can fire, and not just because the display is on.
+ *
+ */
+void test_check_activity(void)
+{
+    // Off and not set active: nothing to do
+    fsm_display_set_state(p_fsm_display, WAIT_DISPLAY);
+    fsm_display_set_status(p_fsm_display, false);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should not be active in WAIT_DISPLAY if the display is not active");
+
+    // Set active: it has to turn on
+    fsm_display_set_status(p_fsm_display, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should be active in WAIT_DISPLAY if the display is active");
+
+    // On and showing the last color: nothing to do, although the display is on
+    fsm_display_set_state(p_fsm_display, SET_DISPLAY);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should not be active in SET_DISPLAY if there is no new color");
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_display_get_status(p_fsm_display), __LINE__, "The display should still be active in SET_DISPLAY without a new color");
+
+    // A new distance: it has to show a new color, and then nothing more
+    fsm_display_set_distance(p_fsm_display, (OK_MIN_CM + INFO_MIN_CM) / 2);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should be active in SET_DISPLAY if there is a new color");
+    fsm_display_fire(p_fsm_display);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should not be active after showing the new color");
+
+    // Set inactive: it has to turn off
+    fsm_display_set_status(p_fsm_display, false);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_display_check_activity(p_fsm_display), __LINE__, "The FSM should be active in SET_DISPLAY if the display is not active");
+}
 
 int main(void)
 {
@@ -225,6 +255,7 @@ int main(void)
     RUN_TEST(test_activation);
     RUN_TEST(test_new_color);
     RUN_TEST(test_check_off);
+    RUN_TEST(test_check_activity);
 
     exit(UNITY_END());
 }
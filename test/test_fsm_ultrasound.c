@@ -243,6 +243,53 @@ void test_stop_measurement(void)
     UNITY_TEST_ASSERT_EQUAL_UINT32(false, echo_received, __LINE__, "The echo signal should be cleared after stopping the measurement");
 }
 
+/**
+ * @brief Check that the ultrasound FSM is active only when a transition of its current state can fire, from the flag set by an ISR until it is handled.
+ *
+ */
+void test_check_activity(void)
+{
+    // Clear the flags of the ISRs
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, false);
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, false);
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 0);
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, false);
+
+    // Stopped: not active even if the trigger is ready, until it is started
+    fsm_ultrasound_set_state(p_fsm_ultrasound, WAIT_START);
+    fsm_ultrasound_set_status(p_fsm_ultrasound, false);
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should not be active in WAIT_START if it has not been started");
+    fsm_ultrasound_set_status(p_fsm_ultrasound, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in WAIT_START once it has been started");
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, false);
+
+    // Every state of a measurement waits for its interrupt, and is active from the flag of the interrupt on
+    fsm_ultrasound_set_state(p_fsm_ultrasound, TRIGGER_START);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should not be active in TRIGGER_START before the end of the trigger signal");
+    port_ultrasound_set_trigger_end(PORT_REAR_PARKING_SENSOR_ID, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in TRIGGER_START after the end of the trigger signal");
+
+    fsm_ultrasound_set_state(p_fsm_ultrasound, WAIT_ECHO_START);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should not be active in WAIT_ECHO_START before the init of the echo signal");
+    port_ultrasound_set_echo_init_tick(PORT_REAR_PARKING_SENSOR_ID, 1);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in WAIT_ECHO_START after the init of the echo signal");
+
+    fsm_ultrasound_set_state(p_fsm_ultrasound, WAIT_ECHO_END);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should not be active in WAIT_ECHO_END before the end of the echo signal");
+    port_ultrasound_set_echo_received(PORT_REAR_PARKING_SENSOR_ID, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in WAIT_ECHO_END after the end of the echo signal");
+
+    // Between two measurements: active at the new measurement timer or when it is stopped
+    fsm_ultrasound_set_state(p_fsm_ultrasound, SET_DISTANCE);
+    UNITY_TEST_ASSERT_EQUAL_INT(false, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should not be active in SET_DISTANCE before a new measurement is ready");
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, true);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in SET_DISTANCE when a new measurement is ready");
+    port_ultrasound_set_trigger_ready(PORT_REAR_PARKING_SENSOR_ID, false);
+    fsm_ultrasound_set_status(p_fsm_ultrasound, false);
+    UNITY_TEST_ASSERT_EQUAL_INT(true, fsm_ultrasound_check_activity(p_fsm_ultrasound), __LINE__, "The FSM should be active in SET_DISTANCE when it has been stopped");
+}
+
 int main(void)
 {
     port_system_init();
@@ -254,5 +301,6 @@ int main(void)
     RUN_TEST(test_echo_received_and_distance);
     RUN_TEST(test_new_measurement);
     RUN_TEST(test_stop_measurement);
+    RUN_TEST(test_check_activity);
     exit(UNITY_END());
 }
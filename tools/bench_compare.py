@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+@file bench_compare.py
+@brief Compare benchmark results against a baseline and flag regressions.
+
+Result lines are "<metric> <value> [<unit>]", as printed by the native
+benchmarks (bench/native) or written by tools/qemu_icount_bench.py. Every
+other line is ignored, so the output of a benchmark can be parsed as is.
+
+Baseline lines are "<metric> <value> <unit> <tolerance>%". Lower values are
+better. A metric fails when it is worse than the baseline by more than its
+tolerance, or when it is missing from the results. Improvements beyond the
+tolerance are reported so that the baseline can be updated, but they only fail
+with --strict.
+
+A unit "/<reference>" makes the value a ratio: the metric divided by the
+reference metric of the same results. Times depend on the machine and on the
+build, so they are checked as ratios (a dispatcher against another one, or any
+time against the fixed workload "benchmark.reference"). Counts that do not
+depend on the machine keep an absolute unit.
+
+Results can be read from files (--results) or from the standard output of
+benchmark executables (--run). With --update the baseline is rewritten with the
+current values, keeping the tolerances and the references. New metrics in
+--default-unit (ns) are written as ratios to --default-reference.
+
+@author Mateo Pansard
+@author Lucia Petit
+@date 2026-10-19
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+RESULT_LINE = re.compile(r'^(\S+)\s+([-+]?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?)(?:\s+(\S+))?\s*$')
+BASELINE_LINE = re.compile(r'^(\S+)\s+([-+]?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?)\s+(\S+)\s+(\d+(?:\.\d*)?)%\s*$')
+
+
+def parse_results(text, results):
+    """Add the result lines of a text to a dict {metric: (value, unit)}."""
+    for line in text.splitlines():
+        line = line.split('#', 1)[0]
+        match = RESULT_LINE.match(line)
+        if match:
+            results[match.group(1)] = (float(match.group(2)), match.group(3) or '-')
+
+
+def parse_baseline(path):
+    """Return the baseline as an ordered dict {metric: (value, unit, tolerance)}."""
+    baseline = {}
+    with open(path, encoding='utf-8') as baseline_file:
+        for number, line in enumerate(baseline_file, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            match = BASELINE_LINE.match(line)
+            if not match:
+                sys.exit('{}:{}: expected "<metric> <value> <unit> <tolerance>%"'.format(path, number))
+            baseline[match.group(1)] = (float(match.group(2)), match.group(3), float(match.group(4)))
+    return baseline
+
+
+def current_value(metric, unit, results):
+    """Return the value of a baseline metric in the results (a ratio for a "/<reference>" unit), or None if it is missing."""
+    if metric not in results:
+        return None
+    if unit.startswith('/'):
+        reference = results.get(unit[1:])
+        if not reference or not reference[0]:
+            return None
+        return results[metric][0] / reference[0]
+    return results[metric][0]
+
+
+def write_baseline(path, baseline, results, default_tolerance, default_unit, default_reference):
+    """Rewrite the baseline with the current results, keeping the header comments and the tolerances."""
+    header = []
+    try:
+        with open(path, encoding='utf-8') as baseline_file:
+            for line in baseline_file:
+                if not line.startswith('#'):
+                    break
+                header.append(line)
+    except FileNotFoundError:
+        pass
+    metrics = list(baseline) + [metric for metric in results if metric not in baseline]
+    width = max([36] + [len(metric) for metric in metrics]) # the values stay in one column after long metric names
+    with open(path, 'w', encoding='utf-8') as baseline_file:
+        baseline_file.writelines(header)
+        for metric in metrics:
+            if metric in baseline:
+                unit, tolerance = baseline[metric][1], baseline[metric][2]
+            else:
+                unit, tolerance = results[metric][1], default_tolerance
+                if default_reference and unit == default_unit and metric != default_reference:
+                    unit = '/' + default_reference
+                elif default_reference and metric == default_reference:
+                    continue
+            value = current_value(metric, unit, results)
+            if value is None:
+                continue
+            precision = 3 if unit.startswith('/') else 2
+            baseline_file.write('{:<{}} {:>12.{}f} {:<6} {:g}%\n'.format(metric, width, value, precision, unit, tolerance))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('@brief ')[1].split('\n')[0])
+    parser.add_argument('--baseline', required=True, help='baseline file')
+    parser.add_argument('--results', action='append', default=[], help='file with result lines')
+    parser.add_argument('--run', action='append', default=[], help='benchmark executable whose output has result lines')
+    parser.add_argument('--update', action='store_true', help='rewrite the baseline with the current results')
+    parser.add_argument('--default-tolerance', type=float, default=50.0, help='tolerance in %% of the new metrics written by --update')
+    parser.add_argument('--strict', action='store_true', help='also fail on improvements beyond the tolerance')
+    parser.add_argument('--default-unit', default='ns', help='unit of the new metrics written as ratios by --update')
+    parser.add_argument('--default-reference', help='reference metric of the new metrics written as ratios by --update')
+    args = parser.parse_args()
+
+    results = {}
+    for path in args.results:
+        with open(path, encoding='utf-8') as results_file:
+            parse_results(results_file.read(), results)
+    for command in args.run:
+        parse_results(subprocess.run([command], check=True, capture_output=True, text=True).stdout, results)
+
+    if args.update:
+        try:
+            baseline = parse_baseline(args.baseline)
+        except FileNotFoundError:
+            baseline = {}
+        write_baseline(args.baseline, baseline, results, args.default_tolerance, args.default_unit, args.default_reference)
+        print('Baseline {} updated with {} metrics'.format(args.baseline, len(results)))
+        return 0
+
+    baseline = parse_baseline(args.baseline)
+    failures = 0
+    row = '{:<36} {:>12} {:>12} {:>8} {:>6}  {}'
+    print(row.format('METRIC', 'BASELINE', 'CURRENT', 'CHANGE', 'TOL', 'STATUS'))
+    for metric, (base, unit, tolerance) in baseline.items():
+        precision = '{:.3f}' if unit.startswith('/') else '{:.2f}'
+        value = current_value(metric, unit, results)
+        if value is None:
+            print(row.format(metric, precision.format(base), '-', '-', '{:g}%'.format(tolerance), 'MISSING'))
+            failures += 1
+            continue
+        change = (value - base) / base * 100.0 if base else 0.0
+        if change > tolerance:
+            status = 'REGRESSION'
+            failures += 1
+        elif change < -tolerance:
+            status = 'IMPROVED (update the baseline)'
+            failures += 1 if args.strict else 0
+        else:
+            status = 'ok'
+        print(row.format(metric, precision.format(base), precision.format(value), '{:+.1f}%'.format(change), '{:g}%'.format(tolerance), status))
+    references = {unit[1:] for (_, unit, _) in baseline.values() if unit.startswith('/')}
+    for metric, (value, unit) in results.items():
+        if metric not in baseline and metric not in references:
+            print(row.format(metric, '-', '{:.2f}'.format(value), '-', '-', 'NEW (not in the baseline)'))
+
+    if failures:
+        print('\n{} metric(s) out of tolerance'.format(failures), file=sys.stderr)
+        return 1
+    print('\nAll {} metrics within tolerance'.format(len(baseline)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+"""
+@file footprint.py
+@brief Flash and RAM footprint report of a firmware image, per module and per library.
+
+It parses the linker map file of an executable (``-Wl,-Map=<file>``) and
+adds up the size of every input section that ends up in the image:
+
+* ``.text``, ``.rodata``, ``.isr_vector``, ``.ARM.*``, ``.init_array``... count as flash.
+* ``.data`` counts as flash (initial values) and RAM.
+* ``.bss`` and ``COMMON`` count as RAM.
+
+Project sources are reported by module (file name without extension, e.g.
+``fsm_button`` or ``stm32f4_ultrasound``). With link-time optimization the
+modules are merged by the optimizer and reported together as ``lto``. Archive
+members of the toolchain libraries are grouped by library, and the C library is
+split into the pieces we actually care about (``libc:printf``, ``libc:qsort``,
+``libc:malloc``...).
+
+If a budget file is given, the script fails (exit code 1) when any module or
+library exceeds its flash or RAM budget. With --forbid-symbol (and --nm/--elf)
+it also fails when the image defines or references a symbol that matches one of
+the given regular expressions, e.g. to prove that the allocator is not linked.
+With --forbid-fpu (and --objdump/--elf) it fails when any function of the image
+contains a floating-point instruction (VFP on ARM, SSE/x87 arithmetic on x86).
+
+@author Mateo Pansard
+@author Lucia Petit
+@date 2026-10-19
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# Input sections that are placed in flash, in RAM, or in both (initialised data)
+FLASH_SECTIONS = ('.text', '.rodata', '.isr_vector', '.ARM', '.init', '.fini', '.init_array', '.fini_array', '.preinit_array', '.glue', '.vfp11', '.v4_bx', '.iplt', '.rel', '.eh_frame')
+DATA_SECTIONS = ('.data',)
+RAM_SECTIONS = ('.bss', 'COMMON', '.noinit')
+
+# Groups of archive members of the C library (newlib or glibc), in order of precedence
+LIBC_GROUPS = (
+    ('printf', re.compile(r'printf|vfprintf|svfprintf|putchar|puts|fputc|fputs|fwrite|wbuf|wsetup|makebuf|fflush|fvwrite|findfp|stdio|writer|flags|dtoa|ldtoa|mprec|locale|ctype|fclose|refill|fseek|fread')),
+    ('qsort', re.compile(r'qsort')),
+    ('malloc', re.compile(r'malloc|mallocr|freer|sbrk|mlock|realloc|calloc|memalign|mallinfo')),
+    ('string', re.compile(r'mem(cpy|set|move|cmp|chr)|str(len|cmp|cpy|chr|ncmp)')),
+)
+
+# Budget file line: <module or library> <flash bytes> <RAM bytes>
+BUDGET_LINE = re.compile(r'^\s*(\S+)\s+(\d+)\s+(\d+)\s*$')
+# Input section line in the map file: " <section> <address> <size> <object>"
+SECTION_LINE = re.compile(r'^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+SECTION_NAME_ONLY = re.compile(r'^ (\S+)$')
+SECTION_CONTINUATION = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+ARCHIVE_MEMBER = re.compile(r'^(.*?)([^/\\]+)\.a\((.+)\)$')
+# Object written by the link-time optimizer (LTO profiles): the code of all the project modules is merged
+LTRANS_OBJECT = re.compile(r'\.ltrans\d*(\.ltrans)?\.o$')
+
+# Floating-point instructions per architecture (objdump file format): every VFP instruction on ARM (Cortex-M4 has no
+# NEON), scalar and packed arithmetic, comparisons and conversions of SSE and every x87 instruction on x86. Moves of
+# vector registers are not included: the compiler uses them to copy memory.
+FPU_INSTRUCTIONS = (
+    ('littlearm', re.compile(r'v[a-z]+(\.\w+)*')),
+    ('x86', re.compile(r'(add|sub|mul|div|sqrt|min|max|cmp|round)(ss|sd|ps|pd)|u?comis[sd]|cvt\w+|f[a-z0-9]+')),
+)
+# objdump -d lines: "<address> <function>:" and "  <address>:\t<bytes>\t<mnemonic> <operands>"
+DISASSEMBLY_FUNCTION = re.compile(r'^[0-9a-fA-F]+ <(.+)>:$')
+
+
+def section_kind(name):
+    """Return 'flash', 'data', 'ram' or None for an input section name."""
+    if name.startswith(RAM_SECTIONS):
+        return 'ram'
+    if name.startswith(DATA_SECTIONS):
+        return 'data'
+    if name.startswith(FLASH_SECTIONS):
+        return 'flash'
+    return None
+
+
+def object_owner(obj, project_libs):
+    """Return the (kind, name) that owns an object of the map file: ('module', 'fsm_button') or ('library', 'libm')."""
+    obj = obj.strip()
+    match = ARCHIVE_MEMBER.match(obj)
+    if match:
+        library = match.group(2)
+        member = os.path.basename(match.group(3))
+        if library in project_libs:
+            return 'module', module_name(member)
+        if library.startswith('libc') or library in ('libg', 'libg_nano'):
+            for group, pattern in LIBC_GROUPS:
+                if pattern.search(member):
+                    return 'library', 'libc:' + group
+            return 'library', 'libc:other'
+        if library.startswith('libm'):
+            return 'library', 'libm'
+        return 'library', library
+    if LTRANS_OBJECT.search(obj):
+        return 'module', 'lto'
+    return 'module', module_name(os.path.basename(obj))
+
+
+def module_name(file_name):
+    """Strip the object extensions: 'fsm_button.c.obj' -> 'fsm_button'."""
+    for suffix in ('.obj', '.o'):
+        if file_name.endswith(suffix):
+            file_name = file_name[:-len(suffix)]
+    for suffix in ('.c', '.s', '.S'):
+        if file_name.endswith(suffix):
+            file_name = file_name[:-len(suffix)]
+    return file_name
+
+
+def parse_map(map_path, project_libs):
+    """Return a dict {(kind, name): [flash, ram]} with the size of every module and library of the image."""
+    usage = {}
+    in_memory_map = False
+    pending_section = None
+
+    def add(section, size, obj):
+        kind = section_kind(section)
+        if kind is None or size == 0 or obj.startswith('*'):
+            return
+        entry = usage.setdefault(object_owner(obj, project_libs), [0, 0])
+        if kind in ('flash', 'data'):
+            entry[0] += size
+        if kind in ('ram', 'data'):
+            entry[1] += size
+
+    with open(map_path, encoding='utf-8', errors='replace') as map_file:
+        for line in map_file:
+            line = line.rstrip('\n').rstrip('\r')
+            if not in_memory_map:
+                in_memory_map = line.startswith('Linker script and memory map')
+                continue
+            if pending_section is not None:
+                match = SECTION_CONTINUATION.match(line)
+                if match:
+                    add(pending_section, int(match.group(2), 16), match.group(3))
+                pending_section = None
+                continue
+            match = SECTION_LINE.match(line)
+            if match:
+                add(match.group(1), int(match.group(3), 16), match.group(4))
+                continue
+            match = SECTION_NAME_ONLY.match(line)
+            if match:
+                pending_section = match.group(1)
+    return usage
+
+
+def parse_budget(budget_path):
+    """Return a dict {name: (flash, ram)} from a budget file."""
+    budget = {}
+    with open(budget_path, encoding='utf-8') as budget_file:
+        for line in budget_file:
+            line = line.split('#', 1)[0]
+            match = BUDGET_LINE.match(line)
+            if match:
+                budget[match.group(1)] = (int(match.group(2)), int(match.group(3)))
+    return budget
+
+
+def largest_symbols(nm, elf, count):
+    """Return the `count` largest symbols of an ELF file as (size, type, name) tuples."""
+    output = subprocess.run([nm, '--size-sort', '--reverse-sort', '-S', elf], check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4:
+            symbols.append((int(fields[1], 16), fields[2], fields[3]))
+        if len(symbols) == count:
+            break
+    return symbols
+
+
+def forbidden_symbols(nm, elf, patterns):
+    """Return the symbols defined or referenced (e.g. from a shared library) in an ELF file whose name fully matches one of the regular expressions."""
+    output = subprocess.run([nm, elf], check=True, capture_output=True, text=True).stdout
+    regexes = [re.compile(pattern) for pattern in patterns]
+    found = []
+    for line in output.splitlines():
+        name = line.split()[-1].split('@')[0]
+        if any(regex.fullmatch(name) for regex in regexes) and name not in found:
+            found.append(name)
+    return found
+
+
+def fpu_functions(objdump, elf):
+    """Return {function: first floating-point instruction} of the functions of an ELF file that use the FPU."""
+    output = subprocess.run([objdump, '-d', '--no-show-raw-insn', elf], check=True, capture_output=True, text=True).stdout
+    regex = None
+    for arch, instructions in FPU_INSTRUCTIONS:
+        if re.search(r'file format \S*' + arch, output):
+            regex = instructions
+    if regex is None:
+        sys.exit('{}: unknown architecture, the floating-point instructions cannot be checked'.format(elf))
+    found = {}
+    function = None
+    for line in output.splitlines():
+        match = DISASSEMBLY_FUNCTION.match(line)
+        if match:
+            function = match.group(1)
+            continue
+        fields = line.split('\t')
+        if function is None or function in found or len(fields) < 2 or not fields[0].strip().endswith(':'):
+            continue
+        mnemonic = fields[1].split()[0] if fields[1].split() else ''
+        if regex.fullmatch(mnemonic):
+            found[function] = fields[1].strip()
+    return found
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('@brief ')[1].split('\n')[0])
+    parser.add_argument('--map', required=True, help='linker map file of the executable')
+    parser.add_argument('--budget', help='budget file with "<module> <flash> <ram>" lines')
+    parser.add_argument('--project-lib', action='append', default=[], help='name of a project static library whose members are reported as modules (e.g. libproject-common)')
+    parser.add_argument('--nm', help='nm executable used to list the largest symbols')
+    parser.add_argument('--elf', help='executable whose largest symbols are listed (requires --nm)')
+    parser.add_argument('--symbols', type=int, default=10, help='number of symbols to list')
+    parser.add_argument('--forbid-symbol', action='append', default=[], help='regular expression of a symbol that must not be defined or referenced in the executable (requires --nm and --elf)')
+    parser.add_argument('--objdump', help='objdump executable used to look for floating-point instructions')
+    parser.add_argument('--forbid-fpu', action='store_true', help='fail if the executable contains floating-point instructions (requires --objdump and --elf)')
+    args = parser.parse_args()
+
+    usage = parse_map(args.map, set(args.project_lib))
+    budget = parse_budget(args.budget) if args.budget else {}
+
+    total = [sum(entry[0] for entry in usage.values()), sum(entry[1] for entry in usage.values())]
+    failures = []
+    print('{:<8} {:<28} {:>8} {:>8} {:>16}'.format('KIND', 'NAME', 'FLASH', 'RAM', 'BUDGET'))
+    for kind in ('module', 'library'):
+        for (owner_kind, name), (flash, ram) in sorted(usage.items(), key=lambda item: -item[1][0]):
+            if owner_kind != kind:
+                continue
+            limit = ''
+            if name in budget:
+                flash_max, ram_max = budget[name]
+                limit = '{}/{}'.format(flash_max, ram_max)
+                if flash > flash_max or ram > ram_max:
+                    failures.append('{} uses {} B flash / {} B RAM, budget is {} B / {} B'.format(name, flash, ram, flash_max, ram_max))
+                    limit += ' !!'
+            print('{:<8} {:<28} {:>8} {:>8} {:>16}'.format(kind, name, flash, ram, limit))
+    print('{:<8} {:<28} {:>8} {:>8}'.format('', 'TOTAL', total[0], total[1]))
+
+    if args.nm and args.elf:
+        print('\nLargest symbols:')
+        for size, symbol_type, name in largest_symbols(args.nm, args.elf, args.symbols):
+            print('{:>8} {} {}'.format(size, symbol_type, name))
+
+    if args.forbid_symbol:
+        if not (args.nm and args.elf):
+            sys.exit('--forbid-symbol requires --nm and --elf')
+        for name in forbidden_symbols(args.nm, args.elf, args.forbid_symbol):
+            failures.append('forbidden symbol {} is linked'.format(name))
+
+    if args.forbid_fpu:
+        if not (args.objdump and args.elf):
+            sys.exit('--forbid-fpu requires --objdump and --elf')
+        for function, instruction in sorted(fpu_functions(args.objdump, args.elf).items()):
+            failures.append('{} uses the FPU ({})'.format(function, instruction))
+
+    if failures:
+        print('\nFootprint check failed:', file=sys.stderr)
+        for failure in failures:
+            print('  ' + failure, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+@file fsm_codegen.py
+@brief Generate a switch-based fire function from the transitions table of an FSM.
+
+It reads a ``fsm_trans_t`` table from the C source of an FSM, e.g.
+
+    static const fsm_trans_t fsm_trans_button[] = {
+        { BUTTON_RELEASED, check_button_pressed, BUTTON_PRESSED_WAIT, do_store_tick_pressed },
+        ...
+        { -1, NULL, -1, NULL }
+    };
+
+and writes a header with ``static int <table>_switch_fire(fsm_t *p_this)``.
+The function has one ``case`` per origin state, and the input and output
+functions are called directly, so the compiler can inline them. The header is
+meant to be included by the source of the FSM right after the table, where the
+input and output functions are visible.
+
+The behaviour is the same as ``fsm_fire()``: the rows of every state are
+tested in the order of the table and the first one whose input function
+returns true is fired. The table is still used by ``fsm_init()``, so it stays
+the only description of the FSM.
+
+@author Mateo Pansard
+@author Lucia Petit
+@date 2026-10-19
+"""
+
+import argparse
+import os
+import re
+import sys
+
+TABLE = re.compile(r'fsm_trans_t\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;', re.DOTALL)
+ROW = re.compile(r'\{([^{}]*)\}')
+COMMENT = re.compile(r'/\*.*?\*/|//[^\n]*', re.DOTALL)
+
+
+def parse_table(source, name):
+    """Return the rows (orig, in, dest, out) of a transitions table, without the final row."""
+    source = COMMENT.sub('', source)
+    for match in TABLE.finditer(source):
+        if name is None or match.group(1) == name:
+            break
+    else:
+        sys.exit('transitions table {} not found'.format(name or 'fsm_trans_t'))
+    rows = []
+    for row in ROW.findall(match.group(2)):
+        fields = [field.strip() for field in row.split(',')]
+        if len(fields) != 4:
+            sys.exit('{}: expected 4 fields in row {{{}}}'.format(match.group(1), row.strip()))
+        if fields[0] == '-1':
+            break
+        rows.append(tuple(fields))
+    return match.group(1), rows
+
+
+def generate(table, rows, source_name):
+    """Return the text of the generated header."""
+    states = []
+    for orig, _, _, _ in rows:
+        if orig not in states:
+            states.append(orig)
+    guard = '{}_SWITCH_H_'.format(table.upper())
+    lines = [
+        '/**',
+        ' * @file {}_switch.h'.format(table),
+        ' * @brief Switch-based fire function of `{}`.'.format(table),
+        ' *',
+        ' * Generated by tools/fsm_codegen.py from {}. Do not edit.'.format(source_name),
+        ' */',
+        '#ifndef {}'.format(guard),
+        '#define {}'.format(guard),
+        '',
+        '/**',
+        ' * @brief Fire the FSM: same behaviour as `fsm_fire()` on `{}`.'.format(table),
+        ' *',
+        ' * @param p_this Pointer to the FSM.',
+        ' * @return int 1 if a transition has been fired, 0 otherwise.',
+        ' */',
+        'static int {}_switch_fire(fsm_t *p_this)'.format(table),
+        '{',
+        '    switch (p_this->current_state)',
+        '    {',
+    ]
+    for state in states:
+        lines.append('    case {}:'.format(state))
+        for orig, check, dest, action in rows:
+            if orig != state:
+                continue
+            lines.append('        if ({}(p_this))'.format(check))
+            lines.append('        {')
+            lines.append('            p_this->current_state = {};'.format(dest))
+            if action != 'NULL':
+                lines.append('            {}(p_this);'.format(action))
+            lines.append('            return 1;')
+            lines.append('        }')
+        lines.append('        break;')
+    lines += [
+        '    default:',
+        '        break;',
+        '    }',
+        '    return 0;',
+        '}',
+        '',
+        '#endif /* {} */'.format(guard),
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('@brief ')[1].split('\n')[0])
+    parser.add_argument('source', help='C source of the FSM')
+    parser.add_argument('output', help='generated header')
+    parser.add_argument('--table', help='name of the transitions table (default: the first one of the source)')
+    args = parser.parse_args()
+
+    with open(args.source, encoding='utf-8') as source_file:
+        table, rows = parse_table(source_file.read(), args.table)
+    if not rows:
+        sys.exit('{}: the transitions table is empty'.format(table))
+    text = generate(table, rows, os.path.basename(args.source))
+
+    with open(args.output, 'w', encoding='utf-8') as output_file:
+        output_file.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
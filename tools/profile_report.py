@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+@file profile_report.py
+@brief Build the project with every build profile and compare flash, RAM and benchmarks.
+
+For every profile (CMake build type: Debug, Release, ReleaseSize,
+ReleaseSpeed) the project is configured in its own build directory, built, and
+measured:
+
+* Flash and RAM of ``main``, from the ``size`` tool of the toolchain (flash is
+  ``.text`` + ``.data``, RAM is ``.data`` + ``.bss``).
+* Native platform: the result lines of every ``bench_*`` executable of the
+  profile (time per call in ns).
+* STM32F4 platform: the instructions per iteration of ``bench_icount``, when the
+  ``bench-icount`` target is available (QEMU and its ``insn`` plugin found).
+
+The report is a Markdown table with one column per profile, printed and, with
+--output, written to a file. The footprint budget check is disabled in these
+builds, because the budget is a ceiling for the Debug build.
+
+Example::
+
+    python3 tools/profile_report.py --platform native --output profiles-native.md
+    python3 tools/profile_report.py --platform stm32f446re --cmake-arg=-DMATRIXMCU=$HOME/MatrixMCU --output profiles-stm32f4.md
+
+@author Mateo Pansard
+@author Lucia Petit
+@date 2026-10-19
+"""
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from bench_compare import parse_results  # noqa: E402
+
+PROFILES = ('Debug', 'Release', 'ReleaseSize', 'ReleaseSpeed')
+
+
+def run(command, verbose, **kwargs):
+    """Run a command and return its standard output; stop the report if it fails."""
+    if verbose:
+        print('$ ' + ' '.join(command), file=sys.stderr)
+    process = subprocess.run(command, capture_output=True, text=True, **kwargs)
+    if process.returncode != 0:
+        sys.stderr.write(process.stdout + process.stderr)
+        sys.exit('command failed: {}'.format(' '.join(command)))
+    return process.stdout
+
+
+def build(args, profile):
+    """Configure and build a profile; return its build directory."""
+    build_dir = os.path.join(args.build_root, '{}-{}'.format(args.platform, profile))
+    run(['cmake', '-S', args.source, '-B', build_dir,
+         '-DPLATFORM={}'.format(args.platform),
+         '-DCMAKE_BUILD_TYPE={}'.format(profile),
+         '-DUSE_FOOTPRINT_BUDGET=false'] + args.cmake_arg, args.verbose)
+    run(['cmake', '--build', build_dir, '-j', str(os.cpu_count() or 1)], args.verbose)
+    return build_dir
+
+
+def find_executable(bin_dir, name):
+    """Return the path of an executable of the output directory, with or without the platform extension."""
+    for path in sorted(glob.glob(os.path.join(bin_dir, name + '*'))):
+        base = os.path.basename(path)
+        if os.path.isfile(path) and (base == name or base.startswith(name + '.')) and not base.endswith(('.map', '.txt')):
+            return path
+    return None
+
+
+def footprint(args, bin_dir):
+    """Return {'flash': bytes, 'ram': bytes} of main."""
+    elf = find_executable(bin_dir, 'main')
+    if elf is None:
+        sys.exit('main not found in {}'.format(bin_dir))
+    fields = run([args.size, elf], args.verbose).splitlines()[1].split()
+    text, data, bss = int(fields[0]), int(fields[1]), int(fields[2])
+    return {'flash': text + data, 'ram': data + bss}
+
+
+def benchmarks(args, build_dir, bin_dir):
+    """Return {metric: (value, unit)} of the benchmarks of a profile."""
+    results = {}
+    if args.platform == 'native':
+        for path in sorted(glob.glob(os.path.join(bin_dir, 'bench_*'))):
+            if os.access(path, os.X_OK) and not path.endswith('.txt'):
+                parse_results(run([path], args.verbose), results)
+    else:
+        help_text = run(['cmake', '--build', build_dir, '--target', 'help'], args.verbose)
+        if 'bench-icount' in help_text:
+            run(['cmake', '--build', build_dir, '--target', 'bench-icount'], args.verbose)
+            with open(os.path.join(bin_dir, 'bench_icount.txt'), encoding='utf-8') as icount_file:
+                parse_results(icount_file.read(), results)
+        else:
+            print('{}: bench-icount is not available (QEMU not found), only the footprint is reported'.format(build_dir), file=sys.stderr)
+    return results
+
+
+def report(profiles, measures):
+    """Return the Markdown table of the measures {profile: {row: (value, unit)}}."""
+    rows = []
+    for profile in profiles:
+        for row in measures[profile]:
+            if row not in rows:
+                rows.append(row)
+    lines = ['| Metric | ' + ' | '.join(profiles) + ' |', '|---' * (len(profiles) + 1) + '|']
+    for row in rows:
+        unit = next(measures[profile][row][1] for profile in profiles if row in measures[profile])
+        cells = []
+        for profile in profiles:
+            value = measures[profile].get(row)
+            cells.append('-' if value is None else '{:g}'.format(round(value[0], 2)))
+        lines.append('| {} ({}) | '.format(row, unit) + ' | '.join(cells) + ' |')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('@brief ')[1].split('\n')[0])
+    parser.add_argument('--source', default=os.path.dirname(os.path.dirname(os.path.abspath(__file__))), help='source directory of the project (default: the parent of tools/)')
+    parser.add_argument('--platform', default='native', help='platform passed to CMake (default: native)')
+    parser.add_argument('--profile', action='append', choices=PROFILES, help='profile to build (default: all of them)')
+    parser.add_argument('--build-root', default='build-profiles', help='directory of the build directories (default: build-profiles)')
+    parser.add_argument('--cmake-arg', action='append', default=[], help='extra argument for the CMake configuration, e.g. --cmake-arg=-DMATRIXMCU=<path>')
+    parser.add_argument('--size', help='size executable (default: size for native, arm-none-eabi-size otherwise)')
+    parser.add_argument('--output', help='file where the Markdown report is written')
+    parser.add_argument('--verbose', action='store_true', help='print the commands')
+    args = parser.parse_args()
+
+    profiles = args.profile or list(PROFILES)
+    if args.size is None:
+        args.size = 'size' if args.platform == 'native' else 'arm-none-eabi-size'
+    if shutil.which(args.size) is None:
+        sys.exit('{} not found: select the size tool of the toolchain with --size'.format(args.size))
+
+    measures = {}
+    for profile in profiles:
+        build_dir = build(args, profile)
+        bin_dir = os.path.join(args.source, 'bin', args.platform, profile)
+        sizes = footprint(args, bin_dir)
+        measures[profile] = {'main flash': (sizes['flash'], 'B'), 'main RAM': (sizes['ram'], 'B')}
+        measures[profile].update(benchmarks(args, build_dir, bin_dir))
+
+    text = '# Build profiles ({})\n\n'.format(args.platform) + report(profiles, measures)
+    print(text)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as output_file:
+            output_file.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+@file qemu_icount_bench.py
+@brief Deterministic instruction count of the Urbanite firmware under QEMU.
+
+It boots the `bench_icount` image (see bench/stm32f4/bench_icount.c) under QEMU
+with `-icount` and the TCG `insn` plugin, once per benchmark phase and number
+of iterations. The image injects the button and echo stimuli in software and
+exits through semihosting, so every run is fully deterministic.
+
+The instructions per iteration of a phase are computed from two runs with
+different numbers of iterations, which cancels the boot and setup cost:
+
+    per_iteration = (insns(n2) - insns(n1)) / (n2 - n1)
+
+The harness overhead per main loop iteration (the `null` phase) is then
+subtracted from every phase.
+
+The results are printed as a table and, with --output, written as
+"<metric> <value>" lines so they can be trended or compared against a baseline.
+
+@author Mateo Pansard
+@author Lucia Petit
+@date 2026-10-19
+"""
+
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+# Phase of the bench image -> (metric name, main loop iterations per phase iteration)
+PHASES = {
+    'cycle': ('icount.measurement_cycle', 4),
+    'button': ('icount.button_event', 5),
+    'idle': ('icount.idle_loop', 1),
+    'isr': ('icount.isr_path', 0),
+}
+NULL_PHASE = 'null'
+
+INSNS_TOTAL = re.compile(r'total insns:\s*(\d+)')
+INSNS = re.compile(r'insns:\s*(\d+)')
+
+
+def run_qemu(args, phase, iterations):
+    """Run the bench image for a phase and return the number of instructions executed."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        log_path = os.path.join(tmp_dir, 'qemu.log')
+        command = [args.qemu]
+        command += [flag for flag in re.split(r'[;\s]+', args.qemu_flags) if flag]
+        command += ['-icount', 'shift={},align=off,sleep=off'.format(args.shift)]
+        command += ['-plugin', args.plugin, '-d', 'plugin', '-D', log_path]
+        command += ['-semihosting-config', 'enable=on,target=native,arg=bench_icount,arg={},arg={}'.format(phase, iterations)]
+        command += ['-kernel', args.kernel]
+        if args.verbose:
+            print(' '.join(shlex.quote(part) for part in command), file=sys.stderr)
+        try:
+            subprocess.run(command, check=True, timeout=args.timeout, stdout=subprocess.DEVNULL if not args.verbose else None)
+        except subprocess.TimeoutExpired:
+            sys.exit('QEMU did not finish phase "{}" in {} s: the image must exit through semihosting'.format(phase, args.timeout))
+        with open(log_path, encoding='utf-8', errors='replace') as log_file:
+            log = log_file.read()
+    match = INSNS_TOTAL.search(log) or INSNS.search(log)
+    if not match:
+        sys.exit('No instruction count in the QEMU log of phase "{}": is {} the TCG "insn" plugin?'.format(phase, args.plugin))
+    return int(match.group(1))
+
+
+def per_iteration(args, phase):
+    """Return the instructions per iteration of a phase."""
+    first = run_qemu(args, phase, args.iterations)
+    second = run_qemu(args, phase, 2 * args.iterations)
+    return (second - first) / args.iterations
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('@brief ')[1].split('\n')[0])
+    parser.add_argument('--qemu', required=True, help='qemu-system-arm executable')
+    parser.add_argument('--qemu-flags', default='', help='machine flags of QEMU (e.g. "-M netduinoplus2 -nographic")')
+    parser.add_argument('--plugin', required=True, help='path of the TCG "insn" plugin (libinsn.so)')
+    parser.add_argument('--kernel', required=True, help='bench_icount image')
+    parser.add_argument('--iterations', type=int, default=50, help='iterations of the first run of every phase (the second one runs twice as many)')
+    parser.add_argument('--shift', type=int, default=0, help='-icount shift (virtual ns per instruction = 2^shift)')
+    parser.add_argument('--timeout', type=int, default=120, help='timeout in seconds of every QEMU run')
+    parser.add_argument('--output', help='file where the "<metric> <value>" lines are written')
+    parser.add_argument('--verbose', action='store_true', help='print the QEMU command lines and output')
+    args = parser.parse_args()
+
+    overhead = per_iteration(args, NULL_PHASE)
+    results = []
+    for phase, (metric, loops) in PHASES.items():
+        results.append((metric, per_iteration(args, phase) - loops * overhead))
+
+    print('{:<28} {:>14}'.format('METRIC', 'INSTRUCTIONS'))
+    for metric, value in results:
+        print('{:<28} {:>14.1f}'.format(metric, value))
+    print('{:<28} {:>14.1f}'.format('(harness overhead per loop)', overhead))
+
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as output_file:
+            output_file.write('# Instructions per iteration of bench_icount (QEMU -icount shift={})\n'.format(args.shift))
+            for metric, value in results:
+                output_file.write('{} {:.1f}\n'.format(metric, value))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())